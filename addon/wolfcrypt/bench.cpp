@@ -0,0 +1,492 @@
+/* bench.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/bench.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// the workloads of bench.js timed in a plain native loop, so the difference to
+// the js numbers is what the bindings and the interface classes add on top of
+// wolfcrypt itself
+
+typedef struct bench_workload
+{
+  std::function<int()> run;
+  std::function<void()> done;
+} bench_workload;
+
+typedef struct bench_options
+{
+  std::string workload;
+  int type;
+  size_t size;
+  int bits;
+  int iterations;
+} bench_options;
+
+static const uint8_t bench_key[32] = { '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '1', '2', '3', '4', '5', '6',
+  '7', '8', '9', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '1', '2' };
+static const uint8_t bench_iv[16] = { '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '1', '2', '3', '4', '5', '6' };
+static const char bench_message[] = "Hello WolfSSL!";
+static const char bench_rsa_message[] = "Hello WolfSSL! 0123456789abcdef";
+
+static int bench_hash( const bench_options& options, bench_workload& workload )
+{
+  enum wc_HashType type = (enum wc_HashType)options.type;
+  int digest_len = wc_HashGetDigestSize( type );
+  auto data = std::make_shared<std::vector<uint8_t>>( options.size, 0xa5 );
+
+  if ( digest_len <= 0 )
+  {
+    return BAD_FUNC_ARG;
+  }
+
+  workload.run = [type, digest_len, data]() {
+    uint8_t out[WC_MAX_DIGEST_SIZE];
+
+    return wc_Hash( type, data->data(), data->size(), out, digest_len );
+  };
+
+  return 0;
+}
+
+// the same steps as a WolfSSLHmac: set the key, update once and finalize
+static int bench_hmac( const bench_options& options, bench_workload& workload )
+{
+  int type = options.type;
+  auto data = std::make_shared<std::vector<uint8_t>>( options.size, 0xa5 );
+
+  workload.run = [type, data]() {
+    Hmac hmac;
+    uint8_t out[WC_MAX_DIGEST_SIZE];
+    int ret = wc_HmacInit( &hmac, NULL, INVALID_DEVID );
+
+    if ( ret == 0 )
+    {
+      ret = wc_HmacSetKey( &hmac, type, bench_key, sizeof( bench_key ) );
+    }
+
+    if ( ret == 0 )
+    {
+      ret = wc_HmacUpdate( &hmac, data->data(), data->size() );
+    }
+
+    if ( ret == 0 )
+    {
+      ret = wc_HmacFinal( &hmac, out );
+    }
+
+    wc_HmacFree( &hmac );
+
+    return ret;
+  };
+
+  return 0;
+}
+
+// a fresh context per operation like WolfSSLEncryptor
+static int bench_aes_cbc( const bench_options& options, bench_workload& workload, int enc )
+{
+  auto data = std::make_shared<std::vector<uint8_t>>( options.size, 0xa5 );
+  auto out = std::make_shared<std::vector<uint8_t>>( options.size + 16 );
+
+  // decryption needs valid padding, so it works on a ciphertext made here
+  if ( enc == 0 )
+  {
+    auto ciphertext = std::make_shared<std::vector<uint8_t>>( options.size + 16 );
+    EVP_CIPHER_CTX* evp = EVP_CIPHER_CTX_new();
+    int len = 0;
+    int final_len = 0;
+
+    if ( evp == NULL )
+    {
+      return MEMORY_E;
+    }
+
+    EVP_CipherInit( evp, "AES-256-CBC", bench_key, bench_iv, 1 );
+    EVP_CipherUpdate( evp, ciphertext->data(), &len, data->data(), data->size() );
+    EVP_CipherFinal( evp, ciphertext->data() + len, &final_len );
+    EVP_CIPHER_CTX_free( evp );
+
+    ciphertext->resize( len + final_len );
+    data = ciphertext;
+  }
+
+  workload.run = [data, out, enc]() {
+    EVP_CIPHER_CTX* evp = EVP_CIPHER_CTX_new();
+    int len = 0;
+    int final_len = 0;
+    int ret = WOLFSSL_FAILURE;
+
+    if ( evp == NULL )
+    {
+      return MEMORY_E;
+    }
+
+    if ( EVP_CipherInit( evp, "AES-256-CBC", bench_key, bench_iv, enc ) == WOLFSSL_SUCCESS &&
+      EVP_CipherUpdate( evp, out->data(), &len, data->data(), data->size() ) == WOLFSSL_SUCCESS &&
+      EVP_CipherFinal( evp, out->data() + len, &final_len ) == WOLFSSL_SUCCESS )
+    {
+      ret = 0;
+    }
+
+    EVP_CIPHER_CTX_free( evp );
+
+    return ret;
+  };
+
+  return 0;
+}
+
+typedef struct bench_rsa_state
+{
+  RsaKey key;
+  uint8_t sig[RSA_MAX_SIZE / 8];
+  int sig_len;
+  uint8_t ciphertext[RSA_MAX_SIZE / 8];
+  int ciphertext_len;
+} bench_rsa_state;
+
+static int bench_rsa( const bench_options& options, bench_workload& workload )
+{
+  auto state = std::make_shared<bench_rsa_state>();
+  WC_RNG* rng = wolfcrypt_thread_rng();
+  int ret;
+
+  ret = wc_InitRsaKey( &state->key, NULL );
+
+  if ( ret != 0 )
+  {
+    return ret;
+  }
+
+  ret = wc_MakeRsaKey( &state->key, options.bits, WC_RSA_EXPONENT, rng );
+
+#ifdef WC_RSA_BLINDING
+  if ( ret == 0 )
+  {
+    ret = wc_RsaSetRNG( &state->key, rng );
+  }
+#endif
+
+  if ( ret == 0 )
+  {
+    state->sig_len = wc_RsaSSL_Sign( (const byte*)bench_rsa_message, sizeof( bench_rsa_message ) - 1, state->sig, sizeof( state->sig ), &state->key, rng );
+    state->ciphertext_len = wc_RsaPublicEncrypt( (const byte*)bench_rsa_message, sizeof( bench_rsa_message ) - 1, state->ciphertext, sizeof( state->ciphertext ), &state->key, rng );
+
+    ret = state->sig_len < 0 ? state->sig_len : state->ciphertext_len < 0 ? state->ciphertext_len : 0;
+  }
+
+  if ( ret != 0 )
+  {
+    wc_FreeRsaKey( &state->key );
+
+    return ret;
+  }
+
+  workload.done = [state]() {
+    wc_FreeRsaKey( &state->key );
+  };
+
+  if ( options.workload == "rsa-sign" )
+  {
+    workload.run = [state, rng]() {
+      uint8_t out[RSA_MAX_SIZE / 8];
+      int ret = wc_RsaSSL_Sign( (const byte*)bench_rsa_message, sizeof( bench_rsa_message ) - 1, out, sizeof( out ), &state->key, rng );
+
+      return ret < 0 ? ret : 0;
+    };
+  }
+  else if ( options.workload == "rsa-verify" )
+  {
+    workload.run = [state]() {
+      uint8_t out[RSA_MAX_SIZE / 8];
+      int ret = wc_RsaSSL_Verify( state->sig, state->sig_len, out, sizeof( out ), &state->key );
+
+      return ret < 0 ? ret : 0;
+    };
+  }
+  else if ( options.workload == "rsa-encrypt" )
+  {
+    workload.run = [state, rng]() {
+      uint8_t out[RSA_MAX_SIZE / 8];
+      int ret = wc_RsaPublicEncrypt( (const byte*)bench_rsa_message, sizeof( bench_rsa_message ) - 1, out, sizeof( out ), &state->key, rng );
+
+      return ret < 0 ? ret : 0;
+    };
+  }
+  else
+  {
+    workload.run = [state]() {
+      uint8_t out[RSA_MAX_SIZE / 8];
+      int ret = wc_RsaPrivateDecrypt( state->ciphertext, state->ciphertext_len, out, sizeof( out ), &state->key );
+
+      return ret < 0 ? ret : 0;
+    };
+  }
+
+  return 0;
+}
+
+typedef struct bench_ecc_state
+{
+  ecc_key key0;
+  ecc_key key1;
+  uint8_t sig[ECC_MAX_SIG_SIZE];
+  word32 sig_len;
+} bench_ecc_state;
+
+static int bench_ecc( const bench_options& options, bench_workload& workload )
+{
+  WC_RNG* rng = wolfcrypt_thread_rng();
+  int size = (int)options.size;
+  int ret;
+
+  if ( options.workload == "ecc-keygen" )
+  {
+    workload.run = [rng, size]() {
+      ecc_key key;
+      int ret = wc_ecc_init( &key );
+
+      if ( ret == 0 )
+      {
+        ret = wc_ecc_make_key( rng, size, &key );
+        wc_ecc_free( &key );
+      }
+
+      return ret;
+    };
+
+    return 0;
+  }
+
+  auto state = std::make_shared<bench_ecc_state>();
+
+  ret = wc_ecc_init( &state->key0 );
+
+  if ( ret == 0 )
+  {
+    ret = wc_ecc_init( &state->key1 );
+
+    if ( ret != 0 )
+    {
+      wc_ecc_free( &state->key0 );
+    }
+  }
+
+  if ( ret != 0 )
+  {
+    return ret;
+  }
+
+  state->key0.rng = rng;
+  state->key1.rng = rng;
+
+  ret = wc_ecc_make_key( rng, size, &state->key0 );
+
+  if ( ret == 0 )
+  {
+    ret = wc_ecc_make_key( rng, size, &state->key1 );
+  }
+
+  if ( ret == 0 )
+  {
+    state->sig_len = sizeof( state->sig );
+    ret = wc_ecc_sign_hash( (const byte*)bench_message, sizeof( bench_message ) - 1, state->sig, &state->sig_len, rng, &state->key0 );
+  }
+
+  workload.done = [state]() {
+    wc_ecc_free( &state->key0 );
+    wc_ecc_free( &state->key1 );
+  };
+
+  if ( ret != 0 )
+  {
+    workload.done();
+
+    return ret;
+  }
+
+  if ( options.workload == "ecc-sign" )
+  {
+    workload.run = [state, rng]() {
+      uint8_t sig[ECC_MAX_SIG_SIZE];
+      word32 sig_len = sizeof( sig );
+
+      return wc_ecc_sign_hash( (const byte*)bench_message, sizeof( bench_message ) - 1, sig, &sig_len, rng, &state->key0 );
+    };
+  }
+  else if ( options.workload == "ecc-verify" )
+  {
+    workload.run = [state]() {
+      int res = 0;
+      int ret = wc_ecc_verify_hash( state->sig, state->sig_len, (const byte*)bench_message, sizeof( bench_message ) - 1, &res, &state->key0 );
+
+      return ret == 0 && res != 1 ? SIG_VERIFY_E : ret;
+    };
+  }
+  else
+  {
+    workload.run = [state]() {
+      uint8_t out[MAX_ECC_BYTES];
+      word32 out_len = sizeof( out );
+
+      return wc_ecc_shared_secret( &state->key0, &state->key1, out, &out_len );
+    };
+  }
+
+  return 0;
+}
+
+static int bench_pbkdf2( const bench_options& options, bench_workload& workload )
+{
+  int type = options.type;
+  int iterations = options.iterations;
+  auto out = std::make_shared<std::vector<uint8_t>>( options.size );
+
+  workload.run = [type, iterations, out]() {
+    static const uint8_t password[] = "super secret password";
+    static const uint8_t salt[] = "super secret salt";
+
+    return wc_PBKDF2( out->data(), password, sizeof( password ) - 1, salt, sizeof( salt ) - 1, iterations, out->size(), type );
+  };
+
+  return 0;
+}
+
+static int bench_setup( const bench_options& options, bench_workload& workload )
+{
+  const std::string& name = options.workload;
+
+  if ( name == "hash" )
+  {
+    return bench_hash( options, workload );
+  }
+  else if ( name == "hmac" )
+  {
+    return bench_hmac( options, workload );
+  }
+  else if ( name == "aes-256-cbc-encrypt" )
+  {
+    return bench_aes_cbc( options, workload, 1 );
+  }
+  else if ( name == "aes-256-cbc-decrypt" )
+  {
+    return bench_aes_cbc( options, workload, 0 );
+  }
+  else if ( name == "rsa-sign" || name == "rsa-verify" || name == "rsa-encrypt" || name == "rsa-decrypt" )
+  {
+    return bench_rsa( options, workload );
+  }
+  else if ( name == "ecc-keygen" || name == "ecc-sign" || name == "ecc-verify" || name == "ecc-ecdh" )
+  {
+    return bench_ecc( options, workload );
+  }
+  else if ( name == "pbkdf2" )
+  {
+    return bench_pbkdf2( options, workload );
+  }
+
+  return NOT_COMPILED_IN;
+}
+
+static int bench_option( Napi::Object& object, const char* name, int fallback )
+{
+  Napi::Value value = object.Get( name );
+
+  return value.IsNumber() ? value.As<Napi::Number>().Int32Value() : fallback;
+}
+
+// nodejsBenchmark( { workload, type, size, bits, iterations, minOps, time } )
+// runs one workload for time milliseconds and at least minOps operations,
+// timing every operation like bench.js does, and returns
+// { ops, totalNs, p50Ns, p99Ns }, or an error code if the workload is unknown
+// or fails
+Napi::Value nodejsBenchmark(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Object object = info[0].As<Napi::Object>();
+  bench_options options;
+  bench_workload workload;
+  std::vector<int64_t> samples;
+  int ret;
+
+  options.workload = object.Get( "workload" ).As<Napi::String>().Utf8Value();
+  options.type = bench_option( object, "type", 0 );
+  options.size = bench_option( object, "size", 0 );
+  options.bits = bench_option( object, "bits", 2048 );
+  options.iterations = bench_option( object, "iterations", 1000 );
+
+  int min_ops = bench_option( object, "minOps", 5 );
+  int time_ms = bench_option( object, "time", 1000 );
+
+  ret = bench_setup( options, workload );
+
+  // the warm up run also catches a failing workload before timing it
+  if ( ret == 0 )
+  {
+    ret = workload.run();
+  }
+
+  if ( ret == 0 )
+  {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( time_ms );
+
+    do
+    {
+      auto start = std::chrono::steady_clock::now();
+
+      ret = workload.run();
+      samples.push_back( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count() );
+    } while ( ret == 0 && ( (int)samples.size() < min_ops || std::chrono::steady_clock::now() < deadline ) );
+  }
+
+  if ( workload.done )
+  {
+    workload.done();
+  }
+
+  if ( ret != 0 )
+  {
+    return Napi::Number::New( env, ret );
+  }
+
+  int64_t total = 0;
+
+  for ( int64_t sample : samples )
+  {
+    total += sample;
+  }
+
+  std::sort( samples.begin(), samples.end() );
+
+  Napi::Object result = Napi::Object::New( env );
+
+  result.Set( "ops", Napi::Number::New( env, samples.size() ) );
+  result.Set( "totalNs", Napi::Number::New( env, (double)total ) );
+  result.Set( "p50Ns", Napi::Number::New( env, (double)samples[std::min( samples.size() - 1, samples.size() / 2 )] ) );
+  result.Set( "p99Ns", Napi::Number::New( env, (double)samples[std::min( samples.size() - 1, samples.size() * 99 / 100 )] ) );
+
+  return result;
+}
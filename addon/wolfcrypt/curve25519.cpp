@@ -0,0 +1,496 @@
+/* curve25519.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/curve25519.h"
+#include <cstring>
+
+#ifdef HAVE_CURVE25519
+// keys go in and out in the little endian byte order of RFC 7748, which is
+// what other X25519 implementations use, rather than wolfcrypt's big endian
+// default
+
+// keys don't own an rng, with blinding each operation uses the one of the
+// thread it runs on
+static void curve25519_thread_rng( curve25519_key* key )
+{
+#ifdef WOLFSSL_CURVE25519_BLINDING
+  wc_curve25519_set_rng( key, wolfcrypt_thread_rng() );
+#else
+  (void)key;
+#endif
+}
+
+Napi::Number sizeof_curve25519_key(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+
+  return Napi::Number::New( env, sizeof( curve25519_key ) );
+}
+
+Napi::Number bind_wc_curve25519_init(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  curve25519_key* key = (curve25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+
+  ret = wc_curve25519_init( key );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_wc_curve25519_make_key(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  curve25519_key* key = (curve25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  ret = wc_curve25519_make_key( wolfcrypt_thread_rng(), CURVE25519_KEYSIZE, key );
+
+  return Napi::Number::New( env, ret );
+}
+
+class wc_curve25519_make_keyAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    wc_curve25519_make_keyAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, Napi::Uint8Array& key_arr )
+      : Napi::AsyncWorker( callback ), key( (curve25519_key*)key_arr.Data() ), stats( info )
+    {
+      key_ref = Napi::Persistent( key_arr );
+    }
+
+    ~wc_curve25519_make_keyAsyncWorker() {}
+
+    void Execute() override
+    {
+      stats.start();
+
+      std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+      ret = wc_curve25519_make_key( wolfcrypt_thread_rng(), CURVE25519_KEYSIZE, key );
+      stats.finish( ret );
+    }
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+      Callback().Call({Env().Undefined(), Napi::Number::New(Env(), ret)});
+    }
+  private:
+    curve25519_key* key;
+    int ret;
+    Napi::Reference<Napi::Uint8Array> key_ref;
+    wolfcrypt_stats_async stats;
+};
+
+// uses the above async worker to make the key, callback will be called
+// when the key has completed
+Napi::Value wc_curve25519_make_key_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array key = info[0].As<Napi::Uint8Array>();
+  Napi::Function callback = info[1].As<Napi::Function>();
+
+  wc_curve25519_make_keyAsyncWorker* key_worker = new wc_curve25519_make_keyAsyncWorker( callback, info, key );
+  key_worker->Queue();
+
+  return env.Undefined();
+}
+
+Napi::Number bind_wc_curve25519_export_public(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  curve25519_key* key = (curve25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  uint8_t* out = (uint8_t*)( info[1].As<Napi::Uint8Array>().Data() );
+  word32 out_len = info[2].As<Napi::Number>().Int32Value();
+
+  ret = wc_curve25519_export_public_ex( key, out, &out_len, EC25519_LITTLE_ENDIAN );
+
+  if ( ret < 0 )
+  {
+    out_len = ret;
+  }
+
+  return Napi::Number::New( env, (int)out_len );
+}
+
+Napi::Number bind_wc_curve25519_import_public(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  uint8_t* in = (uint8_t*)( info[0].As<Napi::Uint8Array>().Data() );
+  word32 in_len = info[1].As<Napi::Number>().Int32Value();
+  curve25519_key* key = (curve25519_key*)( info[2].As<Napi::Uint8Array>().Data() );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  ret = wc_curve25519_import_public_ex( in, in_len, key, EC25519_LITTLE_ENDIAN );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_wc_curve25519_export_private_raw(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  curve25519_key* key = (curve25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  uint8_t* out = (uint8_t*)( info[1].As<Napi::Uint8Array>().Data() );
+  word32 out_len = info[2].As<Napi::Number>().Int32Value();
+
+  ret = wc_curve25519_export_private_raw_ex( key, out, &out_len, EC25519_LITTLE_ENDIAN );
+
+  if ( ret < 0 )
+  {
+    out_len = ret;
+  }
+
+  return Napi::Number::New( env, (int)out_len );
+}
+
+// wc_curve25519_import_private( priv, priv_len, key ) also derives the public
+// key, so an imported key can be exported and used on both sides of an
+// exchange like a generated one
+Napi::Number bind_wc_curve25519_import_private(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  uint8_t* in = (uint8_t*)( info[0].As<Napi::Uint8Array>().Data() );
+  word32 in_len = info[1].As<Napi::Number>().Int32Value();
+  curve25519_key* key = (curve25519_key*)( info[2].As<Napi::Uint8Array>().Data() );
+  uint8_t priv[CURVE25519_KEYSIZE];
+  uint8_t pub[CURVE25519_KEYSIZE];
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  if ( in_len != CURVE25519_KEYSIZE )
+  {
+    return Napi::Number::New( env, ECC_BAD_ARG_E );
+  }
+
+  // any 32 bytes are a valid private key once clamped, wolfcrypt only takes
+  // them clamped already
+  memcpy( priv, in, sizeof( priv ) );
+  priv[0] &= 248;
+  priv[CURVE25519_KEYSIZE - 1] &= 127;
+  priv[CURVE25519_KEYSIZE - 1] |= 64;
+
+  ret = wc_curve25519_make_pub( sizeof( pub ), pub, sizeof( priv ), priv );
+
+  if ( ret == 0 )
+  {
+    ret = wc_curve25519_import_private_raw_ex( priv, sizeof( priv ), pub, sizeof( pub ), key, EC25519_LITTLE_ENDIAN );
+  }
+
+  memset( priv, 0, sizeof( priv ) );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_wc_curve25519_shared_secret(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  curve25519_key* private_key = (curve25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  curve25519_key* public_key = (curve25519_key*)( info[1].As<Napi::Uint8Array>().Data() );
+  uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
+  word32 out_len = info[3].As<Napi::Number>().Uint32Value();
+  wolfcrypt_key_pair_lock lock( private_key, public_key );
+
+  curve25519_thread_rng( private_key );
+  ret = wc_curve25519_shared_secret_ex( private_key, public_key, out, &out_len, EC25519_LITTLE_ENDIAN );
+
+  if ( ret < 0 )
+  {
+    out_len = ret;
+  }
+
+  return Napi::Number::New( env, (int)out_len );
+}
+
+class wc_curve25519_shared_secretAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    wc_curve25519_shared_secretAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, Napi::Uint8Array& private_arr, Napi::Uint8Array& public_arr )
+      : Napi::AsyncWorker( callback ), private_key( (curve25519_key*)private_arr.Data() ), public_key( (curve25519_key*)public_arr.Data() ),
+        stats( info )
+    {
+      private_ref = Napi::Persistent( private_arr );
+      public_ref = Napi::Persistent( public_arr );
+    }
+
+    ~wc_curve25519_shared_secretAsyncWorker() {}
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_pair_lock lock( private_key, public_key );
+
+      curve25519_thread_rng( private_key );
+      out_len = sizeof( out );
+      ret = wc_curve25519_shared_secret_ex( private_key, public_key, out, &out_len, EC25519_LITTLE_ENDIAN );
+      stats.finish( ret );
+    }
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+
+      if ( ret < 0 )
+      {
+        Callback().Call({Env().Undefined(), Napi::Number::New(Env(), ret)});
+      }
+      else
+      {
+        Callback().Call({Env().Undefined(), Napi::Number::New(Env(), (int)out_len),
+          Napi::Buffer<uint8_t>::Copy(Env(), out, out_len)});
+      }
+
+      memset( out, 0, sizeof( out ) );
+    }
+  private:
+    curve25519_key* private_key;
+    curve25519_key* public_key;
+    uint8_t out[CURVE25519_KEYSIZE];
+    word32 out_len;
+    int ret;
+    Napi::Reference<Napi::Uint8Array> private_ref;
+    Napi::Reference<Napi::Uint8Array> public_ref;
+    wolfcrypt_stats_async stats;
+};
+
+// uses the above async worker to compute the shared secret, callback will be
+// called with the return value and a Buffer holding the secret
+Napi::Value wc_curve25519_shared_secret_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array private_key = info[0].As<Napi::Uint8Array>();
+  Napi::Uint8Array public_key = info[1].As<Napi::Uint8Array>();
+  Napi::Function callback = info[2].As<Napi::Function>();
+
+  wc_curve25519_shared_secretAsyncWorker* secret_worker = new wc_curve25519_shared_secretAsyncWorker( callback, info, private_key, public_key );
+  secret_worker->Queue();
+
+  return env.Undefined();
+}
+
+// computes the secrets of key with the public keys start to end packed in
+// publics into out, a public key that fails leaves its secret zeroed and the
+// first error is returned, key must be locked or only used by the caller
+static int curve25519_shared_many_range( curve25519_key* key, const uint8_t* publics, size_t start, size_t end, uint8_t* out )
+{
+  curve25519_key peer;
+  int ret = 0;
+  int err;
+  size_t i;
+
+  err = wc_curve25519_init( &peer );
+
+  if ( err != 0 )
+  {
+    return err;
+  }
+
+  for ( i = start; i < end; i++ )
+  {
+    word32 out_len = CURVE25519_KEYSIZE;
+
+    err = wc_curve25519_import_public_ex( publics + i * CURVE25519_KEYSIZE, CURVE25519_KEYSIZE, &peer, EC25519_LITTLE_ENDIAN );
+
+    if ( err == 0 )
+    {
+      err = wc_curve25519_shared_secret_ex( key, &peer, out + i * CURVE25519_KEYSIZE, &out_len, EC25519_LITTLE_ENDIAN );
+    }
+
+    if ( err != 0 )
+    {
+      memset( out + i * CURVE25519_KEYSIZE, 0, CURVE25519_KEYSIZE );
+
+      if ( ret == 0 )
+      {
+        ret = err;
+      }
+    }
+  }
+
+  wc_curve25519_free( &peer );
+
+  return ret;
+}
+
+// the number of public keys packed in publics, or -1 when it isn't a typed
+// array of whole keys
+static long curve25519_public_count( Napi::Value publics )
+{
+  if ( !publics.IsTypedArray() || publics.As<Napi::Uint8Array>().ByteLength() % CURVE25519_KEYSIZE != 0 )
+  {
+    return -1;
+  }
+
+  return (long)( publics.As<Napi::Uint8Array>().ByteLength() / CURVE25519_KEYSIZE );
+}
+
+// wc_curve25519_shared_secret_many( private_key, publics ) computes the
+// secrets of private_key with the little endian public keys packed back to
+// back in publics and returns them back to back in one Buffer, the secret of
+// a public key that fails is all zeros, which X25519 never returns otherwise,
+// BAD_FUNC_ARG if publics doesn't hold whole keys
+Napi::Value bind_wc_curve25519_shared_secret_many(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  curve25519_key* key = (curve25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  long count = curve25519_public_count( info[1] );
+
+  if ( count < 0 )
+  {
+    return Napi::Number::New( env, BAD_FUNC_ARG );
+  }
+
+  Napi::Buffer<uint8_t> out = Napi::Buffer<uint8_t>::New( env, count * CURVE25519_KEYSIZE );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  curve25519_thread_rng( key );
+  curve25519_shared_many_range( key, info[1].As<Napi::Uint8Array>().Data(), 0, count, out.Data() );
+
+  return out;
+}
+
+// like the ed25519 batch, the private key is exported once on the main
+// thread and every worker imports it into its own curve25519_key, so chunks
+// don't queue on the key lock of the caller's key, the copy is wiped once the
+// batch is done
+class curve25519_shared_batch : public wolfcrypt_batch
+{
+  public:
+    curve25519_shared_batch( Napi::Env env, Napi::Function& callback, size_t count, curve25519_key* key, Napi::Uint8Array& publics_arr )
+      : wolfcrypt_batch( callback, count ), exported( false ), publics( publics_arr.Data() )
+    {
+      Napi::Buffer<uint8_t> out_buf = Napi::Buffer<uint8_t>::New( env, count * CURVE25519_KEYSIZE );
+      word32 priv_len = sizeof( priv );
+      word32 pub_len = sizeof( pub );
+      int err;
+
+      // zeroed so the secrets of chunks that can't run read as failed
+      out = out_buf.Data();
+      memset( out, 0, count * CURVE25519_KEYSIZE );
+      out_ref = Napi::Persistent( out_buf );
+      pin( publics_arr );
+
+      std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+      err = wc_curve25519_export_private_raw_ex( key, priv, &priv_len, EC25519_LITTLE_ENDIAN );
+
+      if ( err == 0 )
+      {
+        err = wc_curve25519_export_public_ex( key, pub, &pub_len, EC25519_LITTLE_ENDIAN );
+      }
+
+      if ( err != 0 )
+      {
+        ret = err;
+      }
+
+      exported = err == 0;
+    }
+
+    ~curve25519_shared_batch()
+    {
+      memset( priv, 0, sizeof( priv ) );
+    }
+
+    void run( size_t start, size_t end ) override
+    {
+      curve25519_key key;
+      int err;
+
+      // the secrets stay zeroed, ret already holds an export error
+      if ( !exported || wc_curve25519_init( &key ) != 0 )
+      {
+        return;
+      }
+
+      err = wc_curve25519_import_private_raw_ex( priv, sizeof( priv ), pub, sizeof( pub ), &key, EC25519_LITTLE_ENDIAN );
+
+      if ( err == 0 )
+      {
+        curve25519_thread_rng( &key );
+        err = curve25519_shared_many_range( &key, publics, start, end, out );
+      }
+
+      if ( err != 0 )
+      {
+        ret = err;
+      }
+
+      wc_curve25519_free( &key );
+    }
+
+    Napi::Value result( Napi::Env env ) override
+    {
+      return out_ref.Value();
+    }
+
+  private:
+    bool exported;
+    uint8_t priv[CURVE25519_KEYSIZE];
+    uint8_t pub[CURVE25519_KEYSIZE];
+    uint8_t* publics;
+    uint8_t* out;
+    Napi::Reference<Napi::Buffer<uint8_t>> out_ref;
+};
+
+// an exchange costs about as much as an ed25519 verify
+#define CURVE25519_SHARED_BATCH_MIN_CHUNK 64
+
+// same arguments as wc_curve25519_shared_secret_many plus a callback, the
+// public keys are split across the thread pool and the callback is called
+// with the first error and the Buffer of secrets
+Napi::Value wc_curve25519_shared_secret_many_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  curve25519_key* key = (curve25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  long count = curve25519_public_count( info[1] );
+  Napi::Function callback = info[2].As<Napi::Function>();
+
+  if ( count < 0 )
+  {
+    wolfcrypt_batch_fail( callback, BAD_FUNC_ARG );
+
+    return env.Undefined();
+  }
+
+  Napi::Uint8Array publics = info[1].As<Napi::Uint8Array>();
+  std::shared_ptr<curve25519_shared_batch> batch = std::make_shared<curve25519_shared_batch>( env, callback, count, key, publics );
+
+  wolfcrypt_batch_queue( env, batch, CURVE25519_SHARED_BATCH_MIN_CHUNK );
+
+  return env.Undefined();
+}
+
+Napi::Number bind_wc_curve25519_free(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  curve25519_key* key = (curve25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  wc_curve25519_free( key );
+
+  return Napi::Number::New( env, 0 );
+}
+#endif
@@ -21,6 +21,7 @@
 #include "./h/ecc.h"
 #include <wolfssl/wolfcrypt/ecc.h>
 #include <wolfssl/wolfcrypt/random.h>
+#include <map>
 
 Napi::Number sizeof_ecc_key(const Napi::CallbackInfo& info)
 {
@@ -41,8 +42,9 @@ Napi::Number bind_wc_ecc_size(const Napi::CallbackInfo& info)
   int ret;
   Napi::Env env = info.Env();
   ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
-  ret = wc_ecc_size( ecc );
+  ret = wc_ecc_size( use.key );
 
   return Napi::Number::New( env, ret );
 }
@@ -55,8 +57,6 @@ Napi::Number bind_wc_ecc_init(const Napi::CallbackInfo& info)
 
   ret = wc_ecc_init( ecc );
 
-  ecc->rng = wc_rng_new( NULL, 0, NULL );
-
   return Napi::Number::New( env, ret );
 }
 
@@ -66,13 +66,9 @@ Napi::Number bind_wc_ecc_make_key(const Napi::CallbackInfo& info)
   int ret;
   int key_size = info[0].As<Napi::Number>().Int32Value();
   ecc_key* ecc = (ecc_key*)( info[1].As<Napi::Uint8Array>().Data() );
-  WC_RNG rng;
-  ret = wc_InitRng(&rng);
-  if (ret < 0) {
-      printf("Failed to bind_wc_ecc_make_key wc_InitRng ret = %d\n", ret);
-      return Napi::Number::New(env, ret);  // Return error code
-  }
-  printf("wc_ecc_make_key...");
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( ecc ) );
+
+  ecc->rng = wolfcrypt_thread_rng();
   ret = wc_ecc_make_key( ecc->rng, key_size, ecc );
 
   return Napi::Number::New( env, ret );
@@ -81,8 +77,8 @@ Napi::Number bind_wc_ecc_make_key(const Napi::CallbackInfo& info)
 class wc_ecc_make_keyAsyncWorker : public Napi::AsyncWorker
 {
   public:
-    wc_ecc_make_keyAsyncWorker( Napi::Function& callback, ecc_key* ecc, int key_size )
-      : Napi::AsyncWorker( callback ), ecc( ecc ), key_size( key_size )
+    wc_ecc_make_keyAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, ecc_key* ecc, int key_size )
+      : Napi::AsyncWorker( callback ), ecc( ecc ), key_size( key_size ), stats( info )
     {
     }
 
@@ -90,7 +86,13 @@ class wc_ecc_make_keyAsyncWorker : public Napi::AsyncWorker
 
     void Execute() override
     {
+      stats.start();
+
+      std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( ecc ) );
+
+      ecc->rng = wolfcrypt_thread_rng();
       ret = wc_ecc_make_key( ecc->rng, key_size, ecc );
+      stats.finish( ret );
     }
 
     void OnOK() override
@@ -102,6 +104,7 @@ class wc_ecc_make_keyAsyncWorker : public Napi::AsyncWorker
     ecc_key* ecc;
     int key_size;
     int ret;
+    wolfcrypt_stats_async stats;
 };
 
 // uses the above async worker to make the key, callback will be called
@@ -113,7 +116,7 @@ Napi::Value wc_ecc_make_key_async(const Napi::CallbackInfo& info)
   ecc_key* ecc = (ecc_key*)( info[1].As<Napi::Uint8Array>().Data() );
   Napi::Function callback = info[2].As<Napi::Function>();
 
-  wc_ecc_make_keyAsyncWorker* key_worker = new wc_ecc_make_keyAsyncWorker( callback, ecc, key_size );
+  wc_ecc_make_keyAsyncWorker* key_worker = new wc_ecc_make_keyAsyncWorker( callback, info, ecc, key_size );
   key_worker->Queue();
 
   return env.Undefined();
@@ -124,8 +127,9 @@ Napi::Number sizeof_ecc_x963(const Napi::CallbackInfo& info)
   Napi::Env env = info.Env();
   ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
   unsigned int out_len;
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
-  wc_ecc_export_x963( ecc, NULL, &out_len );
+  wc_ecc_export_x963( use.key, NULL, &out_len );
 
   return Napi::Number::New( env, out_len );
 }
@@ -137,9 +141,10 @@ Napi::Number bind_wc_ecc_export_x963(const Napi::CallbackInfo& info)
   ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
   uint8_t* out = (uint8_t*)( info[1].As<Napi::Uint8Array>().Data() );
   unsigned int out_len = info[2].As<Napi::Number>().Int32Value();
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
   PRIVATE_KEY_UNLOCK();
-  ret = wc_ecc_export_x963( ecc, out, &out_len );
+  ret = wc_ecc_export_x963( use.key, out, &out_len );
   PRIVATE_KEY_LOCK();
 
   if ( ret < 0 )
@@ -169,8 +174,9 @@ Napi::Number bind_wc_EccKeyDerSize(const Napi::CallbackInfo& info)
   int ret;
   ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
   int pub = info[1].As<Napi::Number>().Int32Value();
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
-  ret = wc_EccKeyDerSize( ecc, pub );
+  ret = wc_EccKeyDerSize( use.key, pub );
 
   return Napi::Number::New( env, ret );
 }
@@ -180,8 +186,9 @@ Napi::Number bind_wc_EccPublicKeyDerSize(const Napi::CallbackInfo& info)
   Napi::Env env = info.Env();
   int ret;
   ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
-  ret = wc_EccPublicKeyDerSize( ecc, 1 );
+  ret = wc_EccPublicKeyDerSize( use.key, 1 );
 
   return Napi::Number::New( env, ret );
 }
@@ -193,9 +200,10 @@ Napi::Number bind_wc_EccPublicKeyToDer(const Napi::CallbackInfo& info)
   ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
   uint8_t* out = (uint8_t*)( info[1].As<Napi::Uint8Array>().Data() );
   unsigned int out_len = info[2].As<Napi::Number>().Int32Value();
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
   /* 1=export with ASN.1/DER header (which includes curve info) */
-  ret = wc_EccPublicKeyToDer( ecc, out, out_len, 1 );
+  ret = wc_EccPublicKeyToDer( use.key, out, out_len, 1 );
 
   return Napi::Number::New( env, ret );
 }
@@ -221,9 +229,10 @@ Napi::Number bind_wc_EccPrivateKeyToDer(const Napi::CallbackInfo& info)
   ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
   uint8_t* out = (uint8_t*)( info[1].As<Napi::Uint8Array>().Data() );
   unsigned int out_len = info[2].As<Napi::Number>().Int32Value();
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
   PRIVATE_KEY_UNLOCK();
-  ret = wc_EccPrivateKeyToDer( ecc, out, out_len );
+  ret = wc_EccPrivateKeyToDer( use.key, out, out_len );
   PRIVATE_KEY_LOCK();
 
   return Napi::Number::New( env, ret );
@@ -245,6 +254,55 @@ Napi::Number bind_wc_EccPrivateKeyDecode(const Napi::CallbackInfo& info)
   return Napi::Number::New( env, ret );
 }
 
+wolfcrypt_key_cache<ecc_key>& wolfcrypt_ecc_key_cache()
+{
+  static wolfcrypt_key_cache<ecc_key>* cache = new wolfcrypt_key_cache<ecc_key>(
+    []( ecc_key* ecc ) { return wc_ecc_init( ecc ); },
+    []( ecc_key* ecc ) { wc_ecc_free( ecc ); } );
+
+  return *cache;
+}
+
+static int ecc_private_key_decode( const byte* in, word32* idx, ecc_key* ecc, word32 in_len )
+{
+  int ret;
+
+  PRIVATE_KEY_UNLOCK();
+  ret = wc_EccPrivateKeyDecode( in, idx, ecc, in_len );
+  PRIVATE_KEY_LOCK();
+
+  return ret;
+}
+
+// nodejsEccKeyCached( in, in_len, isPrivate ) returns a handle to the key
+// decoded from the der in, shared with every other handle for the same der,
+// or an error code, operations on it run on copies of the key checked out
+// from the cache
+Napi::Value nodejsEccKeyCached(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array in = info[0].As<Napi::Uint8Array>();
+  int in_len = info[1].As<Napi::Number>().Int32Value();
+  bool is_private = info[2].As<Napi::Boolean>().Value();
+  wolfcrypt_key_cache<ecc_key>::entry_ptr ecc;
+  int ret;
+
+  if ( in_len < 0 || (size_t)in_len > in.ByteLength() )
+  {
+    return Napi::Number::New( env, BAD_FUNC_ARG );
+  }
+
+  ret = wolfcrypt_ecc_key_cache().get( in.Data(), in_len, is_private ? 'd' : 'p',
+    is_private ? ecc_private_key_decode : wc_EccPublicKeyDecode, ecc );
+
+  if ( ret != 0 )
+  {
+    return Napi::Number::New( env, ret );
+  }
+
+  return wolfcrypt_ecc_key_cache().handle( env, ecc );
+}
+
 Napi::Number bind_wc_ecc_set_curve(const Napi::CallbackInfo& info)
 {
   Napi::Env env = info.Env();
@@ -295,8 +353,12 @@ Napi::Number bind_wc_ecc_shared_secret(const Napi::CallbackInfo& info)
     uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
     unsigned int out_len = info[3].As<Napi::Number>().Uint32Value();
 
+  wolfcrypt_key_use<ecc_key> private_use( wolfcrypt_ecc_key_cache(), private_key, false );
+  wolfcrypt_key_use<ecc_key> public_use( wolfcrypt_ecc_key_cache(), public_key, false );
+  wolfcrypt_key_pair_lock lock( private_use.key, public_use.key );
+  private_use.key->rng = wolfcrypt_thread_rng();
   PRIVATE_KEY_UNLOCK();
-  ret = wc_ecc_shared_secret( private_key, public_key, out, &out_len );
+  ret = wc_ecc_shared_secret( private_use.key, public_use.key, out, &out_len );
   PRIVATE_KEY_LOCK();
 
     if ( ret < 0 )
@@ -320,8 +382,9 @@ Napi::Number bind_wc_ecc_sig_size(const Napi::CallbackInfo& info)
   Napi::Env env = info.Env();
   int ret;
   ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
-  ret = wc_ecc_sig_size( ecc );
+  ret = wc_ecc_sig_size( use.key );
 
   return Napi::Number::New( env, ret );
 }
@@ -335,9 +398,11 @@ Napi::Number bind_wc_ecc_sign_hash(const Napi::CallbackInfo& info)
   uint8_t* out = (uint8_t*)( info[2].As<Napi::Uint8Array>().Data() );
   unsigned int out_len = info[3].As<Napi::Number>().Int32Value();
   ecc_key* ecc = (ecc_key*)( info[4].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
+  use.key->rng = wolfcrypt_thread_rng();
   PRIVATE_KEY_UNLOCK();
-  ret = wc_ecc_sign_hash( in, in_len, out, &out_len, ecc->rng, ecc );
+  ret = wc_ecc_sign_hash( in, in_len, out, &out_len, use.key->rng, use.key );
   PRIVATE_KEY_LOCK();
 
   if ( ret < 0 )
@@ -358,8 +423,9 @@ Napi::Number bind_wc_ecc_verify_hash(const Napi::CallbackInfo& info)
   int hash_len = info[3].As<Napi::Number>().Int32Value();
   ecc_key* ecc = (ecc_key*)( info[4].As<Napi::Uint8Array>().Data() );
   int res;
+  wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
 
-  ret = wc_ecc_verify_hash( sig, sig_len, hash, hash_len, &res, ecc );
+  ret = wc_ecc_verify_hash( sig, sig_len, hash, hash_len, &res, use.key );
   if ( ret < 0 )
   {
     res = ret;
@@ -368,17 +434,448 @@ Napi::Number bind_wc_ecc_verify_hash(const Napi::CallbackInfo& info)
   return Napi::Number::New( env, res );
 }
 
-Napi::Number bind_wc_ecc_free(const Napi::CallbackInfo& info)
+// public keys are exported once on the main thread and imported again by
+// every worker into its own ecc_key, so chunks verify in parallel instead of
+// queueing on the key lock of the caller's key
+struct ecc_batch_key
+{
+  uint8_t x963[1 + 2 * MAX_ECC_BYTES];
+  word32 x963_len;
+  int curve_id;
+};
+
+class ecc_verify_batch : public wolfcrypt_batch
+{
+  public:
+    ecc_verify_batch( Napi::Function& callback, size_t count, const Napi::CallbackInfo& info, int arg )
+      : wolfcrypt_batch( callback, count ), results( count, 0 )
+    {
+      Napi::Uint8Array sigs_arr = info[arg].As<Napi::Uint8Array>();
+      Napi::Uint32Array sig_offsets_arr = info[arg + 1].As<Napi::Uint32Array>();
+      Napi::Uint8Array hashes_arr = info[arg + 2].As<Napi::Uint8Array>();
+      Napi::Uint32Array hash_offsets_arr = info[arg + 3].As<Napi::Uint32Array>();
+
+      sigs = sigs_arr.Data();
+      sig_offsets = sig_offsets_arr.Data();
+      hashes = hashes_arr.Data();
+      hash_offsets = hash_offsets_arr.Data();
+
+      pin( sigs_arr );
+      pin( sig_offsets_arr );
+      pin( hashes_arr );
+      pin( hash_offsets_arr );
+    }
+
+    // returns the index of the exported key, every key is only exported once
+    // however the signatures using it are interleaved
+    int add_key( ecc_key* ecc )
+    {
+      int err;
+      auto found = key_index_of.find( ecc );
+
+      if ( found != key_index_of.end() )
+      {
+        return found->second;
+      }
+
+      key_index_of[ecc] = (int)keys.size();
+      keys.emplace_back();
+      ecc_batch_key& key = keys.back();
+      key.x963_len = sizeof( key.x963 );
+      key.curve_id = ECC_CURVE_DEF;
+
+      wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
+
+      if ( use.key->dp != NULL )
+      {
+        key.curve_id = use.key->dp->id;
+      }
+
+      err = wc_ecc_export_x963( use.key, key.x963, &key.x963_len );
+
+      if ( err < 0 )
+      {
+        key.x963_len = 0;
+        ret = err;
+      }
+
+      return (int)keys.size() - 1;
+    }
+
+    // each worker imports a key the first time one of its signatures needs
+    // it and keeps it for the rest of the chunk, so interleaved keys are not
+    // imported again for every signature
+    void run( size_t start, size_t end ) override
+    {
+      std::vector<std::unique_ptr<ecc_key>> imported( keys.size() );
+      std::vector<bool> failed( keys.size(), false );
+      int err;
+      int res;
+      size_t i;
+
+      for ( i = start; i < end; i++ )
+      {
+        int key_index = key_indexes.empty() ? 0 : key_indexes[i];
+
+        if ( keys[key_index].x963_len == 0 || failed[key_index] )
+        {
+          continue;
+        }
+
+        if ( !imported[key_index] )
+        {
+          std::unique_ptr<ecc_key> ecc( new ecc_key );
+
+          err = wc_ecc_init( ecc.get() );
+
+          if ( err == 0 )
+          {
+            err = wc_ecc_import_x963_ex( keys[key_index].x963, keys[key_index].x963_len, ecc.get(), keys[key_index].curve_id );
+
+            if ( err != 0 )
+            {
+              wc_ecc_free( ecc.get() );
+            }
+          }
+
+          if ( err != 0 )
+          {
+            ret = err;
+            failed[key_index] = true;
+            continue;
+          }
+
+          imported[key_index] = std::move( ecc );
+        }
+
+        res = 0;
+        err = wc_ecc_verify_hash( sigs + sig_offsets[i], sig_offsets[i + 1] - sig_offsets[i],
+          hashes + hash_offsets[i], hash_offsets[i + 1] - hash_offsets[i], &res, imported[key_index].get() );
+
+        results[i] = err == 0 && res == 1 ? 1 : 0;
+      }
+
+      for ( std::unique_ptr<ecc_key>& ecc : imported )
+      {
+        if ( ecc )
+        {
+          wc_ecc_free( ecc.get() );
+        }
+      }
+    }
+
+    Napi::Value result( Napi::Env env ) override
+    {
+      Napi::Uint8Array out = Napi::Uint8Array::New( env, count );
+
+      if ( count > 0 )
+      {
+        memcpy( out.Data(), results.data(), count );
+      }
+
+      return out;
+    }
+
+    std::vector<int> key_indexes;
+
+  private:
+    uint8_t* sigs;
+    uint32_t* sig_offsets;
+    uint8_t* hashes;
+    uint32_t* hash_offsets;
+    std::vector<ecc_batch_key> keys;
+    std::map<ecc_key*, int> key_index_of;
+    std::vector<uint8_t> results;
+};
+
+#define ECC_VERIFY_BATCH_MIN_CHUNK 16
+
+// verifies count signatures against a single public key, sigs and hashes are
+// packed into one buffer each with count + 1 offsets marking where every item
+// starts, callback is called with the first error seen and a Uint8Array
+// holding 1 for each valid signature and 0 otherwise, malformed offsets are
+// rejected with BAD_FUNC_ARG before anything is queued
+Napi::Value wc_ecc_verify_hash_batch(const Napi::CallbackInfo& info)
 {
   Napi::Env env = info.Env();
-  int ret;
   ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  long count = wolfcrypt_packed_count( info[2] );
+  Napi::Function callback = info[5].As<Napi::Function>();
 
-  if ( ecc->rng != NULL )
+  if ( count < 0 || !wolfcrypt_packed_valid( info[1], info[2], count ) || !wolfcrypt_packed_valid( info[3], info[4], count ) )
   {
-    wc_rng_free( ecc->rng );
+    wolfcrypt_batch_fail( callback, BAD_FUNC_ARG );
+    return env.Undefined();
   }
 
+  std::shared_ptr<ecc_verify_batch> batch = std::make_shared<ecc_verify_batch>( callback, count, info, 1 );
+  batch->add_key( ecc );
+
+  wolfcrypt_batch_queue( env, batch, ECC_VERIFY_BATCH_MIN_CHUNK );
+
+  return env.Undefined();
+}
+
+// same as wc_ecc_verify_hash_batch but takes an array with the public key to
+// use for each signature
+Napi::Value wc_ecc_verify_hash_batch_multi(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  long count = wolfcrypt_packed_count( info[2] );
+  Napi::Function callback = info[5].As<Napi::Function>();
+  long i;
+
+  if ( count < 0 || !info[0].IsArray() || info[0].As<Napi::Array>().Length() < (uint32_t)count
+    || !wolfcrypt_packed_valid( info[1], info[2], count ) || !wolfcrypt_packed_valid( info[3], info[4], count ) )
+  {
+    wolfcrypt_batch_fail( callback, BAD_FUNC_ARG );
+    return env.Undefined();
+  }
+
+  Napi::Array keys = info[0].As<Napi::Array>();
+
+  for ( i = 0; i < count; i++ )
+  {
+    if ( !keys.Get( i ).IsTypedArray() )
+    {
+      wolfcrypt_batch_fail( callback, BAD_FUNC_ARG );
+      return env.Undefined();
+    }
+  }
+
+  std::shared_ptr<ecc_verify_batch> batch = std::make_shared<ecc_verify_batch>( callback, count, info, 1 );
+  batch->key_indexes.resize( count );
+
+  for ( i = 0; i < count; i++ )
+  {
+    ecc_key* ecc = (ecc_key*)( keys.Get( i ).As<Napi::Uint8Array>().Data() );
+
+    batch->key_indexes[i] = batch->add_key( ecc );
+  }
+
+  wolfcrypt_batch_queue( env, batch, ECC_VERIFY_BATCH_MIN_CHUNK );
+
+  return env.Undefined();
+}
+
+class wc_ecc_sign_hashAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    wc_ecc_sign_hashAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, Napi::Uint8Array& in_arr, int in_len, Napi::Uint8Array& ecc_arr )
+      : Napi::AsyncWorker( callback ), in( in_arr.Data() ), in_len( in_len ), ecc( (ecc_key*)ecc_arr.Data() ), stats( info )
+    {
+      in_ref = Napi::Persistent( in_arr );
+      ecc_ref = Napi::Persistent( ecc_arr );
+    }
+
+    ~wc_ecc_sign_hashAsyncWorker() {}
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
+
+      use.key->rng = wolfcrypt_thread_rng();
+      out_len = sizeof( out );
+
+      PRIVATE_KEY_UNLOCK();
+      ret = wc_ecc_sign_hash( in, in_len, out, &out_len, use.key->rng, use.key );
+      PRIVATE_KEY_LOCK();
+      stats.finish( ret );
+    }
+
+    // the signature buffer is only created once the size is known
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+
+      if ( ret < 0 )
+      {
+        Callback().Call({Env().Undefined(), Napi::Number::New(Env(), ret)});
+      }
+      else
+      {
+        Callback().Call({Env().Undefined(), Napi::Number::New(Env(), (int)out_len),
+          Napi::Buffer<uint8_t>::Copy(Env(), out, out_len)});
+      }
+    }
+  private:
+    uint8_t* in;
+    int in_len;
+    ecc_key* ecc;
+    uint8_t out[ECC_MAX_SIG_SIZE];
+    unsigned int out_len;
+    int ret;
+    Napi::Reference<Napi::Uint8Array> in_ref;
+    Napi::Reference<Napi::Uint8Array> ecc_ref;
+    wolfcrypt_stats_async stats;
+};
+
+// uses the above async worker to sign the hash, callback will be called with
+// the return value and a Buffer holding the signature
+Napi::Value wc_ecc_sign_hash_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array in = info[0].As<Napi::Uint8Array>();
+  int in_len = info[1].As<Napi::Number>().Int32Value();
+  Napi::Uint8Array ecc = info[2].As<Napi::Uint8Array>();
+  Napi::Function callback = info[3].As<Napi::Function>();
+
+  wc_ecc_sign_hashAsyncWorker* sign_worker = new wc_ecc_sign_hashAsyncWorker( callback, info, in, in_len, ecc );
+  sign_worker->Queue();
+
+  return env.Undefined();
+}
+
+class wc_ecc_verify_hashAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    wc_ecc_verify_hashAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, Napi::Uint8Array& sig_arr, int sig_len,
+      Napi::Uint8Array& hash_arr, int hash_len, Napi::Uint8Array& ecc_arr )
+      : Napi::AsyncWorker( callback ), sig( sig_arr.Data() ), sig_len( sig_len ), hash( hash_arr.Data() ),
+        hash_len( hash_len ), ecc( (ecc_key*)ecc_arr.Data() ), stats( info )
+    {
+      sig_ref = Napi::Persistent( sig_arr );
+      hash_ref = Napi::Persistent( hash_arr );
+      ecc_ref = Napi::Persistent( ecc_arr );
+    }
+
+    ~wc_ecc_verify_hashAsyncWorker() {}
+
+    void Execute() override
+    {
+      int ret;
+
+      stats.start();
+
+      wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
+
+      ret = wc_ecc_verify_hash( sig, sig_len, hash, hash_len, &res, use.key );
+
+      if ( ret < 0 )
+      {
+        res = ret;
+      }
+
+      stats.finish( ret );
+    }
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+      Callback().Call({Env().Undefined(), Napi::Number::New(Env(), res)});
+    }
+  private:
+    uint8_t* sig;
+    int sig_len;
+    uint8_t* hash;
+    int hash_len;
+    ecc_key* ecc;
+    int res;
+    Napi::Reference<Napi::Uint8Array> sig_ref;
+    Napi::Reference<Napi::Uint8Array> hash_ref;
+    Napi::Reference<Napi::Uint8Array> ecc_ref;
+    wolfcrypt_stats_async stats;
+};
+
+// uses the above async worker to verify the signature, callback will be
+// called with 1 if the signature is valid, 0 if not or a negative error code
+Napi::Value wc_ecc_verify_hash_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array sig = info[0].As<Napi::Uint8Array>();
+  int sig_len = info[1].As<Napi::Number>().Int32Value();
+  Napi::Uint8Array hash = info[2].As<Napi::Uint8Array>();
+  int hash_len = info[3].As<Napi::Number>().Int32Value();
+  Napi::Uint8Array ecc = info[4].As<Napi::Uint8Array>();
+  Napi::Function callback = info[5].As<Napi::Function>();
+
+  wc_ecc_verify_hashAsyncWorker* verify_worker = new wc_ecc_verify_hashAsyncWorker( callback, info, sig, sig_len, hash, hash_len, ecc );
+  verify_worker->Queue();
+
+  return env.Undefined();
+}
+
+class wc_ecc_shared_secretAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    wc_ecc_shared_secretAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, Napi::Uint8Array& private_arr, Napi::Uint8Array& public_arr )
+      : Napi::AsyncWorker( callback ), private_key( (ecc_key*)private_arr.Data() ), public_key( (ecc_key*)public_arr.Data() ),
+        stats( info )
+    {
+      private_ref = Napi::Persistent( private_arr );
+      public_ref = Napi::Persistent( public_arr );
+    }
+
+    ~wc_ecc_shared_secretAsyncWorker() {}
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<ecc_key> private_use( wolfcrypt_ecc_key_cache(), private_key, false );
+      wolfcrypt_key_use<ecc_key> public_use( wolfcrypt_ecc_key_cache(), public_key, false );
+      wolfcrypt_key_pair_lock lock( private_use.key, public_use.key );
+
+      private_use.key->rng = wolfcrypt_thread_rng();
+      out_len = sizeof( out );
+
+      PRIVATE_KEY_UNLOCK();
+      ret = wc_ecc_shared_secret( private_use.key, public_use.key, out, &out_len );
+      PRIVATE_KEY_LOCK();
+      stats.finish( ret );
+    }
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+
+      if ( ret < 0 )
+      {
+        Callback().Call({Env().Undefined(), Napi::Number::New(Env(), ret)});
+      }
+      else
+      {
+        Callback().Call({Env().Undefined(), Napi::Number::New(Env(), (int)out_len),
+          Napi::Buffer<uint8_t>::Copy(Env(), out, out_len)});
+      }
+    }
+  private:
+    ecc_key* private_key;
+    ecc_key* public_key;
+    uint8_t out[MAX_ECC_BYTES];
+    unsigned int out_len;
+    int ret;
+    Napi::Reference<Napi::Uint8Array> private_ref;
+    Napi::Reference<Napi::Uint8Array> public_ref;
+    wolfcrypt_stats_async stats;
+};
+
+// uses the above async worker to compute the shared secret, callback will be
+// called with the return value and a Buffer holding the secret
+Napi::Value wc_ecc_shared_secret_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array private_key = info[0].As<Napi::Uint8Array>();
+  Napi::Uint8Array public_key = info[1].As<Napi::Uint8Array>();
+  Napi::Function callback = info[2].As<Napi::Function>();
+
+  wc_ecc_shared_secretAsyncWorker* secret_worker = new wc_ecc_shared_secretAsyncWorker( callback, info, private_key, public_key );
+  secret_worker->Queue();
+
+  return env.Undefined();
+}
+
+Napi::Number bind_wc_ecc_free(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  ecc_key* ecc = (ecc_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( ecc ) );
+
+  // the rng belongs to the thread that last used the key, not to the key
+  ecc->rng = NULL;
   ret = wc_ecc_free( ecc );
 
   return Napi::Number::New( env, ret );
@@ -0,0 +1,476 @@
+/* ecc_fp.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/ecc.h"
+#include <wolfssl/wolfcrypt/sha256.h>
+#include <condition_variable>
+#include <chrono>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// wolfSSL keeps the fixed point tables in ecc.c and only lets FP_ENTRIES be
+// overridden from the settings, this is its default
+#ifndef FP_ENTRIES
+#define FP_ENTRIES 15
+#endif
+
+// a base point gets its table built the second time it is multiplied
+#define ECC_FP_WARM_ROUNDS 2
+
+// how long a worker waits for the others to reach their own pool threads,
+// only runs out when UV_THREADPOOL_SIZE was changed after the pool started
+// or another job holds a thread for that long, the threads that were missed
+// are reported to the callback
+#define ECC_FP_BARRIER_MS 1000
+
+// the tables themselves can't be inspected, so the bases warmed through here
+// are remembered per thread in the order wolfSSL would evict them, a base
+// with an empty x963 is the generator of the curve with that key size
+struct ecc_fp_base
+{
+  int key_size;
+  std::string x963;
+};
+
+struct ecc_fp_thread
+{
+  bool main;
+  std::list<ecc_fp_base> bases;
+};
+
+static std::mutex ecc_fp_threads_lock;
+static std::map<std::thread::id, ecc_fp_thread> ecc_fp_threads;
+
+// without HAVE_THREAD_LS wolfSSL shares one cache between every thread
+static std::thread::id ecc_fp_thread_id()
+{
+#ifdef HAVE_THREAD_LS
+  return std::this_thread::get_id();
+#else
+  return std::thread::id();
+#endif
+}
+
+static void ecc_fp_note( bool main, int key_size, const std::string& x963 )
+{
+  std::lock_guard<std::mutex> guard( ecc_fp_threads_lock );
+  ecc_fp_thread& thread = ecc_fp_threads[ecc_fp_thread_id()];
+  std::list<ecc_fp_base>::iterator it;
+
+  thread.main = thread.main || main;
+
+  for ( it = thread.bases.begin(); it != thread.bases.end(); it++ )
+  {
+    if ( it->key_size == key_size && it->x963 == x963 )
+    {
+      thread.bases.splice( thread.bases.begin(), thread.bases, it );
+
+      return;
+    }
+  }
+
+  thread.bases.push_front( { key_size, x963 } );
+
+  if ( thread.bases.size() > FP_ENTRIES )
+  {
+    thread.bases.pop_back();
+  }
+}
+
+// the public keys and curves to warm, keys are exported on the main thread so
+// every pool thread can import its own copy without taking the key lock
+struct ecc_fp_job
+{
+  std::vector<std::string> keys;
+  std::vector<int> key_curves;
+  std::vector<int> key_sizes;
+  bool free;
+  std::atomic<int> ret;
+
+  std::mutex lock;
+  std::condition_variable ready;
+  size_t arrived;
+  size_t threads;
+  size_t outstanding;
+  // the pool threads that ran the job, a worker landing on one of them after
+  // the barrier timed out leaves it alone
+  std::set<std::thread::id> done;
+  Napi::FunctionReference callback;
+};
+
+#ifdef FP_ECC
+static int ecc_fp_warm_curve( bool main, int key_size )
+{
+  ecc_key ecc;
+  int ret = 0;
+  int i;
+
+  // key generation multiplies the generator, which is all that's needed
+  for ( i = 0; i < ECC_FP_WARM_ROUNDS && ret == 0; i++ )
+  {
+    ret = wc_ecc_init( &ecc );
+
+    if ( ret != 0 )
+    {
+      break;
+    }
+
+    ecc.rng = wolfcrypt_thread_rng();
+    ret = wc_ecc_make_key( ecc.rng, key_size, &ecc );
+
+    if ( ret == 0 && i == ECC_FP_WARM_ROUNDS - 1 )
+    {
+      ecc_fp_note( main, ecc.dp->size, std::string() );
+    }
+
+    wc_ecc_free( &ecc );
+  }
+
+  return ret;
+}
+
+static int ecc_fp_warm_key( bool main, const std::string& x963, int curve_id )
+{
+  // r = s = 1 is in range for every curve, so verification goes through the
+  // full double multiplication and simply fails at the end
+  const byte one = 1;
+  byte sig[16];
+  word32 sig_len = sizeof( sig );
+  byte hash[WC_SHA256_DIGEST_SIZE];
+  ecc_key ecc;
+  int res;
+  int ret;
+  int i;
+
+  memset( hash, 1, sizeof( hash ) );
+
+  ret = wc_ecc_rs_raw_to_sig( &one, 1, &one, 1, sig, &sig_len );
+
+  if ( ret != 0 )
+  {
+    return ret;
+  }
+
+  ret = wc_ecc_init( &ecc );
+
+  if ( ret != 0 )
+  {
+    return ret;
+  }
+
+  ret = wc_ecc_import_x963_ex( (const byte*)x963.data(), x963.size(), &ecc, curve_id );
+
+  for ( i = 0; i < ECC_FP_WARM_ROUNDS && ret == 0; i++ )
+  {
+    ret = wc_ecc_verify_hash( sig, sig_len, hash, sizeof( hash ), &res, &ecc );
+  }
+
+  if ( ret == 0 )
+  {
+    // the generator is the other base of every verification
+    ecc_fp_note( main, ecc.dp->size, std::string() );
+    ecc_fp_note( main, ecc.dp->size, x963 );
+  }
+
+  wc_ecc_free( &ecc );
+
+  return ret;
+}
+#endif
+
+static int ecc_fp_run( ecc_fp_job* job, bool main )
+{
+#ifdef FP_ECC
+  int ret = 0;
+  size_t i;
+
+  if ( job->free )
+  {
+    wc_ecc_fp_free();
+
+    std::lock_guard<std::mutex> guard( ecc_fp_threads_lock );
+    ecc_fp_threads.erase( ecc_fp_thread_id() );
+
+    return 0;
+  }
+
+  for ( i = 0; i < job->key_sizes.size() && ret == 0; i++ )
+  {
+    ret = ecc_fp_warm_curve( main, job->key_sizes[i] );
+  }
+
+  for ( i = 0; i < job->keys.size() && ret == 0; i++ )
+  {
+    ret = ecc_fp_warm_key( main, job->keys[i], job->key_curves[i] );
+  }
+
+  return ret;
+#else
+  return NOT_COMPILED_IN;
+#endif
+}
+
+// one of these is queued per libuv thread, each waits after its work until
+// all of them have started so no thread can pick up two of them, if one does
+// anyway the second worker skips the work and the thread is counted once
+class ecc_fp_worker : public Napi::AsyncWorker
+{
+  public:
+    ecc_fp_worker( Napi::Env env, std::shared_ptr<ecc_fp_job> job )
+      : Napi::AsyncWorker( env ), job( job )
+    {}
+
+    ~ecc_fp_worker() {}
+
+    void Execute() override
+    {
+      std::unique_lock<std::mutex> guard( job->lock );
+      bool first = job->done.insert( ecc_fp_thread_id() ).second;
+
+      guard.unlock();
+
+      if ( first )
+      {
+        int err = ecc_fp_run( job.get(), false );
+        int expected = 0;
+
+        if ( err != 0 )
+        {
+          job->ret.compare_exchange_strong( expected, err );
+        }
+      }
+
+      guard.lock();
+
+      job->arrived++;
+      job->ready.notify_all();
+      job->ready.wait_for( guard, std::chrono::milliseconds( ECC_FP_BARRIER_MS ), [this]() {
+        return job->arrived >= job->threads;
+      } );
+    }
+
+    // the callback gets ( undefined, ret, done, threads ), done is below
+    // threads when some pool threads were never reached
+    void OnOK() override
+    {
+      if ( --job->outstanding > 0 )
+      {
+        return;
+      }
+
+      Napi::HandleScope scope( Env() );
+      size_t done;
+
+      {
+        std::lock_guard<std::mutex> guard( job->lock );
+
+        done = job->done.size();
+      }
+
+      job->callback.Call( { Env().Undefined(), Napi::Number::New( Env(), job->ret.load() ),
+        Napi::Number::New( Env(), (double)done ), Napi::Number::New( Env(), (double)job->threads ) } );
+    }
+  private:
+    std::shared_ptr<ecc_fp_job> job;
+};
+
+// one worker goes to each pool thread, the main thread is warmed on its own
+// by nodejsEccFpWarmSync so this call never blocks it with table building,
+// freeing is cheap so the main thread's tables are freed right away
+static void ecc_fp_queue( Napi::Env env, std::shared_ptr<ecc_fp_job> job, Napi::Function& callback )
+{
+  size_t i;
+
+  job->ret = 0;
+  job->arrived = 0;
+  job->callback = Napi::Persistent( callback );
+
+#ifdef HAVE_THREAD_LS
+  job->threads = wolfcrypt_uv_pool_size();
+
+  if ( job->free )
+  {
+    job->ret = ecc_fp_run( job.get(), true );
+  }
+#else
+  job->threads = 1;
+#endif
+
+  job->outstanding = job->threads;
+
+  for ( i = 0; i < job->threads; i++ )
+  {
+    ( new ecc_fp_worker( env, job ) )->Queue();
+  }
+}
+
+// exports the keys and copies the key sizes of a warm call into the job
+static int ecc_fp_job_set( ecc_fp_job* job, Napi::Array keys, Napi::Array key_sizes )
+{
+  uint32_t i;
+
+  job->free = false;
+
+  for ( i = 0; i < keys.Length(); i++ )
+  {
+    ecc_key* ecc = (ecc_key*)( keys.Get( i ).As<Napi::Uint8Array>().Data() );
+    byte x963[1 + 2 * MAX_ECC_BYTES];
+    word32 x963_len = sizeof( x963 );
+    int ret;
+
+    wolfcrypt_key_use<ecc_key> use( wolfcrypt_ecc_key_cache(), ecc );
+
+    ret = wc_ecc_export_x963( use.key, x963, &x963_len );
+
+    if ( ret < 0 )
+    {
+      return ret;
+    }
+
+    job->keys.push_back( std::string( (const char*)x963, x963_len ) );
+    job->key_curves.push_back( use.key->dp != NULL ? use.key->dp->id : ECC_CURVE_DEF );
+  }
+
+  for ( i = 0; i < key_sizes.Length(); i++ )
+  {
+    job->key_sizes.push_back( key_sizes.Get( i ).As<Napi::Number>().Int32Value() );
+  }
+
+  return 0;
+}
+
+// nodejsEccFpWarm( keys, key_sizes, callback ) builds the fixed point tables
+// for the public keys in keys and the generators of the curves with the key
+// sizes in key_sizes on every libuv thread, callback gets ( undefined, ret,
+// done, threads ), returns an error code if a key can't be exported
+Napi::Value nodejsEccFpWarm(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Array keys = info[0].As<Napi::Array>();
+  Napi::Array key_sizes = info[1].As<Napi::Array>();
+  Napi::Function callback = info[2].As<Napi::Function>();
+  std::shared_ptr<ecc_fp_job> job = std::make_shared<ecc_fp_job>();
+  int ret = ecc_fp_job_set( job.get(), keys, key_sizes );
+
+  if ( ret < 0 )
+  {
+    return Napi::Number::New( env, ret );
+  }
+
+  ecc_fp_queue( env, job, callback );
+
+  return env.Undefined();
+}
+
+// nodejsEccFpWarmSync( keys, key_sizes ) builds the same tables on the
+// calling thread only, for the sync calls such as wc_ecc_verify_hash that run
+// on the main thread
+Napi::Number nodejsEccFpWarmSync(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Array keys = info[0].As<Napi::Array>();
+  Napi::Array key_sizes = info[1].As<Napi::Array>();
+  ecc_fp_job job;
+  int ret = ecc_fp_job_set( &job, keys, key_sizes );
+
+  if ( ret == 0 )
+  {
+    ret = ecc_fp_run( &job, true );
+  }
+
+  return Napi::Number::New( env, ret );
+}
+
+// nodejsEccFpFree( callback ) frees the fixed point tables of the main thread
+// and every libuv thread, callback gets ( undefined, ret, done, threads ) like
+// nodejsEccFpWarm
+Napi::Value nodejsEccFpFree(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[0].As<Napi::Function>();
+  std::shared_ptr<ecc_fp_job> job = std::make_shared<ecc_fp_job>();
+
+  job->free = true;
+
+  ecc_fp_queue( env, job, callback );
+
+  return env.Undefined();
+}
+
+// nodejsEccFpStats() returns { enabled, shared, capacity, threads }, threads
+// has one { main, entries, curves, keys } per thread warmed so far, curves
+// holds the key sizes of the curves whose generator is cached and keys the
+// x963 public keys
+Napi::Value nodejsEccFpStats(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Object result = Napi::Object::New( env );
+  Napi::Array threads = Napi::Array::New( env );
+  std::map<std::thread::id, ecc_fp_thread>::iterator it;
+  uint32_t index = 0;
+
+#ifdef FP_ECC
+  result.Set( "enabled", Napi::Boolean::New( env, true ) );
+#else
+  result.Set( "enabled", Napi::Boolean::New( env, false ) );
+#endif
+#ifdef HAVE_THREAD_LS
+  result.Set( "shared", Napi::Boolean::New( env, false ) );
+#else
+  result.Set( "shared", Napi::Boolean::New( env, true ) );
+#endif
+  result.Set( "capacity", Napi::Number::New( env, FP_ENTRIES ) );
+
+  std::lock_guard<std::mutex> guard( ecc_fp_threads_lock );
+
+  for ( it = ecc_fp_threads.begin(); it != ecc_fp_threads.end(); it++ )
+  {
+    Napi::Object thread = Napi::Object::New( env );
+    Napi::Array curves = Napi::Array::New( env );
+    Napi::Array keys = Napi::Array::New( env );
+
+    for ( const ecc_fp_base& base : it->second.bases )
+    {
+      if ( base.x963.empty() )
+      {
+        curves.Set( curves.Length(), Napi::Number::New( env, base.key_size ) );
+      }
+      else
+      {
+        keys.Set( keys.Length(), Napi::Buffer<uint8_t>::Copy( env, (const uint8_t*)base.x963.data(), base.x963.size() ) );
+      }
+    }
+
+    thread.Set( "main", Napi::Boolean::New( env, it->second.main ) );
+    thread.Set( "entries", Napi::Number::New( env, it->second.bases.size() ) );
+    thread.Set( "curves", curves );
+    thread.Set( "keys", keys );
+
+    threads.Set( index++, thread );
+  }
+
+  result.Set( "threads", threads );
+
+  return result;
+}
@@ -0,0 +1,692 @@
+/* ed25519.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/ed25519.h"
+#include <cstring>
+#include <map>
+#include <string>
+
+#ifdef HAVE_ED25519
+Napi::Number sizeof_ed25519_key(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+
+  return Napi::Number::New( env, sizeof( ed25519_key ) );
+}
+
+Napi::Number bind_wc_ed25519_init(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  ed25519_key* key = (ed25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+
+  ret = wc_ed25519_init( key );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_wc_ed25519_make_key(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  ed25519_key* key = (ed25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  ret = wc_ed25519_make_key( wolfcrypt_thread_rng(), ED25519_KEY_SIZE, key );
+
+  return Napi::Number::New( env, ret );
+}
+
+class wc_ed25519_make_keyAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    wc_ed25519_make_keyAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, Napi::Uint8Array& key_arr )
+      : Napi::AsyncWorker( callback ), key( (ed25519_key*)key_arr.Data() ), stats( info )
+    {
+      key_ref = Napi::Persistent( key_arr );
+    }
+
+    ~wc_ed25519_make_keyAsyncWorker() {}
+
+    void Execute() override
+    {
+      stats.start();
+
+      std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+      ret = wc_ed25519_make_key( wolfcrypt_thread_rng(), ED25519_KEY_SIZE, key );
+      stats.finish( ret );
+    }
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+      Callback().Call({Env().Undefined(), Napi::Number::New(Env(), ret)});
+    }
+  private:
+    ed25519_key* key;
+    int ret;
+    Napi::Reference<Napi::Uint8Array> key_ref;
+    wolfcrypt_stats_async stats;
+};
+
+// uses the above async worker to make the key, callback will be called
+// when the key has completed
+Napi::Value wc_ed25519_make_key_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array key = info[0].As<Napi::Uint8Array>();
+  Napi::Function callback = info[1].As<Napi::Function>();
+
+  wc_ed25519_make_keyAsyncWorker* key_worker = new wc_ed25519_make_keyAsyncWorker( callback, info, key );
+  key_worker->Queue();
+
+  return env.Undefined();
+}
+
+Napi::Number bind_wc_ed25519_export_public(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  ed25519_key* key = (ed25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  uint8_t* out = (uint8_t*)( info[1].As<Napi::Uint8Array>().Data() );
+  word32 out_len = info[2].As<Napi::Number>().Int32Value();
+
+  ret = wc_ed25519_export_public( key, out, &out_len );
+
+  if ( ret < 0 )
+  {
+    out_len = ret;
+  }
+
+  return Napi::Number::New( env, (int)out_len );
+}
+
+Napi::Number bind_wc_ed25519_import_public(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  uint8_t* in = (uint8_t*)( info[0].As<Napi::Uint8Array>().Data() );
+  word32 in_len = info[1].As<Napi::Number>().Int32Value();
+  ed25519_key* key = (ed25519_key*)( info[2].As<Napi::Uint8Array>().Data() );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  ret = wc_ed25519_import_public( in, in_len, key );
+
+  return Napi::Number::New( env, ret );
+}
+
+// exports the 32 byte seed the key was made from, which is all that
+// import_private_key needs to restore it
+Napi::Number bind_wc_ed25519_export_private_only(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  ed25519_key* key = (ed25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  uint8_t* out = (uint8_t*)( info[1].As<Napi::Uint8Array>().Data() );
+  word32 out_len = info[2].As<Napi::Number>().Int32Value();
+
+  ret = wc_ed25519_export_private_only( key, out, &out_len );
+
+  if ( ret < 0 )
+  {
+    out_len = ret;
+  }
+
+  return Napi::Number::New( env, (int)out_len );
+}
+
+// wc_ed25519_import_private_key( priv, priv_len, pub, pub_len, key ), signing
+// needs the public key as well so it is derived from the seed when pub is
+// not a Buffer
+Napi::Number bind_wc_ed25519_import_private_key(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  uint8_t* priv = (uint8_t*)( info[0].As<Napi::Uint8Array>().Data() );
+  word32 priv_len = info[1].As<Napi::Number>().Int32Value();
+  word32 pub_len = info[3].As<Napi::Number>().Int32Value();
+  ed25519_key* key = (ed25519_key*)( info[4].As<Napi::Uint8Array>().Data() );
+  uint8_t derived[ED25519_PUB_KEY_SIZE];
+  uint8_t* pub = derived;
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  if ( info[2].IsTypedArray() )
+  {
+    pub = (uint8_t*)( info[2].As<Napi::Uint8Array>().Data() );
+  }
+  else
+  {
+    pub_len = sizeof( derived );
+    ret = wc_ed25519_import_private_only( priv, priv_len, key );
+
+    if ( ret == 0 )
+    {
+      ret = wc_ed25519_make_public( key, derived, pub_len );
+    }
+
+    if ( ret != 0 )
+    {
+      return Napi::Number::New( env, ret );
+    }
+  }
+
+  ret = wc_ed25519_import_private_key( priv, priv_len, pub, pub_len, key );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_wc_Ed25519KeyToDer(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  ed25519_key* key = (ed25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  uint8_t* out = (uint8_t*)( info[1].As<Napi::Uint8Array>().Data() );
+  word32 out_len = info[2].As<Napi::Number>().Int32Value();
+
+  ret = wc_Ed25519KeyToDer( key, out, out_len );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_wc_Ed25519PublicKeyToDer(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  ed25519_key* key = (ed25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  uint8_t* out = (uint8_t*)( info[1].As<Napi::Uint8Array>().Data() );
+  word32 out_len = info[2].As<Napi::Number>().Int32Value();
+
+  /* 1=export with the algorithm identifier, as a SubjectPublicKeyInfo */
+  ret = wc_Ed25519PublicKeyToDer( key, out, out_len, 1 );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_wc_Ed25519PrivateKeyDecode(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  uint8_t* in = (uint8_t*)( info[0].As<Napi::Uint8Array>().Data() );
+  ed25519_key* key = (ed25519_key*)( info[1].As<Napi::Uint8Array>().Data() );
+  word32 in_len = info[2].As<Napi::Number>().Int32Value();
+  word32 idx = 0;
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  ret = wc_Ed25519PrivateKeyDecode( in, &idx, key, in_len );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_wc_Ed25519PublicKeyDecode(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  uint8_t* in = (uint8_t*)( info[0].As<Napi::Uint8Array>().Data() );
+  ed25519_key* key = (ed25519_key*)( info[1].As<Napi::Uint8Array>().Data() );
+  word32 in_len = info[2].As<Napi::Number>().Int32Value();
+  word32 idx = 0;
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  ret = wc_Ed25519PublicKeyDecode( in, &idx, key, in_len );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_wc_ed25519_sign_msg(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  uint8_t* in = (uint8_t*)( info[0].As<Napi::Uint8Array>().Data() );
+  word32 in_len = info[1].As<Napi::Number>().Int32Value();
+  uint8_t* out = (uint8_t*)( info[2].As<Napi::Uint8Array>().Data() );
+  word32 out_len = info[3].As<Napi::Number>().Int32Value();
+  ed25519_key* key = (ed25519_key*)( info[4].As<Napi::Uint8Array>().Data() );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  ret = wc_ed25519_sign_msg( in, in_len, out, &out_len, key );
+
+  if ( ret < 0 )
+  {
+    out_len = ret;
+  }
+
+  return Napi::Number::New( env, (int)out_len );
+}
+
+Napi::Number bind_wc_ed25519_verify_msg(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  uint8_t* sig = (uint8_t*)( info[0].As<Napi::Uint8Array>().Data() );
+  word32 sig_len = info[1].As<Napi::Number>().Int32Value();
+  uint8_t* msg = (uint8_t*)( info[2].As<Napi::Uint8Array>().Data() );
+  word32 msg_len = info[3].As<Napi::Number>().Int32Value();
+  ed25519_key* key = (ed25519_key*)( info[4].As<Napi::Uint8Array>().Data() );
+  int res = 0;
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  ret = wc_ed25519_verify_msg( sig, sig_len, msg, msg_len, &res, key );
+
+  // a signature that fails to decode is just invalid, like with ecdsa
+  if ( ret == SIG_VERIFY_E )
+  {
+    ret = 0;
+  }
+
+  if ( ret < 0 )
+  {
+    res = ret;
+  }
+
+  return Napi::Number::New( env, res );
+}
+
+class wc_ed25519_sign_msgAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    wc_ed25519_sign_msgAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, Napi::Uint8Array& in_arr, word32 in_len, Napi::Uint8Array& key_arr )
+      : Napi::AsyncWorker( callback ), in( in_arr.Data() ), in_len( in_len ), key( (ed25519_key*)key_arr.Data() ), stats( info )
+    {
+      in_ref = Napi::Persistent( in_arr );
+      key_ref = Napi::Persistent( key_arr );
+    }
+
+    ~wc_ed25519_sign_msgAsyncWorker() {}
+
+    void Execute() override
+    {
+      stats.start();
+
+      std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+      out_len = sizeof( out );
+      ret = wc_ed25519_sign_msg( in, in_len, out, &out_len, key );
+      stats.finish( ret );
+    }
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+
+      if ( ret < 0 )
+      {
+        Callback().Call({Env().Undefined(), Napi::Number::New(Env(), ret)});
+      }
+      else
+      {
+        Callback().Call({Env().Undefined(), Napi::Number::New(Env(), (int)out_len),
+          Napi::Buffer<uint8_t>::Copy(Env(), out, out_len)});
+      }
+    }
+  private:
+    uint8_t* in;
+    word32 in_len;
+    ed25519_key* key;
+    uint8_t out[ED25519_SIG_SIZE];
+    word32 out_len;
+    int ret;
+    Napi::Reference<Napi::Uint8Array> in_ref;
+    Napi::Reference<Napi::Uint8Array> key_ref;
+    wolfcrypt_stats_async stats;
+};
+
+// uses the above async worker to sign the message, callback will be called
+// with the return value and a Buffer holding the signature
+Napi::Value wc_ed25519_sign_msg_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array in = info[0].As<Napi::Uint8Array>();
+  word32 in_len = info[1].As<Napi::Number>().Int32Value();
+  Napi::Uint8Array key = info[2].As<Napi::Uint8Array>();
+  Napi::Function callback = info[3].As<Napi::Function>();
+
+  wc_ed25519_sign_msgAsyncWorker* sign_worker = new wc_ed25519_sign_msgAsyncWorker( callback, info, in, in_len, key );
+  sign_worker->Queue();
+
+  return env.Undefined();
+}
+
+class wc_ed25519_verify_msgAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    wc_ed25519_verify_msgAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, Napi::Uint8Array& sig_arr, word32 sig_len,
+      Napi::Uint8Array& msg_arr, word32 msg_len, Napi::Uint8Array& key_arr )
+      : Napi::AsyncWorker( callback ), sig( sig_arr.Data() ), sig_len( sig_len ), msg( msg_arr.Data() ),
+        msg_len( msg_len ), key( (ed25519_key*)key_arr.Data() ), stats( info )
+    {
+      sig_ref = Napi::Persistent( sig_arr );
+      msg_ref = Napi::Persistent( msg_arr );
+      key_ref = Napi::Persistent( key_arr );
+    }
+
+    ~wc_ed25519_verify_msgAsyncWorker() {}
+
+    void Execute() override
+    {
+      int ret;
+
+      stats.start();
+
+      std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+      res = 0;
+      ret = wc_ed25519_verify_msg( sig, sig_len, msg, msg_len, &res, key );
+
+      if ( ret == SIG_VERIFY_E )
+      {
+        ret = 0;
+      }
+
+      if ( ret < 0 )
+      {
+        res = ret;
+      }
+
+      stats.finish( ret );
+    }
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+      Callback().Call({Env().Undefined(), Napi::Number::New(Env(), res)});
+    }
+  private:
+    uint8_t* sig;
+    word32 sig_len;
+    uint8_t* msg;
+    word32 msg_len;
+    ed25519_key* key;
+    int res;
+    Napi::Reference<Napi::Uint8Array> sig_ref;
+    Napi::Reference<Napi::Uint8Array> msg_ref;
+    Napi::Reference<Napi::Uint8Array> key_ref;
+    wolfcrypt_stats_async stats;
+};
+
+// uses the above async worker to verify the signature, callback will be
+// called with 1 if the signature is valid, 0 if not or a negative error code
+Napi::Value wc_ed25519_verify_msg_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array sig = info[0].As<Napi::Uint8Array>();
+  word32 sig_len = info[1].As<Napi::Number>().Int32Value();
+  Napi::Uint8Array msg = info[2].As<Napi::Uint8Array>();
+  word32 msg_len = info[3].As<Napi::Number>().Int32Value();
+  Napi::Uint8Array key = info[4].As<Napi::Uint8Array>();
+  Napi::Function callback = info[5].As<Napi::Function>();
+
+  wc_ed25519_verify_msgAsyncWorker* verify_worker = new wc_ed25519_verify_msgAsyncWorker( callback, info, sig, sig_len, msg, msg_len, key );
+  verify_worker->Queue();
+
+  return env.Undefined();
+}
+
+// like the ecc batch, public keys are exported once on the main thread and
+// every worker imports them into its own ed25519_key, so chunks don't queue on
+// the key lock of the caller's key
+struct ed25519_batch_key
+{
+  uint8_t pub[ED25519_PUB_KEY_SIZE];
+  word32 pub_len;
+};
+
+class ed25519_verify_batch : public wolfcrypt_batch
+{
+  public:
+    ed25519_verify_batch( Napi::Function& callback, size_t count, const Napi::CallbackInfo& info, int arg )
+      : wolfcrypt_batch( callback, count ), results( count, 0 )
+    {
+      Napi::Uint8Array sigs_arr = info[arg].As<Napi::Uint8Array>();
+      Napi::Uint32Array sig_offsets_arr = info[arg + 1].As<Napi::Uint32Array>();
+      Napi::Uint8Array msgs_arr = info[arg + 2].As<Napi::Uint8Array>();
+      Napi::Uint32Array msg_offsets_arr = info[arg + 3].As<Napi::Uint32Array>();
+
+      sigs = sigs_arr.Data();
+      sig_offsets = sig_offsets_arr.Data();
+      msgs = msgs_arr.Data();
+      msg_offsets = msg_offsets_arr.Data();
+
+      pin( sigs_arr );
+      pin( sig_offsets_arr );
+      pin( msgs_arr );
+      pin( msg_offsets_arr );
+    }
+
+    // returns the index of the exported key, every key is only exported once
+    // however the signatures using it are interleaved, and separate key
+    // objects holding the same public key share one index
+    int add_key( ed25519_key* key )
+    {
+      int err;
+      auto found = key_index_of.find( key );
+
+      if ( found != key_index_of.end() )
+      {
+        return found->second;
+      }
+
+      ed25519_batch_key batch_key;
+      batch_key.pub_len = sizeof( batch_key.pub );
+
+      {
+        std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+        err = wc_ed25519_export_public( key, batch_key.pub, &batch_key.pub_len );
+      }
+
+      if ( err < 0 )
+      {
+        batch_key.pub_len = 0;
+        ret = err;
+      }
+      else
+      {
+        std::string pub( (const char*)batch_key.pub, batch_key.pub_len );
+        auto same = pub_index_of.find( pub );
+
+        if ( same != pub_index_of.end() )
+        {
+          key_index_of[key] = same->second;
+
+          return same->second;
+        }
+
+        pub_index_of[pub] = (int)keys.size();
+      }
+
+      key_index_of[key] = (int)keys.size();
+      keys.push_back( batch_key );
+
+      return (int)keys.size() - 1;
+    }
+
+    // each worker imports a key the first time one of its signatures needs
+    // it and keeps it for the rest of the chunk, like the ecc batch
+    void run( size_t start, size_t end ) override
+    {
+      std::vector<std::unique_ptr<ed25519_key>> imported( keys.size() );
+      std::vector<bool> failed( keys.size(), false );
+      int err;
+      int res;
+      size_t i;
+
+      for ( i = start; i < end; i++ )
+      {
+        int key_index = key_indexes.empty() ? 0 : key_indexes[i];
+
+        if ( keys[key_index].pub_len == 0 || failed[key_index] )
+        {
+          continue;
+        }
+
+        if ( !imported[key_index] )
+        {
+          std::unique_ptr<ed25519_key> key( new ed25519_key );
+
+          err = wc_ed25519_init( key.get() );
+
+          if ( err == 0 )
+          {
+            err = wc_ed25519_import_public( keys[key_index].pub, keys[key_index].pub_len, key.get() );
+
+            if ( err != 0 )
+            {
+              wc_ed25519_free( key.get() );
+            }
+          }
+
+          if ( err != 0 )
+          {
+            ret = err;
+            failed[key_index] = true;
+            continue;
+          }
+
+          imported[key_index] = std::move( key );
+        }
+
+        res = 0;
+        err = wc_ed25519_verify_msg( sigs + sig_offsets[i], sig_offsets[i + 1] - sig_offsets[i],
+          msgs + msg_offsets[i], msg_offsets[i + 1] - msg_offsets[i], &res, imported[key_index].get() );
+
+        results[i] = err == 0 && res == 1 ? 1 : 0;
+      }
+
+      for ( std::unique_ptr<ed25519_key>& key : imported )
+      {
+        if ( key )
+        {
+          wc_ed25519_free( key.get() );
+        }
+      }
+    }
+
+    Napi::Value result( Napi::Env env ) override
+    {
+      Napi::Uint8Array out = Napi::Uint8Array::New( env, count );
+
+      if ( count > 0 )
+      {
+        memcpy( out.Data(), results.data(), count );
+      }
+
+      return out;
+    }
+
+    std::vector<int> key_indexes;
+
+  private:
+    uint8_t* sigs;
+    uint32_t* sig_offsets;
+    uint8_t* msgs;
+    uint32_t* msg_offsets;
+    std::vector<ed25519_batch_key> keys;
+    std::map<ed25519_key*, int> key_index_of;
+    std::map<std::string, int> pub_index_of;
+    std::vector<uint8_t> results;
+};
+
+// ed25519 verifies are cheap, so chunks are bigger than the ecc ones before a
+// batch is worth spreading over more workers
+#define ED25519_VERIFY_BATCH_MIN_CHUNK 64
+
+// verifies count signatures against a single public key, sigs and msgs are
+// packed into one buffer each with count + 1 offsets marking where every item
+// starts, callback is called with the first error seen and a Uint8Array
+// holding 1 for each valid signature and 0 otherwise, malformed offsets are
+// rejected with BAD_FUNC_ARG before anything is queued
+Napi::Value wc_ed25519_verify_msg_batch(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  ed25519_key* key = (ed25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  long count = wolfcrypt_packed_count( info[2] );
+  Napi::Function callback = info[5].As<Napi::Function>();
+
+  if ( count < 0 || !wolfcrypt_packed_valid( info[1], info[2], count ) || !wolfcrypt_packed_valid( info[3], info[4], count ) )
+  {
+    wolfcrypt_batch_fail( callback, BAD_FUNC_ARG );
+
+    return env.Undefined();
+  }
+
+  std::shared_ptr<ed25519_verify_batch> batch = std::make_shared<ed25519_verify_batch>( callback, count, info, 1 );
+  batch->add_key( key );
+
+  wolfcrypt_batch_queue( env, batch, ED25519_VERIFY_BATCH_MIN_CHUNK );
+
+  return env.Undefined();
+}
+
+// same as wc_ed25519_verify_msg_batch but takes an array with the public key
+// to use for each signature
+Napi::Value wc_ed25519_verify_msg_batch_multi(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  long count = wolfcrypt_packed_count( info[2] );
+  Napi::Function callback = info[5].As<Napi::Function>();
+  long i;
+
+  if ( count < 0 || !info[0].IsArray() || info[0].As<Napi::Array>().Length() < (uint32_t)count
+    || !wolfcrypt_packed_valid( info[1], info[2], count ) || !wolfcrypt_packed_valid( info[3], info[4], count ) )
+  {
+    wolfcrypt_batch_fail( callback, BAD_FUNC_ARG );
+
+    return env.Undefined();
+  }
+
+  Napi::Array keys = info[0].As<Napi::Array>();
+
+  for ( i = 0; i < count; i++ )
+  {
+    if ( !keys.Get( i ).IsTypedArray() )
+    {
+      wolfcrypt_batch_fail( callback, BAD_FUNC_ARG );
+
+      return env.Undefined();
+    }
+  }
+
+  std::shared_ptr<ed25519_verify_batch> batch = std::make_shared<ed25519_verify_batch>( callback, count, info, 1 );
+  batch->key_indexes.resize( count );
+
+  for ( i = 0; i < count; i++ )
+  {
+    ed25519_key* key = (ed25519_key*)( keys.Get( i ).As<Napi::Uint8Array>().Data() );
+
+    batch->key_indexes[i] = batch->add_key( key );
+  }
+
+  wolfcrypt_batch_queue( env, batch, ED25519_VERIFY_BATCH_MIN_CHUNK );
+
+  return env.Undefined();
+}
+
+Napi::Number bind_wc_ed25519_free(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  ed25519_key* key = (ed25519_key*)( info[0].As<Napi::Uint8Array>().Data() );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( key ) );
+
+  wc_ed25519_free( key );
+
+  return Napi::Number::New( env, 0 );
+}
+#endif
@@ -23,54 +23,244 @@
 Napi::Value bind_EVP_CIPHER_CTX_new(const Napi::CallbackInfo& info)
 {
   Napi::Env env = info.Env();
-  EVP_CIPHER_CTX* evp = EVP_CIPHER_CTX_new();
+  // same as EVP_CIPHER_CTX_new but the memory comes from the context pool
+  EVP_CIPHER_CTX* evp = (EVP_CIPHER_CTX*)wolfcrypt_pool_alloc( NATIVE_EVP, sizeof( nodejs_evp_ctx ) );
+
+  if ( evp != NULL )
+  {
+    EVP_CIPHER_CTX_init( evp );
+    NODEJS_EVP_BUFFERED( evp ) = 0;
+  }
+
   Napi::External<EVP_CIPHER_CTX> evp_ext = Napi::External<EVP_CIPHER_CTX>::New( env, evp );
 
   return evp_ext;
 }
 
+// type, key and iv may each be null, an AEAD cipher with a non default iv
+// length is set up by passing only the type, setting the iv length and then
+// passing the key and iv with a null type
 Napi::Number bind_EVP_CipherInit(const Napi::CallbackInfo& info)
 {
   Napi::Env env = info.Env();
   int ret;
   EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
-  std::string type = info[1].As<Napi::String>().Utf8Value();
-  uint8_t* key = info[2].As<Napi::Uint8Array>().Data();
-  uint8_t* iv = info[3].As<Napi::Uint8Array>().Data();
+  std::string type;
+  uint8_t* key = NULL;
+  uint8_t* iv = NULL;
   int enc = info[4].As<Napi::Number>().Int32Value();
 
-  ret = EVP_CipherInit( evp, type.c_str(), key, iv, enc );
+  if ( info[1].IsString() )
+  {
+    type = info[1].As<Napi::String>().Utf8Value();
+  }
+
+  if ( info[2].IsTypedArray() )
+  {
+    key = info[2].As<Napi::Uint8Array>().Data();
+  }
+
+  if ( info[3].IsTypedArray() )
+  {
+    iv = info[3].As<Napi::Uint8Array>().Data();
+  }
+
+  ret = EVP_CipherInit( evp, info[1].IsString() ? type.c_str() : NULL, key, iv, enc );
+  NODEJS_EVP_BUFFERED( evp ) = 0;
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number bind_EVP_CIPHER_CTX_set_iv_length(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
+  int iv_len = info[1].As<Napi::Number>().Int32Value();
+
+  ret = EVP_CIPHER_CTX_ctrl( evp, EVP_CTRL_AEAD_SET_IVLEN, iv_len, NULL );
+
+  return Napi::Number::New( env, ret );
+}
+
+// feeds additional authenticated data to an AEAD cipher, can be called
+// several times before the first update
+Napi::Number bind_EVP_CipherUpdateAAD(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
+  uint8_t* aad = info[1].As<Napi::Uint8Array>().Data();
+  int aad_len = info[2].As<Napi::Number>().Int32Value();
+  int out_len;
+
+  ret = EVP_CipherUpdate( evp, NULL, &out_len, aad, aad_len );
+
+  return Napi::Number::New( env, ret );
+}
+
+// reads the tag after an AEAD encryption has been finalized
+Napi::Number bind_EVP_CIPHER_CTX_get_tag(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
+  Napi::Uint8Array tag = info[1].As<Napi::Uint8Array>();
+
+  ret = EVP_CIPHER_CTX_ctrl( evp, EVP_CTRL_AEAD_GET_TAG, (int)tag.ElementLength(), tag.Data() );
+
+  return Napi::Number::New( env, ret );
+}
+
+// sets the expected tag of an AEAD decryption, must be called before final
+Napi::Number bind_EVP_CIPHER_CTX_set_tag(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
+  Napi::Uint8Array tag = info[1].As<Napi::Uint8Array>();
+
+  ret = EVP_CIPHER_CTX_ctrl( evp, EVP_CTRL_AEAD_SET_TAG, (int)tag.ElementLength(), tag.Data() );
 
   return Napi::Number::New( env, ret );
 }
 
+// the optional 5th argument is an offset into the out buffer so callers can
+// write into a slice of a preallocated buffer, out must have room for in_len
+// plus one block past that offset
 Napi::Number bind_EVP_CipherUpdate(const Napi::CallbackInfo& info)
 {
   Napi::Env env = info.Env();
   int ret;
   EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
-  uint8_t* out_buf = info[1].As<Napi::Uint8Array>().Data();
+  Napi::Uint8Array out_arr = info[1].As<Napi::Uint8Array>();
   int out_len;
   uint8_t* in_buf = info[2].As<Napi::Uint8Array>().Data();
   int in_len = info[3].As<Napi::Number>().Int32Value();
+  size_t out_offset = 0;
+  int block_size = EVP_CIPHER_CTX_block_size( evp );
+
+  if ( info.Length() > 4 && info[4].IsNumber() )
+  {
+    out_offset = info[4].As<Napi::Number>().Uint32Value();
+  }
+
+  if ( in_len < 0 || out_offset > out_arr.ElementLength() ||
+    out_arr.ElementLength() - out_offset < (size_t)in_len + ( block_size > 1 ? block_size : 0 ) )
+  {
+    return Napi::Number::New( env, -1 );
+  }
 
-  ret = EVP_CipherUpdate( evp, out_buf, &out_len, in_buf, in_len );
+  ret = EVP_CipherUpdate( evp, out_arr.Data() + out_offset, &out_len, in_buf, in_len );
 
   if ( ret != WOLFSSL_SUCCESS )
     out_len = -1;
+  else
+    NODEJS_EVP_BUFFERED( evp ) += in_len - out_len;
 
   return Napi::Number::New( env, out_len );
 }
 
+class EVP_CipherUpdateAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    EVP_CipherUpdateAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, EVP_CIPHER_CTX* evp,
+      Napi::Uint8Array& out_arr, size_t out_offset, Napi::Uint8Array& in_arr, int in_len )
+      : Napi::AsyncWorker( callback ), evp( evp ), out( out_arr.Data() + out_offset ), in( in_arr.Data() ), in_len( in_len ),
+        stats( info )
+    {
+      out_ref = Napi::Persistent( out_arr );
+      in_ref = Napi::Persistent( in_arr );
+    }
+
+    ~EVP_CipherUpdateAsyncWorker() {}
+
+    void Execute() override
+    {
+      stats.start();
+
+      // the js side only runs one update per ctx at a time so chunks come out
+      // in order, the lock guards against callers that don't
+      std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( evp ) );
+
+      if ( EVP_CipherUpdate( evp, out, &out_len, in, in_len ) != WOLFSSL_SUCCESS )
+      {
+        out_len = -1;
+      }
+      else
+      {
+        NODEJS_EVP_BUFFERED( evp ) += in_len - out_len;
+      }
+
+      stats.finish( out_len );
+    }
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+      Callback().Call({Env().Undefined(), Napi::Number::New(Env(), out_len)});
+    }
+  private:
+    EVP_CIPHER_CTX* evp;
+    uint8_t* out;
+    int out_len;
+    uint8_t* in;
+    int in_len;
+    Napi::Reference<Napi::Uint8Array> out_ref;
+    Napi::Reference<Napi::Uint8Array> in_ref;
+    wolfcrypt_stats_async stats;
+};
+
+// same arguments as EVP_CipherUpdate with the out offset required, followed
+// by a callback that is called with the number of bytes written or -1
+Napi::Value EVP_CipherUpdate_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
+  Napi::Uint8Array out_arr = info[1].As<Napi::Uint8Array>();
+  Napi::Uint8Array in_arr = info[2].As<Napi::Uint8Array>();
+  int in_len = info[3].As<Napi::Number>().Int32Value();
+  size_t out_offset = info[4].As<Napi::Number>().Uint32Value();
+  Napi::Function callback = info[5].As<Napi::Function>();
+  int block_size = EVP_CIPHER_CTX_block_size( evp );
+
+  if ( in_len < 0 || out_offset > out_arr.ElementLength() ||
+    out_arr.ElementLength() - out_offset < (size_t)in_len + ( block_size > 1 ? block_size : 0 ) )
+  {
+    callback.Call( { env.Undefined(), Napi::Number::New( env, -1 ) } );
+
+    return env.Undefined();
+  }
+
+  EVP_CipherUpdateAsyncWorker* worker = new EVP_CipherUpdateAsyncWorker( callback, info, evp, out_arr, out_offset, in_arr, in_len );
+  worker->Queue();
+
+  return env.Undefined();
+}
+
 Napi::Number bind_EVP_CipherFinal(const Napi::CallbackInfo& info)
 {
   Napi::Env env = info.Env();
   int ret;
   EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
-  uint8_t* out_buf = info[1].As<Napi::Uint8Array>().Data();
+  Napi::Uint8Array out_arr = info[1].As<Napi::Uint8Array>();
   int out_len;
+  size_t out_offset = 0;
 
-  ret = EVP_CipherFinal( evp, out_buf, &out_len );
+  if ( info.Length() > 2 && info[2].IsNumber() )
+  {
+    out_offset = info[2].As<Napi::Number>().Uint32Value();
+  }
+
+  // the same bound as finalSize on the js side, everything still buffered
+  // plus one block of padding
+  if ( out_offset > out_arr.ElementLength() ||
+    out_arr.ElementLength() - out_offset < (size_t)( NODEJS_EVP_BUFFERED( evp ) + EVP_CIPHER_CTX_block_size( evp ) ) )
+  {
+    return Napi::Number::New( env, -1 );
+  }
+
+  ret = EVP_CipherFinal( evp, out_arr.Data() + out_offset, &out_len );
 
   if ( ret != WOLFSSL_SUCCESS )
     out_len = -1;
@@ -78,9 +268,18 @@ Napi::Number bind_EVP_CipherFinal(const Napi::CallbackInfo& info)
   return Napi::Number::New( env, out_len );
 }
 
+Napi::Number bind_EVP_CIPHER_CTX_block_size(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
+
+  return Napi::Number::New( env, EVP_CIPHER_CTX_block_size( evp ) );
+}
+
 void bind_EVP_CIPHER_CTX_free(const Napi::CallbackInfo& info)
 {
   EVP_CIPHER_CTX* evp = info[0].As<Napi::External<EVP_CIPHER_CTX>>().Data();
 
-  EVP_CIPHER_CTX_free( evp );
+  EVP_CIPHER_CTX_cleanup( evp );
+  wolfcrypt_pool_release( NATIVE_EVP, evp, sizeof( nodejs_evp_ctx ) );
 }
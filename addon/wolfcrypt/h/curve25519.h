@@ -0,0 +1,47 @@
+/* curve25519.h
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include <napi.h>
+#ifndef WOLFSSL_USER_SETTINGS
+#include "wolfssl/options.h"
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/curve25519.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include "./util.h"
+#include "./stats.h"
+#include "./random.h"
+
+#ifdef HAVE_CURVE25519
+Napi::Number sizeof_curve25519_key(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_curve25519_init(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_curve25519_make_key(const Napi::CallbackInfo& info);
+Napi::Value wc_curve25519_make_key_async(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_curve25519_export_public(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_curve25519_import_public(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_curve25519_export_private_raw(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_curve25519_import_private(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_curve25519_shared_secret(const Napi::CallbackInfo& info);
+Napi::Value wc_curve25519_shared_secret_async(const Napi::CallbackInfo& info);
+Napi::Value bind_wc_curve25519_shared_secret_many(const Napi::CallbackInfo& info);
+Napi::Value wc_curve25519_shared_secret_many_async(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_curve25519_free(const Napi::CallbackInfo& info);
+#endif
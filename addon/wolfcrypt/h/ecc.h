@@ -26,6 +26,10 @@
 #include <wolfssl/wolfcrypt/types.h>
 #include <wolfssl/wolfcrypt/ecc.h>
 #include <wolfssl/wolfcrypt/asn.h>
+#include "./util.h"
+#include "./stats.h"
+#include "./key_cache.h"
+#include "./random.h"
 
 Napi::Number sizeof_ecc_key(const Napi::CallbackInfo& info);
 Napi::Number sizeof_ecc_point(const Napi::CallbackInfo& info);
@@ -42,9 +46,20 @@ Napi::Number bind_wc_EccPublicKeyDecode(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_EccPublicKeyDerSize(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_EccPrivateKeyToDer(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_EccPrivateKeyDecode(const Napi::CallbackInfo& info);
+wolfcrypt_key_cache<ecc_key>& wolfcrypt_ecc_key_cache();
+Napi::Value nodejsEccKeyCached(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_ecc_set_curve(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_ecc_shared_secret(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_ecc_sig_size(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_ecc_sign_hash(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_ecc_verify_hash(const Napi::CallbackInfo& info);
+Napi::Value wc_ecc_sign_hash_async(const Napi::CallbackInfo& info);
+Napi::Value wc_ecc_verify_hash_async(const Napi::CallbackInfo& info);
+Napi::Value wc_ecc_verify_hash_batch(const Napi::CallbackInfo& info);
+Napi::Value wc_ecc_verify_hash_batch_multi(const Napi::CallbackInfo& info);
+Napi::Value wc_ecc_shared_secret_async(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_ecc_free(const Napi::CallbackInfo& info);
+Napi::Value nodejsEccFpWarm(const Napi::CallbackInfo& info);
+Napi::Number nodejsEccFpWarmSync(const Napi::CallbackInfo& info);
+Napi::Value nodejsEccFpFree(const Napi::CallbackInfo& info);
+Napi::Value nodejsEccFpStats(const Napi::CallbackInfo& info);
@@ -0,0 +1,54 @@
+/* ed25519.h
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include <napi.h>
+#ifndef WOLFSSL_USER_SETTINGS
+#include "wolfssl/options.h"
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/ed25519.h>
+#include <wolfssl/wolfcrypt/asn_public.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include "./util.h"
+#include "./stats.h"
+#include "./random.h"
+
+#ifdef HAVE_ED25519
+Napi::Number sizeof_ed25519_key(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_ed25519_init(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_ed25519_make_key(const Napi::CallbackInfo& info);
+Napi::Value wc_ed25519_make_key_async(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_ed25519_export_public(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_ed25519_import_public(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_ed25519_export_private_only(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_ed25519_import_private_key(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_Ed25519KeyToDer(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_Ed25519PublicKeyToDer(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_Ed25519PrivateKeyDecode(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_Ed25519PublicKeyDecode(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_ed25519_sign_msg(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_ed25519_verify_msg(const Napi::CallbackInfo& info);
+Napi::Value wc_ed25519_sign_msg_async(const Napi::CallbackInfo& info);
+Napi::Value wc_ed25519_verify_msg_async(const Napi::CallbackInfo& info);
+Napi::Value wc_ed25519_verify_msg_batch(const Napi::CallbackInfo& info);
+Napi::Value wc_ed25519_verify_msg_batch_multi(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_ed25519_free(const Napi::CallbackInfo& info);
+#endif
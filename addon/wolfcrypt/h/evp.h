@@ -28,9 +28,29 @@
 #include <wolfssl/wolfcrypt/types.h>
 #include "wolfssl/ssl.h"
 #include <wolfssl/openssl/evp.h>
+#include "./util.h"
+#include "./stats.h"
+#include "./native.h"
+
+// the ctx handed to js, buffered counts the input the cipher holds on to so
+// final can check there is room for all of it, AEAD ciphers may return every
+// byte at final rather than one block
+struct nodejs_evp_ctx
+{
+  EVP_CIPHER_CTX evp;
+  long buffered;
+};
+
+#define NODEJS_EVP_BUFFERED( evp ) ( ( (nodejs_evp_ctx*)( evp ) )->buffered )
 
 Napi::Value bind_EVP_CIPHER_CTX_new(const Napi::CallbackInfo& info);
 Napi::Number bind_EVP_CipherInit(const Napi::CallbackInfo& info);
+Napi::Number bind_EVP_CIPHER_CTX_set_iv_length(const Napi::CallbackInfo& info);
+Napi::Number bind_EVP_CipherUpdateAAD(const Napi::CallbackInfo& info);
+Napi::Number bind_EVP_CIPHER_CTX_get_tag(const Napi::CallbackInfo& info);
+Napi::Number bind_EVP_CIPHER_CTX_set_tag(const Napi::CallbackInfo& info);
 Napi::Number bind_EVP_CipherUpdate(const Napi::CallbackInfo& info);
+Napi::Value EVP_CipherUpdate_async(const Napi::CallbackInfo& info);
 Napi::Number bind_EVP_CipherFinal(const Napi::CallbackInfo& info);
+Napi::Number bind_EVP_CIPHER_CTX_block_size(const Napi::CallbackInfo& info);
 void bind_EVP_CIPHER_CTX_free(const Napi::CallbackInfo& info);
@@ -25,6 +25,8 @@
 #include <wolfssl/wolfcrypt/settings.h>
 #include <wolfssl/wolfcrypt/types.h>
 #include <wolfssl/wolfcrypt/hmac.h>
+#include "./sha.h"
+#include "./native.h"
 
 Napi::Number sizeof_Hmac(const Napi::CallbackInfo& info);
 Napi::Number typeof_Hmac(const Napi::CallbackInfo& info);
@@ -32,4 +34,13 @@ Napi::Number Hmac_digest_length(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_HmacSetKey(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_HmacUpdate(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_HmacFinal(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_HmacCopy(const Napi::CallbackInfo& info);
 void bind_wc_HmacFree(const Napi::CallbackInfo& info);
+
+Napi::Number sizeof_HmacKey(const Napi::CallbackInfo& info);
+Napi::Number nodejsHmacKeyInit(const Napi::CallbackInfo& info);
+Napi::Number nodejsHmacKeyReset(const Napi::CallbackInfo& info);
+Napi::Number nodejsHmacKeyUpdate(const Napi::CallbackInfo& info);
+Napi::Number nodejsHmacKeyFinal(const Napi::CallbackInfo& info);
+Napi::Number nodejsHmacKeyMac(const Napi::CallbackInfo& info);
+void nodejsHmacKeyFree(const Napi::CallbackInfo& info);
@@ -0,0 +1,377 @@
+/* key_cache.h
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+// the cache is a template shared by the rsa and ecc bindings, so it is guarded
+#pragma once
+#include <napi.h>
+#ifndef WOLFSSL_USER_SETTINGS
+#include "wolfssl/options.h"
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/sha256.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include <list>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <condition_variable>
+#include "./util.h"
+
+#define WOLFCRYPT_KEY_CACHE_DEFAULT_LIMIT 128
+
+// decoded keys keyed by the sha256 of their der, so services that decode the
+// same key on every request only parse the asn.1 and load the mp_ints once,
+// every handle made for a der shares one entry and keeps it alive after it is
+// evicted, the handles only point at a zeroed token that is never a key, so
+// writing to one can't reach the key, operations go through wolfcrypt_key_use
+// which checks out a copy of the key for the thread running them, copies are
+// decoded from the der when every other copy of the key is in use and kept
+// for the next operation, so operations on a shared key run in parallel
+// without locking it
+template<typename T>
+class wolfcrypt_key_cache
+{
+  public:
+    typedef std::function<int( const byte* der, word32* idx, T* key, word32 der_len )> decode_fn;
+
+    struct entry
+    {
+      entry( const uint8_t* der, size_t der_len, decode_fn decode )
+        : token(), der( der, der + der_len ), decode( decode )
+      {
+      }
+
+      T token;
+      std::vector<uint8_t> der;
+      decode_fn decode;
+      std::mutex lock;
+      std::condition_variable returned;
+      std::vector<T*> idle;
+    };
+
+    typedef std::shared_ptr<entry> entry_ptr;
+
+    wolfcrypt_key_cache( std::function<int( T* key )> init, std::function<void( T* key )> free )
+      : init( init ), free( free ), limit( WOLFCRYPT_KEY_CACHE_DEFAULT_LIMIT ), hits( 0 ), misses( 0 ),
+        evictions( 0 ), copies( 0 )
+    {
+    }
+
+    // returns the cached entry for the der, decoding its first copy with
+    // decode on a miss, kind keeps the private and public decodes of the same
+    // bytes apart
+    int get( const uint8_t* der, size_t der_len, char kind, decode_fn decode, entry_ptr& key )
+    {
+      std::string id( 1 + WC_SHA256_DIGEST_SIZE, kind );
+      int ret = wc_Sha256Hash( der, der_len, (byte*)&id[1] );
+      T* copy;
+
+      if ( ret != 0 )
+      {
+        return ret;
+      }
+
+      if ( lookup( id, key ) )
+      {
+        return 0;
+      }
+
+      // decode without holding the lock, a key decoded twice by racing
+      // threads keeps the first one cached
+      entry_ptr decoded( new entry( der, der_len, decode ), [this]( entry* e ) {
+        release( e );
+      } );
+
+      ret = decode_copy( decoded.get(), copy );
+
+      if ( ret != 0 )
+      {
+        return ret;
+      }
+
+      decoded->idle.push_back( copy );
+
+      std::lock_guard<std::mutex> guard( lock );
+      auto it = index.find( id );
+
+      misses++;
+
+      if ( it != index.end() )
+      {
+        entries.splice( entries.begin(), entries, it->second );
+        key = it->second->second;
+
+        return 0;
+      }
+
+      {
+        std::unique_lock<std::shared_mutex> tokens_guard( tokens_lock );
+
+        tokens[&decoded->token] = decoded.get();
+      }
+
+      entries.emplace_front( id, decoded );
+      index[id] = entries.begin();
+      key = decoded;
+      trim();
+
+      return 0;
+    }
+
+    // a Buffer over the token of the entry that holds a reference until it
+    // is collected
+    Napi::Value handle( Napi::Env env, entry_ptr key )
+    {
+      return Napi::Buffer<uint8_t>::New( env, (uint8_t*)&key->token, sizeof( T ),
+        []( Napi::Env env, uint8_t* data, entry_ptr* ref ) {
+          delete ref;
+        }, new entry_ptr( key ) );
+    }
+
+    // the entry a key pointer is the token of, or NULL for any other key,
+    // the handle passed to the operation keeps the entry alive
+    entry* find( const T* key )
+    {
+      std::shared_lock<std::shared_mutex> guard( tokens_lock );
+      auto it = tokens.find( key );
+
+      return it == tokens.end() ? NULL : it->second;
+    }
+
+    // takes an idle copy of the key, decodes a new one when there is none and
+    // only waits for one to come back when that fails
+    T* checkout( entry* e )
+    {
+      std::unique_lock<std::mutex> guard( e->lock );
+      T* copy;
+
+      if ( e->idle.empty() )
+      {
+        guard.unlock();
+
+        if ( decode_copy( e, copy ) == 0 )
+        {
+          std::lock_guard<std::mutex> stats_guard( lock );
+
+          copies++;
+
+          return copy;
+        }
+
+        guard.lock();
+        e->returned.wait( guard, [e] { return !e->idle.empty(); } );
+      }
+
+      copy = e->idle.back();
+      e->idle.pop_back();
+
+      return copy;
+    }
+
+    void checkin( entry* e, T* copy )
+    {
+      std::lock_guard<std::mutex> guard( e->lock );
+
+      e->idle.push_back( copy );
+      e->returned.notify_one();
+    }
+
+    void set_limit( size_t value )
+    {
+      std::lock_guard<std::mutex> guard( lock );
+
+      limit = value;
+      trim();
+    }
+
+    size_t get_limit()
+    {
+      std::lock_guard<std::mutex> guard( lock );
+
+      return limit;
+    }
+
+    void clear()
+    {
+      std::lock_guard<std::mutex> guard( lock );
+
+      evictions += entries.size();
+      entries.clear();
+      index.clear();
+    }
+
+    Napi::Object stats( Napi::Env env )
+    {
+      std::lock_guard<std::mutex> guard( lock );
+      Napi::Object result = Napi::Object::New( env );
+
+      result.Set( "size", Napi::Number::New( env, (double)entries.size() ) );
+      result.Set( "limit", Napi::Number::New( env, (double)limit ) );
+      result.Set( "hits", Napi::Number::New( env, (double)hits ) );
+      result.Set( "misses", Napi::Number::New( env, (double)misses ) );
+      result.Set( "evictions", Napi::Number::New( env, (double)evictions ) );
+      result.Set( "copies", Napi::Number::New( env, (double)copies ) );
+
+      return result;
+    }
+
+  private:
+    typedef std::list<std::pair<std::string, entry_ptr>> entry_list;
+
+    bool lookup( const std::string& id, entry_ptr& key )
+    {
+      std::lock_guard<std::mutex> guard( lock );
+      auto it = index.find( id );
+
+      if ( it == index.end() )
+      {
+        return false;
+      }
+
+      // most recently used first, eviction takes from the back
+      entries.splice( entries.begin(), entries, it->second );
+      key = it->second->second;
+      hits++;
+
+      return true;
+    }
+
+    int decode_copy( entry* e, T*& copy )
+    {
+      word32 idx = 0;
+      int ret;
+
+      copy = new T();
+      ret = init( copy );
+
+      if ( ret != 0 )
+      {
+        delete copy;
+
+        return ret;
+      }
+
+      ret = e->decode( e->der.data(), &idx, copy, e->der.size() );
+
+      if ( ret != 0 )
+      {
+        free( copy );
+        delete copy;
+      }
+
+      return ret;
+    }
+
+    // called once the cache and every handle have dropped the entry, so no
+    // operation has a copy checked out
+    void release( entry* e )
+    {
+      {
+        std::unique_lock<std::shared_mutex> guard( tokens_lock );
+        auto it = tokens.find( &e->token );
+
+        if ( it != tokens.end() && it->second == e )
+        {
+          tokens.erase( it );
+        }
+      }
+
+      for ( T* copy : e->idle )
+      {
+        free( copy );
+        delete copy;
+      }
+
+      delete e;
+    }
+
+    void trim()
+    {
+      while ( entries.size() > limit )
+      {
+        index.erase( entries.back().first );
+        entries.pop_back();
+        evictions++;
+      }
+    }
+
+    std::function<int( T* key )> init;
+    std::function<void( T* key )> free;
+    std::mutex lock;
+    entry_list entries;
+    std::unordered_map<std::string, typename entry_list::iterator> index;
+    std::shared_mutex tokens_lock;
+    std::unordered_map<const T*, entry*> tokens;
+    size_t limit;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t copies;
+};
+
+// the key an operation runs on, for a cached key that is a copy checked out
+// until the operation is done, any other key is the key itself and is locked
+// for the operation unless lock is false, for callers that lock several keys
+// together with wolfcrypt_key_pair_lock
+template<typename T>
+class wolfcrypt_key_use
+{
+  public:
+    wolfcrypt_key_use( wolfcrypt_key_cache<T>& cache, T* key, bool lock = true )
+      : cache( cache ), cached( cache.find( key ) ), key( key )
+    {
+      if ( cached != NULL )
+      {
+        this->key = cache.checkout( cached );
+      }
+      else if ( lock )
+      {
+        held = std::unique_lock<std::mutex>( wolfcrypt_key_lock( key ) );
+      }
+    }
+
+    ~wolfcrypt_key_use()
+    {
+      if ( cached != NULL )
+      {
+        cache.checkin( cached, key );
+      }
+    }
+
+    wolfcrypt_key_use( const wolfcrypt_key_use& ) = delete;
+    wolfcrypt_key_use& operator=( const wolfcrypt_key_use& ) = delete;
+
+  private:
+    wolfcrypt_key_cache<T>& cache;
+    typename wolfcrypt_key_cache<T>::entry* cached;
+    std::unique_lock<std::mutex> held;
+
+  public:
+    T* key;
+};
+
+Napi::Value nodejsKeyCacheStats(const Napi::CallbackInfo& info);
+Napi::Value nodejsKeyCacheLimit(const Napi::CallbackInfo& info);
+void nodejsKeyCacheClear(const Napi::CallbackInfo& info);
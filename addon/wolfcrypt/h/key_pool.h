@@ -0,0 +1,38 @@
+/* key_pool.h
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include <napi.h>
+#ifndef WOLFSSL_USER_SETTINGS
+#include "wolfssl/options.h"
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/rsa.h>
+#include <wolfssl/wolfcrypt/ecc.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include "./native.h"
+#include "./thread_pool.h"
+#include "./random.h"
+
+Napi::Number nodejsKeyPoolConfigure(const Napi::CallbackInfo& info);
+Napi::Value nodejsRsaKeyPooled(const Napi::CallbackInfo& info);
+Napi::Value nodejsEccKeyPooled(const Napi::CallbackInfo& info);
+Napi::Value nodejsKeyPoolStats(const Napi::CallbackInfo& info);
+void nodejsKeyPoolClear(const Napi::CallbackInfo& info);
@@ -0,0 +1,94 @@
+/* native.h
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+// defines the handle types shared with the evp bindings, so it is guarded
+#pragma once
+#include <napi.h>
+#ifndef WOLFSSL_USER_SETTINGS
+#include "wolfssl/options.h"
+#endif
+#include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/rsa.h>
+#include <wolfssl/wolfcrypt/ecc.h>
+#include <wolfssl/wolfcrypt/hmac.h>
+#include <wolfssl/wolfcrypt/hash.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include <wolfssl/openssl/sha.h>
+#include <wolfssl/wolfcrypt/pkcs7.h>
+#include <wolfssl/wolfcrypt/ed25519.h>
+#include <wolfssl/wolfcrypt/curve25519.h>
+#include "./util.h"
+
+enum native_handle_type
+{
+  NATIVE_RSA,
+  NATIVE_ECC,
+  NATIVE_HMAC,
+  NATIVE_SHA,
+  NATIVE_PKCS7,
+  NATIVE_EVP,
+  NATIVE_ED25519,
+  NATIVE_CURVE25519,
+  NATIVE_HMAC_KEY,
+  NATIVE_TYPE_COUNT
+};
+
+#define NATIVE_POOL_DEFAULT_LIMIT 64
+
+// a key that is used for many messages keeps the hash state after the ipad
+// block and after the opad block, so a message only pays for its own data
+// and the final outer block instead of re-running the key schedule
+typedef struct HmacKey
+{
+  wc_HashAlg inner;
+  wc_HashAlg outer;
+  wc_HashAlg current;
+  int type;
+  int digest_len;
+} HmacKey;
+
+// zeroed memory for a struct of the given type, taken from the free list of
+// its size when there is one, release zeroes it and puts it back
+void* wolfcrypt_pool_alloc( int type, size_t size );
+void wolfcrypt_pool_release( int type, void* data, size_t size );
+
+// registers a struct from wolfcrypt_pool_alloc that native code has already
+// initialized and returns a handle for it, the finalizer frees it as usual
+Napi::Value wolfcrypt_native_handle_adopt( Napi::Env env, int type, void* data, size_t size );
+
+Napi::Value nodejsRsaKeyNew(const Napi::CallbackInfo& info);
+Napi::Value nodejsEccKeyNew(const Napi::CallbackInfo& info);
+Napi::Value nodejsHmacNew(const Napi::CallbackInfo& info);
+Napi::Value nodejsHmacKeyNew(const Napi::CallbackInfo& info);
+Napi::Value nodejsShaNew(const Napi::CallbackInfo& info);
+#ifdef HAVE_PKCS7
+Napi::Value nodejsPKCS7New(const Napi::CallbackInfo& info);
+#endif
+#ifdef HAVE_ED25519
+Napi::Value nodejsEd25519KeyNew(const Napi::CallbackInfo& info);
+#endif
+#ifdef HAVE_CURVE25519
+Napi::Value nodejsCurve25519KeyNew(const Napi::CallbackInfo& info);
+#endif
+Napi::Number nodejsHandleRelease(const Napi::CallbackInfo& info);
+Napi::Object nodejsHandleStats(const Napi::CallbackInfo& info);
+Napi::Object nodejsPoolStats(const Napi::CallbackInfo& info);
+Napi::Number nodejsPoolLimit(const Napi::CallbackInfo& info);
@@ -23,6 +23,10 @@
     #include <wolfssl/options.h>
 #endif
 #include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
 #include <wolfssl/wolfcrypt/pwdbased.h>
+#include "./thread_pool.h"
 
 Napi::Number bind_wc_PBKDF2(const Napi::CallbackInfo& info);
+void bind_wc_PBKDF2_async(const Napi::CallbackInfo& info);
+void bind_wc_PBKDF2_batch(const Napi::CallbackInfo& info);
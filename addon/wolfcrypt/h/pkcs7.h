@@ -26,6 +26,7 @@
 #include <wolfssl/wolfcrypt/types.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
 #include <wolfssl/wolfcrypt/pkcs7.h>
+#include "./random.h"
 
 #ifdef HAVE_PKCS7
 Napi::Number sizeof_PKCS7(const Napi::CallbackInfo& info);
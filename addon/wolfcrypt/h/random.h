@@ -30,3 +30,6 @@ Napi::Number sizeof_WC_RNG(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_InitRng(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_RNG_GenerateBlock(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_FreeRng(const Napi::CallbackInfo& info);
+Napi::Object nodejsRngStats(const Napi::CallbackInfo& info);
+
+WC_RNG* wolfcrypt_thread_rng();
@@ -27,8 +27,16 @@
 #include <wolfssl/wolfcrypt/rsa.h>
 #include <wolfssl/wolfcrypt/asn_public.h>
 #include <wolfssl/wolfcrypt/random.h>
+#include <wolfssl/wolfcrypt/hash.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include "./util.h"
+#include "./stats.h"
+#include "./key_cache.h"
+#include "./random.h"
 
 Napi::Number sizeof_RsaKey(const Napi::CallbackInfo& info);
+Napi::Number typeof_RsaPad(const Napi::CallbackInfo& info);
+Napi::Number typeof_RsaMgf(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_RsaEncryptSize(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_InitRsaKey(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_MakeRsaKey(const Napi::CallbackInfo& info);
@@ -39,8 +47,28 @@ Napi::Number RsaPublicDerSize(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_RsaKeyToPublicDer(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_RsaPrivateKeyDecode(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_RsaPublicKeyDecode(const Napi::CallbackInfo& info);
+wolfcrypt_key_cache<RsaKey>& wolfcrypt_rsa_key_cache();
+Napi::Value nodejsRsaKeyCached(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_RsaPublicEncrypt(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_RsaPrivateDecrypt(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_RsaSSL_Sign(const Napi::CallbackInfo& info);
 Napi::Number bind_wc_RsaSSL_Verify(const Napi::CallbackInfo& info);
+Napi::Value wc_RsaPublicEncrypt_async(const Napi::CallbackInfo& info);
+Napi::Value wc_RsaPrivateDecrypt_async(const Napi::CallbackInfo& info);
+Napi::Value wc_RsaSSL_Sign_async(const Napi::CallbackInfo& info);
+Napi::Value wc_RsaSSL_Verify_async(const Napi::CallbackInfo& info);
+#ifndef WC_NO_RSA_OAEP
+Napi::Number bind_wc_RsaPublicEncrypt_ex(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_RsaPrivateDecrypt_ex(const Napi::CallbackInfo& info);
+Napi::Value wc_RsaPublicEncrypt_ex_async(const Napi::CallbackInfo& info);
+Napi::Value wc_RsaPrivateDecrypt_ex_async(const Napi::CallbackInfo& info);
+#endif
+#ifdef WC_RSA_PSS
+Napi::Number bind_wc_RsaPSS_Sign(const Napi::CallbackInfo& info);
+Napi::Number bind_wc_RsaPSS_Verify(const Napi::CallbackInfo& info);
+Napi::Number nodejsRsaPSS_VerifyHash(const Napi::CallbackInfo& info);
+Napi::Value wc_RsaPSS_Sign_async(const Napi::CallbackInfo& info);
+Napi::Value wc_RsaPSS_Verify_async(const Napi::CallbackInfo& info);
+Napi::Value nodejsRsaPSS_VerifyHash_async(const Napi::CallbackInfo& info);
+#endif
 Napi::Number bind_wc_FreeRsaKey(const Napi::CallbackInfo& info);
@@ -28,9 +28,20 @@
 #include <wolfssl/wolfcrypt/sha256.h>
 #include <wolfssl/wolfcrypt/sha512.h>
 #include <wolfssl/wolfcrypt/sha3.h>
+#include <wolfssl/wolfcrypt/md5.h>
 #include <wolfssl/openssl/sha.h>
+#include <wolfssl/wolfcrypt/hash.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include "./util.h"
 
 Napi::Number Sha_digest_length(const Napi::CallbackInfo& info);
+Napi::Number typeof_Hash(const Napi::CallbackInfo& info);
+Napi::Value bind_wc_Hash(const Napi::CallbackInfo& info);
+Napi::Value bind_wc_HashMany(const Napi::CallbackInfo& info);
+Napi::Value wc_HashMany_async(const Napi::CallbackInfo& info);
+Napi::Number nodejsShaCopy(const Napi::CallbackInfo& info);
+
+int wolfcrypt_hash_copy( enum wc_HashType type, void* src, void* dst );
 
 Napi::Number sizeof_WOLFSSL_SHA_CTX(const Napi::CallbackInfo& info);
 Napi::Number bind_wolfSSL_SHA_Init(const Napi::CallbackInfo& info);
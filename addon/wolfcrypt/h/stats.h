@@ -0,0 +1,140 @@
+/* stats.h
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+// defines the counters and the wrapper template every binding is registered
+// through, so it is guarded
+#pragma once
+#include <napi.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <type_traits>
+
+#define WOLFCRYPT_STATS_BUCKETS 32
+
+// what the wrapper does after a call, both features share one flag word so a
+// call with everything off costs a single load
+enum wolfcrypt_stats_flag
+{
+  WOLFCRYPT_STATS_COUNT = 1,
+  WOLFCRYPT_STATS_WATCHDOG = 2
+};
+
+// counters for one exported function, bucket i of a histogram counts the
+// calls that took less than 2^(i + 1) nanoseconds, the last one everything
+// slower, async work adds the time it waited for a thread and the time it ran
+// separately from the time the call that queued it took
+typedef struct wolfcrypt_stats_op
+{
+  const char* name;
+  int data_arg;
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> bytes;
+  std::atomic<uint64_t> ns;
+  std::atomic<uint64_t> histogram[WOLFCRYPT_STATS_BUCKETS];
+  std::atomic<uint64_t> async_calls;
+  std::atomic<uint64_t> queue_ns;
+  std::atomic<uint64_t> queue_max_ns;
+  std::atomic<uint64_t> execute_ns;
+  std::atomic<uint64_t> execute_histogram[WOLFCRYPT_STATS_BUCKETS];
+  std::mutex errors_lock;
+  std::unordered_map<int, uint64_t> errors;
+  // set by the watchdog once a call took longer than its threshold
+  std::atomic<bool> slow;
+} wolfcrypt_stats_op;
+
+extern std::atomic<int> wolfcrypt_stats_flags;
+
+wolfcrypt_stats_op* wolfcrypt_stats_register( const char* name, int data_arg );
+wolfcrypt_stats_op* wolfcrypt_stats_find( const std::string& name );
+void wolfcrypt_stats_each( void ( *fn )( wolfcrypt_stats_op* op ) );
+void wolfcrypt_stats_record( wolfcrypt_stats_op* op, const Napi::CallbackInfo& info, Napi::Value ret, uint64_t ns, int flags );
+void wolfcrypt_stats_record_async( wolfcrypt_stats_op* op, uint64_t queue_ns, uint64_t execute_ns, int ret );
+
+// the exported functions are registered through this so the counters and
+// the watchdog cost a single relaxed load while both are disabled
+template<auto F>
+Napi::Value wolfcrypt_stats_call(const Napi::CallbackInfo& info)
+{
+  int flags = wolfcrypt_stats_flags.load( std::memory_order_relaxed );
+
+  if ( flags == 0 )
+  {
+    if constexpr ( std::is_void_v<decltype( F( info ) )> )
+    {
+      F( info );
+
+      return info.Env().Undefined();
+    }
+    else
+    {
+      return F( info );
+    }
+  }
+
+  Napi::Value ret;
+  auto start = std::chrono::steady_clock::now();
+
+  if constexpr ( std::is_void_v<decltype( F( info ) )> )
+  {
+    F( info );
+    ret = info.Env().Undefined();
+  }
+  else
+  {
+    ret = F( info );
+  }
+
+  uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count();
+
+  wolfcrypt_stats_record( (wolfcrypt_stats_op*)info.Data(), info, ret, ns, flags );
+
+  return ret;
+}
+
+// data_arg is the argument holding the data an operation processes, either a
+// length or the buffer itself, for the bytes counter, -1 counts no bytes
+template<auto F>
+Napi::Function wolfcrypt_stats_function( Napi::Env env, const char* name, int data_arg = -1 )
+{
+  return Napi::Function::New( env, wolfcrypt_stats_call<F>, name, wolfcrypt_stats_register( name, data_arg ) );
+}
+
+// carried by async workers, it notes when the work was queued from the info
+// of the call queueing it and records the wait and the run once it is done
+class wolfcrypt_stats_async
+{
+  public:
+    wolfcrypt_stats_async( const Napi::CallbackInfo& info );
+
+    void start();
+    void finish( int ret );
+
+  private:
+    wolfcrypt_stats_op* op;
+    std::chrono::steady_clock::time_point queued;
+    std::chrono::steady_clock::time_point started;
+};
+
+Napi::Value nodejsStats(const Napi::CallbackInfo& info);
+void nodejsStatsReset(const Napi::CallbackInfo& info);
+Napi::Value nodejsStatsEnabled(const Napi::CallbackInfo& info);
@@ -0,0 +1,86 @@
+/* thread_pool.h
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+// this one defines classes as well and is shared by the kdf bindings
+#pragma once
+#include <napi.h>
+#include <memory>
+#include <atomic>
+
+// work such as password hashing is slow enough per call that running it on
+// the libuv thread pool would hold up file and dns requests sharing it, so it
+// gets a pool of its own threads instead, execute is called on one of them
+// and complete is called on the main thread with the js callback afterwards
+class wolfcrypt_pool_job : public std::enable_shared_from_this<wolfcrypt_pool_job>
+{
+  public:
+    wolfcrypt_pool_job( Napi::Env env, Napi::Function& callback );
+    // a job queued by native code, complete is never called
+    wolfcrypt_pool_job();
+    virtual ~wolfcrypt_pool_job() {}
+
+    virtual void execute() = 0;
+    virtual void complete( Napi::Env env, Napi::Function callback ) = 0;
+
+    void run();
+
+  protected:
+    // keeps the event loop alive and carries calls back to the main thread
+    Napi::ThreadSafeFunction tsfn;
+};
+
+void wolfcrypt_pool_queue( std::shared_ptr<wolfcrypt_pool_job> job );
+
+// a batch of independent items worked on by one job per pool thread, each job
+// takes the next item until none are left so items of uneven cost still
+// spread evenly, run returns 0 or the error that stops the batch, once every
+// job is done the callback gets ( undefined, ret, result ) and the optional
+// progress function is called with ( done, count ) roughly every percent
+class wolfcrypt_pool_batch
+{
+  public:
+    wolfcrypt_pool_batch( size_t count );
+    virtual ~wolfcrypt_pool_batch() {}
+
+    virtual int run( size_t index ) = 0;
+    virtual Napi::Value result( Napi::Env env ) = 0;
+
+  protected:
+    size_t count;
+
+  private:
+    std::atomic<size_t> next;
+    std::atomic<size_t> done;
+    std::atomic<int> ret;
+    size_t outstanding;
+    size_t progress_step;
+    Napi::FunctionReference progress;
+
+    friend class wolfcrypt_pool_batch_job;
+    friend void wolfcrypt_pool_batch_queue( Napi::Env env, std::shared_ptr<wolfcrypt_pool_batch> batch, Napi::Function& callback, Napi::Value progress );
+};
+
+void wolfcrypt_pool_batch_queue( Napi::Env env, std::shared_ptr<wolfcrypt_pool_batch> batch, Napi::Function& callback, Napi::Value progress );
+
+// number of pool threads, defaults to the number of cores
+size_t wolfcrypt_pool_size();
+void wolfcrypt_pool_set_size( size_t size );
+
+Napi::Number nodejsThreadPoolSize(const Napi::CallbackInfo& info);
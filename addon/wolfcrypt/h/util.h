@@ -0,0 +1,91 @@
+/* util.h
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+// unlike the other headers this one defines classes and is included by
+// several of them, so it has to be guarded
+#pragma once
+#include <napi.h>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <atomic>
+
+std::mutex& wolfcrypt_key_lock( const void* key );
+
+// locks the keys used by an operation that needs two of them, such as a
+// shared secret, without deadlocking against an operation locking them in
+// the opposite order
+class wolfcrypt_key_pair_lock
+{
+  public:
+    wolfcrypt_key_pair_lock( const void* a, const void* b );
+
+  private:
+    std::unique_lock<std::mutex> first;
+    std::unique_lock<std::mutex> second;
+};
+
+// a batch of independent items split into chunks that run as separate async
+// workers, run is called from the thread pool for each chunk and result is
+// called on the main thread once every chunk is done, its value is passed to
+// the callback as ( undefined, ret, result )
+class wolfcrypt_batch
+{
+  public:
+    wolfcrypt_batch( Napi::Function& callback, size_t count );
+    virtual ~wolfcrypt_batch() {}
+
+    virtual void run( size_t start, size_t end ) = 0;
+    virtual Napi::Value result( Napi::Env env ) = 0;
+
+    // keeps a js value, such as an input buffer, alive until the batch is done
+    void pin( Napi::Object value );
+    void chunk_done( Napi::Env env );
+
+  protected:
+    size_t count;
+    std::atomic<int> ret;
+
+  private:
+    Napi::FunctionReference callback;
+    std::vector<Napi::ObjectReference> pinned;
+    size_t outstanding;
+
+    friend void wolfcrypt_batch_queue( Napi::Env env, std::shared_ptr<wolfcrypt_batch> batch, size_t min_chunk );
+};
+
+// batch inputs are packed into one buffer with count + 1 offsets marking
+// where every item starts, wolfcrypt_packed_count returns count or -1 when
+// offsets is not a Uint32Array with at least one entry, and
+// wolfcrypt_packed_valid checks that offsets holds exactly count + 1 rising
+// offsets and that the last one is within data, so no item reads past it
+long wolfcrypt_packed_count( Napi::Value offsets );
+bool wolfcrypt_packed_valid( Napi::Value data, Napi::Value offsets, size_t count );
+
+// calls back with err from a worker that does nothing, so an input rejected
+// before a batch is queued still reaches the callback asynchronously
+void wolfcrypt_batch_fail( Napi::Function& callback, int err );
+
+// number of libuv pool threads, read from UV_THREADPOOL_SIZE like libuv does
+size_t wolfcrypt_uv_pool_size();
+
+// splits the batch across the libuv thread pool, chunks are never smaller than
+// min_chunk items so small batches don't pay for extra worker round trips
+void wolfcrypt_batch_queue( Napi::Env env, std::shared_ptr<wolfcrypt_batch> batch, size_t min_chunk );
@@ -0,0 +1,31 @@
+/* watchdog.h
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include <napi.h>
+#include "./stats.h"
+
+// the last events are kept, older ones are only counted
+#define WOLFCRYPT_WATCHDOG_EVENTS 64
+
+void wolfcrypt_watchdog_check( wolfcrypt_stats_op* op, const Napi::CallbackInfo& info, uint64_t ns );
+
+Napi::Value nodejsWatchdog(const Napi::CallbackInfo& info);
+Napi::Value nodejsWatchdogEvents(const Napi::CallbackInfo& info);
+Napi::Value nodejsWatchdogRerouted(const Napi::CallbackInfo& info);
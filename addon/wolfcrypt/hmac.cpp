@@ -197,9 +197,217 @@ Napi::Number bind_wc_HmacFinal(const Napi::CallbackInfo& info)
   return Napi::Number::New( env, ret );
 }
 
+// copies the keyed state of src into dst so a shared prefix only has to be
+// hashed once, the hash inside the Hmac is copied with its own copy function
+// since it may own resources that a plain memcpy would share
+Napi::Number bind_wc_HmacCopy(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  Hmac* src = (Hmac*)( info[0].As<Napi::Uint8Array>().Data() );
+  Hmac* dst = (Hmac*)( info[1].As<Napi::Uint8Array>().Data() );
+
+  memcpy( dst, src, sizeof( Hmac ) );
+
+  // macType uses the wc_HashType values
+  ret = wolfcrypt_hash_copy( (enum wc_HashType)src->macType, &src->hash, &dst->hash );
+
+  return Napi::Number::New( env, ret );
+}
+
 void bind_wc_HmacFree(const Napi::CallbackInfo& info)
 {
   Hmac* hmac = (Hmac*)( info[0].As<Napi::Uint8Array>().Data() );
 
   wc_HmacFree( hmac );
 }
+
+Napi::Number sizeof_HmacKey(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+
+  return Napi::Number::New( env, sizeof( HmacKey ) );
+}
+
+// finishes the hmac of the inner state in, which is consumed
+static int hmac_key_final( HmacKey* hk, wc_HashAlg* in, uint8_t* out )
+{
+  int ret;
+  enum wc_HashType type = (enum wc_HashType)hk->type;
+  uint8_t inner_digest[WC_MAX_DIGEST_SIZE];
+  wc_HashAlg outer;
+
+  ret = wc_HashFinal( in, type, inner_digest );
+  wc_HashFree( in, type );
+
+  if ( ret == 0 )
+  {
+    ret = wolfcrypt_hash_copy( type, &hk->outer, &outer );
+  }
+
+  if ( ret == 0 )
+  {
+    ret = wc_HashUpdate( &outer, type, inner_digest, hk->digest_len );
+
+    if ( ret == 0 )
+    {
+      ret = wc_HashFinal( &outer, type, out );
+    }
+
+    wc_HashFree( &outer, type );
+  }
+
+  return ret;
+}
+
+// nodejsHmacKeyInit( hmacKey, type, key, keySz ), type comes from typeof_Hmac
+Napi::Number nodejsHmacKeyInit(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  HmacKey* hk = (HmacKey*)( info[0].As<Napi::Uint8Array>().Data() );
+  int type = info[1].As<Napi::Number>().Int32Value();
+  uint8_t* key = info[2].As<Napi::Uint8Array>().Data();
+  uint32_t keySz = info[3].As<Napi::Number>().Uint32Value();
+  Hmac hmac;
+  int block_size;
+
+  ret = wc_HmacInit( &hmac, NULL, INVALID_DEVID );
+
+  if ( ret != 0 )
+  {
+    return Napi::Number::New( env, ret );
+  }
+
+  ret = wc_HmacSetKey( &hmac, type, key, keySz );
+
+  // an empty update hashes the ipad block into the inner state
+  if ( ret == 0 )
+  {
+    ret = wc_HmacUpdate( &hmac, NULL, 0 );
+  }
+
+  block_size = wc_HashGetBlockSize( (enum wc_HashType)type );
+
+  if ( ret == 0 && block_size <= 0 )
+  {
+    ret = BAD_FUNC_ARG;
+  }
+
+  if ( ret == 0 )
+  {
+    hk->type = type;
+    hk->digest_len = wc_HashGetDigestSize( (enum wc_HashType)type );
+
+    // macType uses the wc_HashType values
+    ret = wolfcrypt_hash_copy( (enum wc_HashType)type, &hmac.hash, &hk->inner );
+  }
+
+  if ( ret == 0 )
+  {
+    ret = wc_HashInit( &hk->outer, (enum wc_HashType)type );
+
+    if ( ret == 0 )
+    {
+      ret = wc_HashUpdate( &hk->outer, (enum wc_HashType)type, (const uint8_t*)hmac.opad, block_size );
+    }
+  }
+
+  if ( ret == 0 )
+  {
+    ret = wolfcrypt_hash_copy( (enum wc_HashType)type, &hk->inner, &hk->current );
+  }
+
+  wc_HmacFree( &hmac );
+  memset( &hmac, 0, sizeof( hmac ) );
+
+  return Napi::Number::New( env, ret );
+}
+
+// drops the message in progress, the key schedule is kept
+Napi::Number nodejsHmacKeyReset(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  HmacKey* hk = (HmacKey*)( info[0].As<Napi::Uint8Array>().Data() );
+
+  wc_HashFree( &hk->current, (enum wc_HashType)hk->type );
+  ret = wolfcrypt_hash_copy( (enum wc_HashType)hk->type, &hk->inner, &hk->current );
+
+  return Napi::Number::New( env, ret );
+}
+
+Napi::Number nodejsHmacKeyUpdate(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  HmacKey* hk = (HmacKey*)( info[0].As<Napi::Uint8Array>().Data() );
+  uint8_t* in = info[1].As<Napi::Uint8Array>().Data();
+  int inSz = info[2].As<Napi::Number>().Int32Value();
+
+  ret = wc_HashUpdate( &hk->current, (enum wc_HashType)hk->type, in, inSz );
+
+  return Napi::Number::New( env, ret );
+}
+
+// writes the hmac of the message in progress to out and starts a new one
+Napi::Number nodejsHmacKeyFinal(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  HmacKey* hk = (HmacKey*)( info[0].As<Napi::Uint8Array>().Data() );
+  uint8_t* out = info[1].As<Napi::Uint8Array>().Data();
+
+  ret = hmac_key_final( hk, &hk->current, out );
+
+  if ( ret == 0 )
+  {
+    ret = wolfcrypt_hash_copy( (enum wc_HashType)hk->type, &hk->inner, &hk->current );
+  }
+
+  return Napi::Number::New( env, ret );
+}
+
+// one shot hmac of in, the message in progress is not touched
+Napi::Number nodejsHmacKeyMac(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  HmacKey* hk = (HmacKey*)( info[0].As<Napi::Uint8Array>().Data() );
+  uint8_t* in = info[1].As<Napi::Uint8Array>().Data();
+  int inSz = info[2].As<Napi::Number>().Int32Value();
+  uint8_t* out = info[3].As<Napi::Uint8Array>().Data();
+  wc_HashAlg inner;
+
+  ret = wolfcrypt_hash_copy( (enum wc_HashType)hk->type, &hk->inner, &inner );
+
+  if ( ret != 0 )
+  {
+    return Napi::Number::New( env, ret );
+  }
+
+  ret = wc_HashUpdate( &inner, (enum wc_HashType)hk->type, in, inSz );
+
+  if ( ret != 0 )
+  {
+    wc_HashFree( &inner, (enum wc_HashType)hk->type );
+
+    return Napi::Number::New( env, ret );
+  }
+
+  ret = hmac_key_final( hk, &inner, out );
+
+  return Napi::Number::New( env, ret );
+}
+
+void nodejsHmacKeyFree(const Napi::CallbackInfo& info)
+{
+  HmacKey* hk = (HmacKey*)( info[0].As<Napi::Uint8Array>().Data() );
+
+  wc_HashFree( &hk->inner, (enum wc_HashType)hk->type );
+  wc_HashFree( &hk->outer, (enum wc_HashType)hk->type );
+  wc_HashFree( &hk->current, (enum wc_HashType)hk->type );
+
+  // the states are as good as the key
+  memset( hk, 0, sizeof( HmacKey ) );
+}
@@ -0,0 +1,440 @@
+/* kdf.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/kdf.h"
+#include <cstring>
+#include <vector>
+
+enum kdf_op
+{
+  KDF_HKDF,
+  KDF_HKDF_EXTRACT,
+  KDF_HKDF_EXPAND,
+  KDF_X963
+};
+
+// every form of every kdf ends up here, type is a typeof_Hmac value which
+// matches the wc_HashType the X9.63 kdf takes, extract ignores info and outSz
+// and always writes the digest size
+static int kdf_run( int op, int type, const uint8_t* key, word32 keySz, const uint8_t* salt, word32 saltSz,
+  const uint8_t* info, word32 infoSz, uint8_t* out, word32 outSz )
+{
+  switch ( op )
+  {
+#ifdef HAVE_HKDF
+    case KDF_HKDF:
+      return wc_HKDF( type, key, keySz, salt, saltSz, info, infoSz, out, outSz );
+    case KDF_HKDF_EXTRACT:
+      return wc_HKDF_Extract( type, salt, saltSz, key, keySz, out );
+    case KDF_HKDF_EXPAND:
+      return wc_HKDF_Expand( type, key, keySz, info, infoSz, out, outSz );
+#endif
+#ifdef HAVE_X963_KDF
+    case KDF_X963:
+      return wc_X963_KDF( (enum wc_HashType)type, key, keySz, info, infoSz, out, outSz );
+#endif
+    default:
+      return NOT_COMPILED_IN;
+  }
+}
+
+// wc_HKDF( type, inKey, inKeySz, salt, saltSz, info, infoSz, out, outSz )
+Napi::Number bind_wc_HKDF(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  int type = info[0].As<Napi::Number>().Int32Value();
+  uint8_t* inKey = info[1].As<Napi::Uint8Array>().Data();
+  word32 inKeySz = info[2].As<Napi::Number>().Uint32Value();
+  uint8_t* salt = info[3].As<Napi::Uint8Array>().Data();
+  word32 saltSz = info[4].As<Napi::Number>().Uint32Value();
+  uint8_t* kdfInfo = info[5].As<Napi::Uint8Array>().Data();
+  word32 infoSz = info[6].As<Napi::Number>().Uint32Value();
+  uint8_t* out = info[7].As<Napi::Uint8Array>().Data();
+  word32 outSz = info[8].As<Napi::Number>().Uint32Value();
+
+  ret = kdf_run( KDF_HKDF, type, inKey, inKeySz, salt, saltSz, kdfInfo, infoSz, out, outSz );
+
+  return Napi::Number::New( env, ret );
+}
+
+// wc_HKDF_Extract( type, salt, saltSz, inKey, inKeySz, out ), out has to hold
+// the digest size of type
+Napi::Number bind_wc_HKDF_Extract(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  int type = info[0].As<Napi::Number>().Int32Value();
+  uint8_t* salt = info[1].As<Napi::Uint8Array>().Data();
+  word32 saltSz = info[2].As<Napi::Number>().Uint32Value();
+  uint8_t* inKey = info[3].As<Napi::Uint8Array>().Data();
+  word32 inKeySz = info[4].As<Napi::Number>().Uint32Value();
+  Napi::Uint8Array out = info[5].As<Napi::Uint8Array>();
+
+  if ( out.ByteLength() < (size_t)wc_HmacSizeByType( type ) )
+  {
+    return Napi::Number::New( env, BUFFER_E );
+  }
+
+  ret = kdf_run( KDF_HKDF_EXTRACT, type, inKey, inKeySz, salt, saltSz, NULL, 0, out.Data(), 0 );
+
+  return Napi::Number::New( env, ret );
+}
+
+// wc_HKDF_Expand( type, inKey, inKeySz, info, infoSz, out, outSz )
+Napi::Number bind_wc_HKDF_Expand(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  int type = info[0].As<Napi::Number>().Int32Value();
+  uint8_t* inKey = info[1].As<Napi::Uint8Array>().Data();
+  word32 inKeySz = info[2].As<Napi::Number>().Uint32Value();
+  uint8_t* kdfInfo = info[3].As<Napi::Uint8Array>().Data();
+  word32 infoSz = info[4].As<Napi::Number>().Uint32Value();
+  uint8_t* out = info[5].As<Napi::Uint8Array>().Data();
+  word32 outSz = info[6].As<Napi::Number>().Uint32Value();
+
+  ret = kdf_run( KDF_HKDF_EXPAND, type, inKey, inKeySz, NULL, 0, kdfInfo, infoSz, out, outSz );
+
+  return Napi::Number::New( env, ret );
+}
+
+// wc_X963_KDF( type, secret, secretSz, sinfo, sinfoSz, out, outSz )
+Napi::Number bind_wc_X963_KDF(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int ret;
+  int type = info[0].As<Napi::Number>().Int32Value();
+  uint8_t* secret = info[1].As<Napi::Uint8Array>().Data();
+  word32 secretSz = info[2].As<Napi::Number>().Uint32Value();
+  uint8_t* sinfo = info[3].As<Napi::Uint8Array>().Data();
+  word32 sinfoSz = info[4].As<Napi::Number>().Uint32Value();
+  uint8_t* out = info[5].As<Napi::Uint8Array>().Data();
+  word32 outSz = info[6].As<Napi::Number>().Uint32Value();
+
+  ret = kdf_run( KDF_X963, type, secret, secretSz, NULL, 0, sinfo, sinfoSz, out, outSz );
+
+  return Napi::Number::New( env, ret );
+}
+
+// copies the first len bytes of a js buffer, the job outlives the call,
+// returns false without copying when value is not a buffer or is shorter
+// than len
+static bool kdf_copy( Napi::Value value, Napi::Value len_val, std::vector<uint8_t>& out )
+{
+  if ( !value.IsTypedArray() || !len_val.IsNumber() )
+  {
+    return false;
+  }
+
+  int64_t len = len_val.As<Napi::Number>().Int64Value();
+  Napi::TypedArray arr = value.As<Napi::TypedArray>();
+
+  if ( len < 0 || (size_t)len > arr.ByteLength() )
+  {
+    return false;
+  }
+
+  uint8_t* data = value.As<Napi::Uint8Array>().Data();
+
+  out.assign( data, data + len );
+
+  return true;
+}
+
+class kdf_job : public wolfcrypt_pool_job
+{
+  public:
+    kdf_job( Napi::Env env, Napi::Function& callback, int op, int type, std::vector<uint8_t> key,
+      std::vector<uint8_t> salt, std::vector<uint8_t> kdf_info, word32 outSz )
+      : wolfcrypt_pool_job( env, callback ), op( op ), type( type ), key( key ), salt( salt ),
+        kdf_info( kdf_info ), out( outSz ), ret( 0 )
+    {
+    }
+
+    ~kdf_job()
+    {
+      memset( key.data(), 0, key.size() );
+      memset( out.data(), 0, out.size() );
+    }
+
+    void execute()
+    {
+      ret = kdf_run( op, type, key.data(), key.size(), salt.data(), salt.size(), kdf_info.data(), kdf_info.size(),
+        out.data(), out.size() );
+    }
+
+    void complete( Napi::Env env, Napi::Function callback )
+    {
+      if ( ret != 0 )
+      {
+        callback.Call( { env.Undefined(), Napi::Number::New( env, ret ) } );
+
+        return;
+      }
+
+      callback.Call( { env.Undefined(), Napi::Number::New( env, ret ), Napi::Buffer<uint8_t>::Copy( env, out.data(), out.size() ) } );
+    }
+
+  private:
+    int op;
+    int type;
+    std::vector<uint8_t> key;
+    std::vector<uint8_t> salt;
+    std::vector<uint8_t> kdf_info;
+    std::vector<uint8_t> out;
+    int ret;
+};
+
+// the async forms take the arguments of the sync ones minus the output buffer
+// plus a callback, they run on the wolfcrypt thread pool and cb gets
+// ( undefined, ret, out ), or BAD_FUNC_ARG when an input is not a buffer of
+// at least its given length
+
+// wc_HKDF_async( type, inKey, inKeySz, salt, saltSz, info, infoSz, outSz, cb )
+void bind_wc_HKDF_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int type = info[0].As<Napi::Number>().Int32Value();
+  std::vector<uint8_t> inKey;
+  std::vector<uint8_t> salt;
+  std::vector<uint8_t> kdfInfo;
+  word32 outSz = info[7].As<Napi::Number>().Uint32Value();
+  Napi::Function callback = info[8].As<Napi::Function>();
+  bool ok = kdf_copy( info[1], info[2], inKey ) && kdf_copy( info[3], info[4], salt ) && kdf_copy( info[5], info[6], kdfInfo );
+
+  if ( !ok )
+  {
+    // an input copied before the bad one may be the key
+    memset( inKey.data(), 0, inKey.size() );
+    callback.Call( { env.Undefined(), Napi::Number::New( env, BAD_FUNC_ARG ) } );
+
+    return;
+  }
+
+  wolfcrypt_pool_queue( std::make_shared<kdf_job>( env, callback, KDF_HKDF, type, inKey, salt, kdfInfo, outSz ) );
+}
+
+// wc_HKDF_Extract_async( type, salt, saltSz, inKey, inKeySz, cb )
+void bind_wc_HKDF_Extract_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int type = info[0].As<Napi::Number>().Int32Value();
+  std::vector<uint8_t> salt;
+  std::vector<uint8_t> inKey;
+  Napi::Function callback = info[5].As<Napi::Function>();
+  int outSz = wc_HmacSizeByType( type );
+  bool ok = kdf_copy( info[1], info[2], salt ) && kdf_copy( info[3], info[4], inKey );
+
+  if ( !ok )
+  {
+    // an input copied before the bad one may be the key
+    memset( inKey.data(), 0, inKey.size() );
+    callback.Call( { env.Undefined(), Napi::Number::New( env, BAD_FUNC_ARG ) } );
+
+    return;
+  }
+
+  if ( outSz <= 0 )
+  {
+    callback.Call( { env.Undefined(), Napi::Number::New( env, outSz == 0 ? BAD_FUNC_ARG : outSz ) } );
+
+    return;
+  }
+
+  wolfcrypt_pool_queue( std::make_shared<kdf_job>( env, callback, KDF_HKDF_EXTRACT, type, inKey, salt, std::vector<uint8_t>(), outSz ) );
+}
+
+// wc_HKDF_Expand_async( type, inKey, inKeySz, info, infoSz, outSz, cb )
+void bind_wc_HKDF_Expand_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int type = info[0].As<Napi::Number>().Int32Value();
+  std::vector<uint8_t> inKey;
+  std::vector<uint8_t> kdfInfo;
+  word32 outSz = info[5].As<Napi::Number>().Uint32Value();
+  Napi::Function callback = info[6].As<Napi::Function>();
+  bool ok = kdf_copy( info[1], info[2], inKey ) && kdf_copy( info[3], info[4], kdfInfo );
+
+  if ( !ok )
+  {
+    // an input copied before the bad one may be the key
+    memset( inKey.data(), 0, inKey.size() );
+    callback.Call( { env.Undefined(), Napi::Number::New( env, BAD_FUNC_ARG ) } );
+
+    return;
+  }
+
+  wolfcrypt_pool_queue( std::make_shared<kdf_job>( env, callback, KDF_HKDF_EXPAND, type, inKey, std::vector<uint8_t>(), kdfInfo, outSz ) );
+}
+
+// wc_X963_KDF_async( type, secret, secretSz, sinfo, sinfoSz, outSz, cb )
+void bind_wc_X963_KDF_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int type = info[0].As<Napi::Number>().Int32Value();
+  std::vector<uint8_t> secret;
+  std::vector<uint8_t> sinfo;
+  word32 outSz = info[5].As<Napi::Number>().Uint32Value();
+  Napi::Function callback = info[6].As<Napi::Function>();
+  bool ok = kdf_copy( info[1], info[2], secret ) && kdf_copy( info[3], info[4], sinfo );
+
+  if ( !ok )
+  {
+    // an input copied before the bad one may be the key
+    memset( secret.data(), 0, secret.size() );
+    callback.Call( { env.Undefined(), Napi::Number::New( env, BAD_FUNC_ARG ) } );
+
+    return;
+  }
+
+  wolfcrypt_pool_queue( std::make_shared<kdf_job>( env, callback, KDF_X963, type, secret, std::vector<uint8_t>(), sinfo, outSz ) );
+}
+
+// one packed batch input, count + 1 offsets into data
+typedef struct kdf_packed
+{
+  std::vector<uint8_t> data;
+  std::vector<uint32_t> offsets;
+} kdf_packed;
+
+// copies a packed input and checks its offsets, a missing input such as the
+// salt of the X9.63 kdf is passed as null and becomes count empty items
+static bool kdf_pack( Napi::Value data_val, Napi::Value offsets_val, size_t count, kdf_packed& packed )
+{
+  if ( data_val.IsNull() || data_val.IsUndefined() )
+  {
+    packed.offsets.assign( count + 1, 0 );
+
+    return true;
+  }
+
+  Napi::Uint8Array data = data_val.As<Napi::Uint8Array>();
+  Napi::Uint32Array offsets = offsets_val.As<Napi::Uint32Array>();
+
+  if ( offsets.ElementLength() != count + 1 || offsets[count] > data.ByteLength() )
+  {
+    return false;
+  }
+
+  for ( size_t i = 0; i < count; i++ )
+  {
+    if ( offsets[i] > offsets[i + 1] )
+    {
+      return false;
+    }
+  }
+
+  packed.data.assign( data.Data(), data.Data() + data.ByteLength() );
+  packed.offsets.assign( offsets.Data(), offsets.Data() + offsets.ElementLength() );
+
+  return true;
+}
+
+// derives count keys of outSz bytes into one packed output
+class kdf_batch : public wolfcrypt_pool_batch
+{
+  public:
+    kdf_batch( size_t count, int op, int type, word32 outSz )
+      : wolfcrypt_pool_batch( count ), op( op ), type( type ), outSz( outSz ), out( count * outSz )
+    {
+    }
+
+    ~kdf_batch()
+    {
+      memset( keys.data.data(), 0, keys.data.size() );
+      memset( out.data(), 0, out.size() );
+    }
+
+    int run( size_t index ) override
+    {
+      return kdf_run( op, type,
+        keys.data.data() + keys.offsets[index], keys.offsets[index + 1] - keys.offsets[index],
+        salts.data.data() + salts.offsets[index], salts.offsets[index + 1] - salts.offsets[index],
+        infos.data.data() + infos.offsets[index], infos.offsets[index + 1] - infos.offsets[index],
+        out.data() + index * outSz, outSz );
+    }
+
+    Napi::Value result( Napi::Env env ) override
+    {
+      return Napi::Buffer<uint8_t>::Copy( env, out.data(), out.size() );
+    }
+
+    kdf_packed keys;
+    kdf_packed salts;
+    kdf_packed infos;
+
+  private:
+    int op;
+    int type;
+    word32 outSz;
+    std::vector<uint8_t> out;
+};
+
+static void kdf_batch_queue( Napi::Env env, int op, int type, Napi::Value keys, Napi::Value keyOffsets,
+  Napi::Value salts, Napi::Value saltOffsets, Napi::Value infos, Napi::Value infoOffsets, word32 outSz,
+  Napi::Value progress, Napi::Function callback )
+{
+  size_t count = keyOffsets.As<Napi::Uint32Array>().ElementLength();
+  std::shared_ptr<kdf_batch> batch;
+
+  if ( count == 0 || outSz == 0 )
+  {
+    callback.Call( { env.Undefined(), Napi::Number::New( env, BAD_FUNC_ARG ) } );
+
+    return;
+  }
+
+  count--;
+  batch = std::make_shared<kdf_batch>( count, op, type, outSz );
+
+  if ( !kdf_pack( keys, keyOffsets, count, batch->keys ) || !kdf_pack( salts, saltOffsets, count, batch->salts ) ||
+    !kdf_pack( infos, infoOffsets, count, batch->infos ) )
+  {
+    callback.Call( { env.Undefined(), Napi::Number::New( env, BAD_FUNC_ARG ) } );
+
+    return;
+  }
+
+  wolfcrypt_pool_batch_queue( env, batch, callback, progress );
+}
+
+// wc_HKDF_batch( type, keys, keyOffsets, salts, saltOffsets, infos, infoOffsets, outSz, progress, cb )
+// every input is packed with count + 1 offsets, salts and infos may be null
+void bind_wc_HKDF_batch(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int type = info[0].As<Napi::Number>().Int32Value();
+  word32 outSz = info[7].As<Napi::Number>().Uint32Value();
+  Napi::Function callback = info[9].As<Napi::Function>();
+
+  kdf_batch_queue( env, KDF_HKDF, type, info[1], info[2], info[3], info[4], info[5], info[6], outSz, info[8], callback );
+}
+
+// wc_X963_KDF_batch( type, secrets, secretOffsets, sinfos, sinfoOffsets, outSz, progress, cb )
+void bind_wc_X963_KDF_batch(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int type = info[0].As<Napi::Number>().Int32Value();
+  word32 outSz = info[5].As<Napi::Number>().Uint32Value();
+  Napi::Function callback = info[7].As<Napi::Function>();
+
+  kdf_batch_queue( env, KDF_X963, type, info[1], info[2], env.Null(), env.Null(), info[3], info[4], outSz, info[6], callback );
+}
@@ -0,0 +1,61 @@
+/* key_cache.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/key_cache.h"
+#include "./h/rsa.h"
+#include "./h/ecc.h"
+
+// nodejsKeyCacheStats() returns { rsa, ecc }, each { size, limit, hits,
+// misses, evictions, copies }
+Napi::Value nodejsKeyCacheStats(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Object result = Napi::Object::New( env );
+
+  result.Set( "rsa", wolfcrypt_rsa_key_cache().stats( env ) );
+  result.Set( "ecc", wolfcrypt_ecc_key_cache().stats( env ) );
+
+  return result;
+}
+
+// nodejsKeyCacheLimit( [limit] ) sets how many keys of each type are cached,
+// evicting the least recently used ones over it, and returns the old limit
+Napi::Value nodejsKeyCacheLimit(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  size_t limit = wolfcrypt_rsa_key_cache().get_limit();
+
+  if ( info.Length() > 0 && info[0].IsNumber() )
+  {
+    int64_t value = info[0].As<Napi::Number>().Int64Value();
+
+    wolfcrypt_rsa_key_cache().set_limit( value > 0 ? value : 0 );
+    wolfcrypt_ecc_key_cache().set_limit( value > 0 ? value : 0 );
+  }
+
+  return Napi::Number::New( env, (double)limit );
+}
+
+// drops every cached key, handles still in use keep theirs
+void nodejsKeyCacheClear(const Napi::CallbackInfo& info)
+{
+  wolfcrypt_rsa_key_cache().clear();
+  wolfcrypt_ecc_key_cache().clear();
+}
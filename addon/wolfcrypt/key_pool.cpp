@@ -0,0 +1,533 @@
+/* key_pool.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/key_pool.h"
+#include <algorithm>
+#include <map>
+#include <deque>
+#include <tuple>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+// key generation, above all for 3072 and 4096 bit rsa, is slow and its time
+// varies a lot from one key to the next, so keys can be made ahead of time
+// and kept in a bucket per type, size and exponent. A scheduler thread queues
+// refills on the wolfcrypt thread pool while a bucket is below its depth, at
+// most threads of them at once and at most rate of them per second. The pool
+// queue is shared and first in first out, so across all buckets at most one
+// less refill than the pool has threads is queued at a time, a pbkdf2 or
+// other job queued behind them always finds a free thread. Taking a key is a
+// lock and a pop, and the key is handed to js as an ordinary native handle
+
+#define KEY_POOL_RSA 0
+#define KEY_POOL_ECC 1
+
+typedef std::chrono::steady_clock key_pool_clock;
+
+typedef struct key_pool_bucket
+{
+  int type;
+  int size;
+  long e;
+  size_t depth;
+  // refills started per second, 0 for no limit
+  double rate;
+  size_t threads;
+  // keys ready to hand out, allocated with wolfcrypt_pool_alloc
+  std::deque<void*> keys;
+  size_t refilling;
+  key_pool_clock::time_point next_refill;
+  // the last refill error, refills stop until the bucket is configured again
+  int error;
+  bool removed;
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t refills;
+  uint64_t failures;
+  uint64_t refill_ns;
+  uint64_t refill_max_ns;
+} key_pool_bucket;
+
+typedef std::tuple<int, int, long> key_pool_id;
+
+typedef struct key_pool
+{
+  std::mutex lock;
+  std::condition_variable wake;
+  std::map<key_pool_id, std::shared_ptr<key_pool_bucket>> buckets;
+  bool scheduler;
+} key_pool;
+
+// never destroyed, like the thread pool, the scheduler thread is detached and
+// may still be waiting on it while the process exits
+static key_pool* key_pool_get()
+{
+  static key_pool* pool = NULL;
+  static std::once_flag once;
+
+  std::call_once( once, []() {
+    pool = new key_pool();
+    pool->scheduler = false;
+  } );
+
+  return pool;
+}
+
+static int key_pool_native_type( int type )
+{
+  return type == KEY_POOL_RSA ? NATIVE_RSA : NATIVE_ECC;
+}
+
+static size_t key_pool_key_size( int type )
+{
+  return type == KEY_POOL_RSA ? sizeof( RsaKey ) : sizeof( ecc_key );
+}
+
+static void key_pool_free_key( int type, void* key )
+{
+  if ( type == KEY_POOL_RSA )
+  {
+    wc_FreeRsaKey( (RsaKey*)key );
+  }
+  else
+  {
+    wc_ecc_free( (ecc_key*)key );
+  }
+
+  wolfcrypt_pool_release( key_pool_native_type( type ), key, key_pool_key_size( type ) );
+}
+
+static void key_pool_free_keys( int type, std::vector<void*>& keys )
+{
+  for ( void* key : keys )
+  {
+    key_pool_free_key( type, key );
+  }
+}
+
+// runs on a pool thread, nothing else can see the key yet so it is not locked
+static int key_pool_make_key( int type, int size, long e, void** out )
+{
+  int ret;
+  void* key = wolfcrypt_pool_alloc( key_pool_native_type( type ), key_pool_key_size( type ) );
+
+  if ( key == NULL )
+  {
+    return MEMORY_E;
+  }
+
+  if ( type == KEY_POOL_RSA )
+  {
+    RsaKey* rsa = (RsaKey*)key;
+
+    ret = wc_InitRsaKey( rsa, NULL );
+
+    if ( ret == 0 )
+    {
+      ret = wc_MakeRsaKey( rsa, size, e, wolfcrypt_thread_rng() );
+    }
+  }
+  else
+  {
+    ecc_key* ecc = (ecc_key*)key;
+
+    ret = wc_ecc_init( ecc );
+
+    if ( ret == 0 )
+    {
+      ecc->rng = wolfcrypt_thread_rng();
+      ret = wc_ecc_make_key( ecc->rng, size, ecc );
+    }
+
+    // the rng belongs to this thread, the operations set their own
+    ecc->rng = NULL;
+  }
+
+  // the wolfcrypt free functions accept the zeroed struct of a failed init
+  if ( ret != 0 )
+  {
+    key_pool_free_key( type, key );
+
+    return ret;
+  }
+
+  *out = key;
+
+  return 0;
+}
+
+class key_pool_refill_job : public wolfcrypt_pool_job
+{
+  public:
+    key_pool_refill_job( std::shared_ptr<key_pool_bucket> bucket )
+      : bucket( bucket )
+    {
+    }
+
+    void execute()
+    {
+      key_pool* pool = key_pool_get();
+      key_pool_clock::time_point start = key_pool_clock::now();
+      void* key = NULL;
+      int ret = key_pool_make_key( bucket->type, bucket->size, bucket->e, &key );
+      uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>( key_pool_clock::now() - start ).count();
+
+      {
+        std::lock_guard<std::mutex> guard( pool->lock );
+
+        bucket->refilling--;
+
+        if ( ret != 0 )
+        {
+          bucket->failures++;
+          bucket->error = ret;
+        }
+        else if ( !bucket->removed && bucket->keys.size() < bucket->depth )
+        {
+          bucket->keys.push_back( key );
+          bucket->refills++;
+          bucket->refill_ns += ns;
+
+          if ( ns > bucket->refill_max_ns )
+          {
+            bucket->refill_max_ns = ns;
+          }
+
+          key = NULL;
+        }
+
+        pool->wake.notify_one();
+      }
+
+      // the bucket was removed or shrunk while the key was being made
+      if ( key != NULL )
+      {
+        key_pool_free_key( bucket->type, key );
+      }
+    }
+
+    void complete( Napi::Env env, Napi::Function callback )
+    {
+    }
+
+  private:
+    std::shared_ptr<key_pool_bucket> bucket;
+};
+
+static void key_pool_scheduler( key_pool* pool )
+{
+  std::unique_lock<std::mutex> guard( pool->lock );
+
+  while ( true )
+  {
+    std::vector<std::shared_ptr<key_pool_bucket>> ready;
+    key_pool_clock::time_point now = key_pool_clock::now();
+    key_pool_clock::time_point wake = key_pool_clock::time_point::max();
+    size_t refilling = 0;
+
+    // the thread pool takes its own lock, and can be resized at any time
+    guard.unlock();
+    size_t pool_size = wolfcrypt_pool_size();
+    guard.lock();
+
+    size_t limit = pool_size > 1 ? pool_size - 1 : 1;
+
+    for ( auto& it : pool->buckets )
+    {
+      refilling += it.second->refilling;
+    }
+
+    for ( auto& it : pool->buckets )
+    {
+      key_pool_bucket* bucket = it.second.get();
+
+      while ( bucket->error == 0 && bucket->refilling < bucket->threads && refilling < limit &&
+        bucket->keys.size() + bucket->refilling < bucket->depth )
+      {
+        if ( bucket->rate > 0 )
+        {
+          if ( now < bucket->next_refill )
+          {
+            wake = std::min( wake, bucket->next_refill );
+
+            break;
+          }
+
+          // an idle bucket does not save up refills for later
+          bucket->next_refill = std::max( now, bucket->next_refill ) +
+            std::chrono::duration_cast<key_pool_clock::duration>( std::chrono::duration<double>( 1.0 / bucket->rate ) );
+        }
+
+        bucket->refilling++;
+        refilling++;
+        ready.push_back( it.second );
+      }
+    }
+
+    // the thread pool takes its own lock
+    if ( !ready.empty() )
+    {
+      guard.unlock();
+
+      for ( std::shared_ptr<key_pool_bucket>& bucket : ready )
+      {
+        wolfcrypt_pool_queue( std::make_shared<key_pool_refill_job>( bucket ) );
+      }
+
+      guard.lock();
+
+      continue;
+    }
+
+    if ( wake == key_pool_clock::time_point::max() )
+    {
+      pool->wake.wait( guard );
+    }
+    else
+    {
+      pool->wake.wait_until( guard, wake );
+    }
+  }
+}
+
+static int key_pool_type( const Napi::Value& value )
+{
+  std::string type = value.As<Napi::String>().Utf8Value();
+
+  if ( type == "rsa" )
+  {
+    return KEY_POOL_RSA;
+  }
+
+  if ( type == "ecc" )
+  {
+    return KEY_POOL_ECC;
+  }
+
+  return -1;
+}
+
+// nodejsKeyPoolConfigure( type, size, e, depth, rate, threads ) keeps depth
+// keys of type "rsa" or "ecc" ready, e is ignored for ecc, refills are
+// limited to threads at a time and rate per second unless rate is 0, and all
+// buckets together never use more than all but one pool thread, a depth
+// of 0 removes the bucket and frees its keys, returns 0 or an error code
+Napi::Number nodejsKeyPoolConfigure(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  key_pool* pool = key_pool_get();
+  int type = key_pool_type( info[0] );
+  int size = info[1].As<Napi::Number>().Int32Value();
+  long e = info[2].As<Napi::Number>().Int64Value();
+  int64_t depth = info[3].As<Napi::Number>().Int64Value();
+  double rate = info[4].As<Napi::Number>().DoubleValue();
+  int64_t threads = info[5].As<Napi::Number>().Int64Value();
+  std::vector<void*> trimmed;
+
+  if ( type < 0 || size <= 0 || depth < 0 || rate < 0 || threads < 1 )
+  {
+    return Napi::Number::New( env, BAD_FUNC_ARG );
+  }
+
+  if ( type == KEY_POOL_ECC )
+  {
+    e = 0;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard( pool->lock );
+    key_pool_id id( type, size, e );
+    auto it = pool->buckets.find( id );
+
+    if ( depth == 0 )
+    {
+      if ( it != pool->buckets.end() )
+      {
+        trimmed.assign( it->second->keys.begin(), it->second->keys.end() );
+        it->second->keys.clear();
+        it->second->removed = true;
+        pool->buckets.erase( it );
+      }
+    }
+    else
+    {
+      std::shared_ptr<key_pool_bucket> bucket;
+
+      if ( it == pool->buckets.end() )
+      {
+        bucket = std::make_shared<key_pool_bucket>();
+        bucket->type = type;
+        bucket->size = size;
+        bucket->e = e;
+        bucket->refilling = 0;
+        bucket->removed = false;
+        bucket->hits = bucket->misses = bucket->refills = bucket->failures = 0;
+        bucket->refill_ns = bucket->refill_max_ns = 0;
+        pool->buckets[id] = bucket;
+      }
+      else
+      {
+        bucket = it->second;
+      }
+
+      bucket->depth = depth;
+      bucket->rate = rate;
+      bucket->threads = threads;
+      bucket->error = 0;
+
+      while ( bucket->keys.size() > bucket->depth )
+      {
+        trimmed.push_back( bucket->keys.back() );
+        bucket->keys.pop_back();
+      }
+    }
+
+    if ( !pool->scheduler )
+    {
+      std::thread( key_pool_scheduler, pool ).detach();
+      pool->scheduler = true;
+    }
+
+    pool->wake.notify_one();
+  }
+
+  key_pool_free_keys( type, trimmed );
+
+  return Napi::Number::New( env, 0 );
+}
+
+// a ready key from the bucket as a handle, or null when the bucket is empty
+// or not configured, in which case the caller makes the key itself
+static Napi::Value key_pool_take( Napi::Env env, int type, int size, long e )
+{
+  key_pool* pool = key_pool_get();
+  void* key = NULL;
+
+  {
+    std::lock_guard<std::mutex> guard( pool->lock );
+    auto it = pool->buckets.find( key_pool_id( type, size, e ) );
+
+    if ( it == pool->buckets.end() )
+    {
+      return env.Null();
+    }
+
+    key_pool_bucket* bucket = it->second.get();
+
+    if ( bucket->keys.empty() )
+    {
+      bucket->misses++;
+
+      return env.Null();
+    }
+
+    key = bucket->keys.front();
+    bucket->keys.pop_front();
+    bucket->hits++;
+    pool->wake.notify_one();
+  }
+
+  return wolfcrypt_native_handle_adopt( env, key_pool_native_type( type ), key, key_pool_key_size( type ) );
+}
+
+// nodejsRsaKeyPooled( size, e )
+Napi::Value nodejsRsaKeyPooled(const Napi::CallbackInfo& info)
+{
+  int size = info[0].As<Napi::Number>().Int32Value();
+  long e = info[1].As<Napi::Number>().Int64Value();
+
+  return key_pool_take( info.Env(), KEY_POOL_RSA, size, e );
+}
+
+// nodejsEccKeyPooled( size ), size is in bytes like for wc_ecc_make_key
+Napi::Value nodejsEccKeyPooled(const Napi::CallbackInfo& info)
+{
+  int size = info[0].As<Napi::Number>().Int32Value();
+
+  return key_pool_take( info.Env(), KEY_POOL_ECC, size, 0 );
+}
+
+// nodejsKeyPoolStats() returns an array with { type, size, e, depth, ready,
+// refilling, rate, threads, hits, misses, refills, failures, error,
+// refillMs, refillMaxMs } for every bucket, refillMs is the average time a
+// refill took
+Napi::Value nodejsKeyPoolStats(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  key_pool* pool = key_pool_get();
+  std::lock_guard<std::mutex> guard( pool->lock );
+  Napi::Array result = Napi::Array::New( env, pool->buckets.size() );
+  uint32_t i = 0;
+
+  for ( auto& it : pool->buckets )
+  {
+    key_pool_bucket* bucket = it.second.get();
+    Napi::Object stats = Napi::Object::New( env );
+
+    stats.Set( "type", Napi::String::New( env, bucket->type == KEY_POOL_RSA ? "rsa" : "ecc" ) );
+    stats.Set( "size", Napi::Number::New( env, bucket->size ) );
+    stats.Set( "e", Napi::Number::New( env, (double)bucket->e ) );
+    stats.Set( "depth", Napi::Number::New( env, (double)bucket->depth ) );
+    stats.Set( "ready", Napi::Number::New( env, (double)bucket->keys.size() ) );
+    stats.Set( "refilling", Napi::Number::New( env, (double)bucket->refilling ) );
+    stats.Set( "rate", Napi::Number::New( env, bucket->rate ) );
+    stats.Set( "threads", Napi::Number::New( env, (double)bucket->threads ) );
+    stats.Set( "hits", Napi::Number::New( env, (double)bucket->hits ) );
+    stats.Set( "misses", Napi::Number::New( env, (double)bucket->misses ) );
+    stats.Set( "refills", Napi::Number::New( env, (double)bucket->refills ) );
+    stats.Set( "failures", Napi::Number::New( env, (double)bucket->failures ) );
+    stats.Set( "error", Napi::Number::New( env, bucket->error ) );
+    stats.Set( "refillMs", Napi::Number::New( env, bucket->refills > 0 ? bucket->refill_ns / 1e6 / bucket->refills : 0 ) );
+    stats.Set( "refillMaxMs", Napi::Number::New( env, bucket->refill_max_ns / 1e6 ) );
+
+    result.Set( i++, stats );
+  }
+
+  return result;
+}
+
+// removes every bucket and frees the ready keys, refills still running free
+// their key when they finish
+void nodejsKeyPoolClear(const Napi::CallbackInfo& info)
+{
+  key_pool* pool = key_pool_get();
+  std::vector<void*> keys[2];
+
+  {
+    std::lock_guard<std::mutex> guard( pool->lock );
+
+    for ( auto& it : pool->buckets )
+    {
+      key_pool_bucket* bucket = it.second.get();
+
+      keys[bucket->type].insert( keys[bucket->type].end(), bucket->keys.begin(), bucket->keys.end() );
+      bucket->keys.clear();
+      bucket->removed = true;
+    }
+
+    pool->buckets.clear();
+  }
+
+  key_pool_free_keys( KEY_POOL_RSA, keys[KEY_POOL_RSA] );
+  key_pool_free_keys( KEY_POOL_ECC, keys[KEY_POOL_ECC] );
+}
@@ -26,10 +26,18 @@
 #include "./h/rsa.h"
 #include "./h/sha.h"
 #include "./h/ecc.h"
+#include "./h/ed25519.h"
+#include "./h/curve25519.h"
 #include "./h/pbkdf2.h"
+#include "./h/kdf.h"
 #include "./h/pkcs7.h"
 #include "./h/pkcs12.h"
 #include "./h/random.h"
+#include "./h/native.h"
+#include "./h/key_pool.h"
+#include "./h/bench.h"
+#include "./h/stats.h"
+#include "./h/watchdog.h"
 
 using namespace Napi;
 
@@ -56,130 +64,269 @@ Napi::Object Init(Napi::Env env, Napi::Object exports)
     wolfCrypt_SetCb_fips(myFipsCb);
 #endif
 
-  exports.Set(Napi::String::New(env, "EVP_CIPHER_CTX_new"), Napi::Function::New(env, bind_EVP_CIPHER_CTX_new));
-  exports.Set(Napi::String::New(env, "EVP_CipherInit"), Napi::Function::New(env, bind_EVP_CipherInit));
-  exports.Set(Napi::String::New(env, "EVP_CipherUpdate"), Napi::Function::New(env, bind_EVP_CipherUpdate));
-  exports.Set(Napi::String::New(env, "EVP_CipherFinal"), Napi::Function::New(env, bind_EVP_CipherFinal));
-  exports.Set(Napi::String::New(env, "EVP_CIPHER_CTX_free"), Napi::Function::New(env, bind_EVP_CIPHER_CTX_free));
-
-  exports.Set(Napi::String::New(env, "sizeof_Hmac"), Napi::Function::New(env, sizeof_Hmac));
-  exports.Set(Napi::String::New(env, "typeof_Hmac"), Napi::Function::New(env, typeof_Hmac));
-  exports.Set(Napi::String::New(env, "Hmac_digest_length"), Napi::Function::New(env, Hmac_digest_length));
-  exports.Set(Napi::String::New(env, "wc_HmacSetKey"), Napi::Function::New(env, bind_wc_HmacSetKey));
-  exports.Set(Napi::String::New(env, "wc_HmacUpdate"), Napi::Function::New(env, bind_wc_HmacUpdate));
-  exports.Set(Napi::String::New(env, "wc_HmacFinal"), Napi::Function::New(env, bind_wc_HmacFinal));
-  exports.Set(Napi::String::New(env, "wc_HmacFree"), Napi::Function::New(env, bind_wc_HmacFree));
-
-  exports.Set(Napi::String::New(env, "sizeof_RsaKey"), Napi::Function::New(env, sizeof_RsaKey));
-  exports.Set(Napi::String::New(env, "wc_RsaEncryptSize"), Napi::Function::New(env, bind_wc_RsaEncryptSize));
-  exports.Set(Napi::String::New(env, "wc_InitRsaKey"), Napi::Function::New(env, bind_wc_InitRsaKey));
-  exports.Set(Napi::String::New(env, "wc_MakeRsaKey"), Napi::Function::New(env, bind_wc_MakeRsaKey));
-  exports.Set(Napi::String::New(env, "wc_MakeRsaKey_async"), Napi::Function::New(env, wc_MakeRsaKey_async));
-  exports.Set(Napi::String::New(env, "RsaPrivateDerSize"), Napi::Function::New(env, RsaPrivateDerSize));
-  exports.Set(Napi::String::New(env, "wc_RsaKeyToDer"), Napi::Function::New(env, bind_wc_RsaKeyToDer));
-  exports.Set(Napi::String::New(env, "RsaPublicDerSize"), Napi::Function::New(env, RsaPublicDerSize));
-  exports.Set(Napi::String::New(env, "wc_RsaKeyToPublicDer"), Napi::Function::New(env, bind_wc_RsaKeyToPublicDer));
-  exports.Set(Napi::String::New(env, "wc_RsaPrivateKeyDecode"), Napi::Function::New(env, bind_wc_RsaPrivateKeyDecode));
-  exports.Set(Napi::String::New(env, "wc_RsaPublicKeyDecode"), Napi::Function::New(env, bind_wc_RsaPublicKeyDecode));
-  exports.Set(Napi::String::New(env, "wc_RsaPublicEncrypt"), Napi::Function::New(env, bind_wc_RsaPublicEncrypt));
-  exports.Set(Napi::String::New(env, "wc_RsaPrivateDecrypt"), Napi::Function::New(env, bind_wc_RsaPrivateDecrypt));
-  exports.Set(Napi::String::New(env, "wc_RsaSSL_Sign"), Napi::Function::New(env, bind_wc_RsaSSL_Sign));
-  exports.Set(Napi::String::New(env, "wc_RsaSSL_Verify"), Napi::Function::New(env, bind_wc_RsaSSL_Verify));
-  exports.Set(Napi::String::New(env, "wc_FreeRsaKey"), Napi::Function::New(env, bind_wc_FreeRsaKey));
-
-  exports.Set(Napi::String::New(env, "Sha_digest_length"), Napi::Function::New(env, Sha_digest_length));
-
-  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA_CTX"), Napi::Function::New(env, sizeof_WOLFSSL_SHA_CTX));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA_Init"), Napi::Function::New(env, bind_wolfSSL_SHA_Init));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA_Update"), Napi::Function::New(env, bind_wolfSSL_SHA_Update));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA_Final"), Napi::Function::New(env, bind_wolfSSL_SHA_Final));
-
-  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA224_CTX"), Napi::Function::New(env, sizeof_WOLFSSL_SHA224_CTX));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA224_Init"), Napi::Function::New(env, bind_wolfSSL_SHA224_Init));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA224_Update"), Napi::Function::New(env, bind_wolfSSL_SHA224_Update));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA224_Final"), Napi::Function::New(env, bind_wolfSSL_SHA224_Final));
-
-  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA256_CTX"), Napi::Function::New(env, sizeof_WOLFSSL_SHA256_CTX));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA256_Init"), Napi::Function::New(env, bind_wolfSSL_SHA256_Init));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA256_Update"), Napi::Function::New(env, bind_wolfSSL_SHA256_Update));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA256_Final"), Napi::Function::New(env, bind_wolfSSL_SHA256_Final));
-
-  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA384_CTX"), Napi::Function::New(env, sizeof_WOLFSSL_SHA384_CTX));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA384_Init"), Napi::Function::New(env, bind_wolfSSL_SHA384_Init));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA384_Update"), Napi::Function::New(env, bind_wolfSSL_SHA384_Update));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA384_Final"), Napi::Function::New(env, bind_wolfSSL_SHA384_Final));
-
-  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA512_CTX"), Napi::Function::New(env, sizeof_WOLFSSL_SHA512_CTX));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_Init"), Napi::Function::New(env, bind_wolfSSL_SHA512_Init));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_Update"), Napi::Function::New(env, bind_wolfSSL_SHA512_Update));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_Final"), Napi::Function::New(env, bind_wolfSSL_SHA512_Final));
+  exports.Set(Napi::String::New(env, "EVP_CIPHER_CTX_new"), wolfcrypt_stats_function<bind_EVP_CIPHER_CTX_new>(env, "EVP_CIPHER_CTX_new"));
+  exports.Set(Napi::String::New(env, "EVP_CipherInit"), wolfcrypt_stats_function<bind_EVP_CipherInit>(env, "EVP_CipherInit"));
+  exports.Set(Napi::String::New(env, "EVP_CIPHER_CTX_set_iv_length"), wolfcrypt_stats_function<bind_EVP_CIPHER_CTX_set_iv_length>(env, "EVP_CIPHER_CTX_set_iv_length"));
+  exports.Set(Napi::String::New(env, "EVP_CipherUpdateAAD"), wolfcrypt_stats_function<bind_EVP_CipherUpdateAAD>(env, "EVP_CipherUpdateAAD", 2));
+  exports.Set(Napi::String::New(env, "EVP_CIPHER_CTX_get_tag"), wolfcrypt_stats_function<bind_EVP_CIPHER_CTX_get_tag>(env, "EVP_CIPHER_CTX_get_tag"));
+  exports.Set(Napi::String::New(env, "EVP_CIPHER_CTX_set_tag"), wolfcrypt_stats_function<bind_EVP_CIPHER_CTX_set_tag>(env, "EVP_CIPHER_CTX_set_tag"));
+  exports.Set(Napi::String::New(env, "EVP_CipherUpdate"), wolfcrypt_stats_function<bind_EVP_CipherUpdate>(env, "EVP_CipherUpdate", 3));
+  exports.Set(Napi::String::New(env, "EVP_CipherUpdate_async"), wolfcrypt_stats_function<EVP_CipherUpdate_async>(env, "EVP_CipherUpdate_async", 3));
+  exports.Set(Napi::String::New(env, "EVP_CipherFinal"), wolfcrypt_stats_function<bind_EVP_CipherFinal>(env, "EVP_CipherFinal"));
+  exports.Set(Napi::String::New(env, "EVP_CIPHER_CTX_block_size"), wolfcrypt_stats_function<bind_EVP_CIPHER_CTX_block_size>(env, "EVP_CIPHER_CTX_block_size"));
+  exports.Set(Napi::String::New(env, "EVP_CIPHER_CTX_free"), wolfcrypt_stats_function<bind_EVP_CIPHER_CTX_free>(env, "EVP_CIPHER_CTX_free"));
+
+  exports.Set(Napi::String::New(env, "sizeof_Hmac"), wolfcrypt_stats_function<sizeof_Hmac>(env, "sizeof_Hmac"));
+  exports.Set(Napi::String::New(env, "typeof_Hmac"), wolfcrypt_stats_function<typeof_Hmac>(env, "typeof_Hmac"));
+  exports.Set(Napi::String::New(env, "Hmac_digest_length"), wolfcrypt_stats_function<Hmac_digest_length>(env, "Hmac_digest_length"));
+  exports.Set(Napi::String::New(env, "wc_HmacSetKey"), wolfcrypt_stats_function<bind_wc_HmacSetKey>(env, "wc_HmacSetKey"));
+  exports.Set(Napi::String::New(env, "wc_HmacUpdate"), wolfcrypt_stats_function<bind_wc_HmacUpdate>(env, "wc_HmacUpdate", 2));
+  exports.Set(Napi::String::New(env, "wc_HmacFinal"), wolfcrypt_stats_function<bind_wc_HmacFinal>(env, "wc_HmacFinal"));
+  exports.Set(Napi::String::New(env, "wc_HmacCopy"), wolfcrypt_stats_function<bind_wc_HmacCopy>(env, "wc_HmacCopy"));
+  exports.Set(Napi::String::New(env, "wc_HmacFree"), wolfcrypt_stats_function<bind_wc_HmacFree>(env, "wc_HmacFree"));
+
+  exports.Set(Napi::String::New(env, "sizeof_HmacKey"), wolfcrypt_stats_function<sizeof_HmacKey>(env, "sizeof_HmacKey"));
+  exports.Set(Napi::String::New(env, "nodejsHmacKeyInit"), wolfcrypt_stats_function<nodejsHmacKeyInit>(env, "nodejsHmacKeyInit"));
+  exports.Set(Napi::String::New(env, "nodejsHmacKeyReset"), wolfcrypt_stats_function<nodejsHmacKeyReset>(env, "nodejsHmacKeyReset"));
+  exports.Set(Napi::String::New(env, "nodejsHmacKeyUpdate"), wolfcrypt_stats_function<nodejsHmacKeyUpdate>(env, "nodejsHmacKeyUpdate", 2));
+  exports.Set(Napi::String::New(env, "nodejsHmacKeyFinal"), wolfcrypt_stats_function<nodejsHmacKeyFinal>(env, "nodejsHmacKeyFinal"));
+  exports.Set(Napi::String::New(env, "nodejsHmacKeyMac"), wolfcrypt_stats_function<nodejsHmacKeyMac>(env, "nodejsHmacKeyMac", 2));
+  exports.Set(Napi::String::New(env, "nodejsHmacKeyFree"), wolfcrypt_stats_function<nodejsHmacKeyFree>(env, "nodejsHmacKeyFree"));
+
+  exports.Set(Napi::String::New(env, "sizeof_RsaKey"), wolfcrypt_stats_function<sizeof_RsaKey>(env, "sizeof_RsaKey"));
+  exports.Set(Napi::String::New(env, "typeof_RsaPad"), wolfcrypt_stats_function<typeof_RsaPad>(env, "typeof_RsaPad"));
+  exports.Set(Napi::String::New(env, "typeof_RsaMgf"), wolfcrypt_stats_function<typeof_RsaMgf>(env, "typeof_RsaMgf"));
+  exports.Set(Napi::String::New(env, "wc_RsaEncryptSize"), wolfcrypt_stats_function<bind_wc_RsaEncryptSize>(env, "wc_RsaEncryptSize"));
+  exports.Set(Napi::String::New(env, "wc_InitRsaKey"), wolfcrypt_stats_function<bind_wc_InitRsaKey>(env, "wc_InitRsaKey"));
+  exports.Set(Napi::String::New(env, "wc_MakeRsaKey"), wolfcrypt_stats_function<bind_wc_MakeRsaKey>(env, "wc_MakeRsaKey"));
+  exports.Set(Napi::String::New(env, "wc_MakeRsaKey_async"), wolfcrypt_stats_function<wc_MakeRsaKey_async>(env, "wc_MakeRsaKey_async"));
+  exports.Set(Napi::String::New(env, "RsaPrivateDerSize"), wolfcrypt_stats_function<RsaPrivateDerSize>(env, "RsaPrivateDerSize"));
+  exports.Set(Napi::String::New(env, "wc_RsaKeyToDer"), wolfcrypt_stats_function<bind_wc_RsaKeyToDer>(env, "wc_RsaKeyToDer"));
+  exports.Set(Napi::String::New(env, "RsaPublicDerSize"), wolfcrypt_stats_function<RsaPublicDerSize>(env, "RsaPublicDerSize"));
+  exports.Set(Napi::String::New(env, "wc_RsaKeyToPublicDer"), wolfcrypt_stats_function<bind_wc_RsaKeyToPublicDer>(env, "wc_RsaKeyToPublicDer"));
+  exports.Set(Napi::String::New(env, "wc_RsaPrivateKeyDecode"), wolfcrypt_stats_function<bind_wc_RsaPrivateKeyDecode>(env, "wc_RsaPrivateKeyDecode"));
+  exports.Set(Napi::String::New(env, "wc_RsaPublicKeyDecode"), wolfcrypt_stats_function<bind_wc_RsaPublicKeyDecode>(env, "wc_RsaPublicKeyDecode"));
+  exports.Set(Napi::String::New(env, "nodejsRsaKeyCached"), wolfcrypt_stats_function<nodejsRsaKeyCached>(env, "nodejsRsaKeyCached"));
+  exports.Set(Napi::String::New(env, "wc_RsaPublicEncrypt"), wolfcrypt_stats_function<bind_wc_RsaPublicEncrypt>(env, "wc_RsaPublicEncrypt", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaPrivateDecrypt"), wolfcrypt_stats_function<bind_wc_RsaPrivateDecrypt>(env, "wc_RsaPrivateDecrypt", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaSSL_Sign"), wolfcrypt_stats_function<bind_wc_RsaSSL_Sign>(env, "wc_RsaSSL_Sign", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaSSL_Verify"), wolfcrypt_stats_function<bind_wc_RsaSSL_Verify>(env, "wc_RsaSSL_Verify", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaPublicEncrypt_async"), wolfcrypt_stats_function<wc_RsaPublicEncrypt_async>(env, "wc_RsaPublicEncrypt_async", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaPrivateDecrypt_async"), wolfcrypt_stats_function<wc_RsaPrivateDecrypt_async>(env, "wc_RsaPrivateDecrypt_async", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaSSL_Sign_async"), wolfcrypt_stats_function<wc_RsaSSL_Sign_async>(env, "wc_RsaSSL_Sign_async", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaSSL_Verify_async"), wolfcrypt_stats_function<wc_RsaSSL_Verify_async>(env, "wc_RsaSSL_Verify_async", 1));
+#ifndef WC_NO_RSA_OAEP
+  exports.Set(Napi::String::New(env, "wc_RsaPublicEncrypt_ex"), wolfcrypt_stats_function<bind_wc_RsaPublicEncrypt_ex>(env, "wc_RsaPublicEncrypt_ex", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaPrivateDecrypt_ex"), wolfcrypt_stats_function<bind_wc_RsaPrivateDecrypt_ex>(env, "wc_RsaPrivateDecrypt_ex", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaPublicEncrypt_ex_async"), wolfcrypt_stats_function<wc_RsaPublicEncrypt_ex_async>(env, "wc_RsaPublicEncrypt_ex_async", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaPrivateDecrypt_ex_async"), wolfcrypt_stats_function<wc_RsaPrivateDecrypt_ex_async>(env, "wc_RsaPrivateDecrypt_ex_async", 1));
+#endif
+#ifdef WC_RSA_PSS
+  exports.Set(Napi::String::New(env, "wc_RsaPSS_Sign"), wolfcrypt_stats_function<bind_wc_RsaPSS_Sign>(env, "wc_RsaPSS_Sign", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaPSS_Verify"), wolfcrypt_stats_function<bind_wc_RsaPSS_Verify>(env, "wc_RsaPSS_Verify", 1));
+  exports.Set(Napi::String::New(env, "nodejsRsaPSS_VerifyHash"), wolfcrypt_stats_function<nodejsRsaPSS_VerifyHash>(env, "nodejsRsaPSS_VerifyHash", 3));
+  exports.Set(Napi::String::New(env, "wc_RsaPSS_Sign_async"), wolfcrypt_stats_function<wc_RsaPSS_Sign_async>(env, "wc_RsaPSS_Sign_async", 1));
+  exports.Set(Napi::String::New(env, "wc_RsaPSS_Verify_async"), wolfcrypt_stats_function<wc_RsaPSS_Verify_async>(env, "wc_RsaPSS_Verify_async", 1));
+  exports.Set(Napi::String::New(env, "nodejsRsaPSS_VerifyHash_async"), wolfcrypt_stats_function<nodejsRsaPSS_VerifyHash_async>(env, "nodejsRsaPSS_VerifyHash_async", 3));
+#endif
+  exports.Set(Napi::String::New(env, "wc_FreeRsaKey"), wolfcrypt_stats_function<bind_wc_FreeRsaKey>(env, "wc_FreeRsaKey"));
+
+  exports.Set(Napi::String::New(env, "Sha_digest_length"), wolfcrypt_stats_function<Sha_digest_length>(env, "Sha_digest_length"));
+
+  exports.Set(Napi::String::New(env, "typeof_Hash"), wolfcrypt_stats_function<typeof_Hash>(env, "typeof_Hash"));
+  exports.Set(Napi::String::New(env, "wc_Hash"), wolfcrypt_stats_function<bind_wc_Hash>(env, "wc_Hash", 1));
+  exports.Set(Napi::String::New(env, "wc_HashMany"), wolfcrypt_stats_function<bind_wc_HashMany>(env, "wc_HashMany", 1));
+  exports.Set(Napi::String::New(env, "wc_HashMany_async"), wolfcrypt_stats_function<wc_HashMany_async>(env, "wc_HashMany_async", 1));
+  exports.Set(Napi::String::New(env, "nodejsShaCopy"), wolfcrypt_stats_function<nodejsShaCopy>(env, "nodejsShaCopy"));
+
+  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA_CTX"), wolfcrypt_stats_function<sizeof_WOLFSSL_SHA_CTX>(env, "sizeof_WOLFSSL_SHA_CTX"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA_Init"), wolfcrypt_stats_function<bind_wolfSSL_SHA_Init>(env, "wolfSSL_SHA_Init"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA_Update"), wolfcrypt_stats_function<bind_wolfSSL_SHA_Update>(env, "wolfSSL_SHA_Update", 2));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA_Final"), wolfcrypt_stats_function<bind_wolfSSL_SHA_Final>(env, "wolfSSL_SHA_Final"));
+
+  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA224_CTX"), wolfcrypt_stats_function<sizeof_WOLFSSL_SHA224_CTX>(env, "sizeof_WOLFSSL_SHA224_CTX"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA224_Init"), wolfcrypt_stats_function<bind_wolfSSL_SHA224_Init>(env, "wolfSSL_SHA224_Init"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA224_Update"), wolfcrypt_stats_function<bind_wolfSSL_SHA224_Update>(env, "wolfSSL_SHA224_Update", 2));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA224_Final"), wolfcrypt_stats_function<bind_wolfSSL_SHA224_Final>(env, "wolfSSL_SHA224_Final"));
+
+  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA256_CTX"), wolfcrypt_stats_function<sizeof_WOLFSSL_SHA256_CTX>(env, "sizeof_WOLFSSL_SHA256_CTX"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA256_Init"), wolfcrypt_stats_function<bind_wolfSSL_SHA256_Init>(env, "wolfSSL_SHA256_Init"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA256_Update"), wolfcrypt_stats_function<bind_wolfSSL_SHA256_Update>(env, "wolfSSL_SHA256_Update", 2));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA256_Final"), wolfcrypt_stats_function<bind_wolfSSL_SHA256_Final>(env, "wolfSSL_SHA256_Final"));
+
+  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA384_CTX"), wolfcrypt_stats_function<sizeof_WOLFSSL_SHA384_CTX>(env, "sizeof_WOLFSSL_SHA384_CTX"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA384_Init"), wolfcrypt_stats_function<bind_wolfSSL_SHA384_Init>(env, "wolfSSL_SHA384_Init"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA384_Update"), wolfcrypt_stats_function<bind_wolfSSL_SHA384_Update>(env, "wolfSSL_SHA384_Update", 2));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA384_Final"), wolfcrypt_stats_function<bind_wolfSSL_SHA384_Final>(env, "wolfSSL_SHA384_Final"));
+
+  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA512_CTX"), wolfcrypt_stats_function<sizeof_WOLFSSL_SHA512_CTX>(env, "sizeof_WOLFSSL_SHA512_CTX"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_Init"), wolfcrypt_stats_function<bind_wolfSSL_SHA512_Init>(env, "wolfSSL_SHA512_Init"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_Update"), wolfcrypt_stats_function<bind_wolfSSL_SHA512_Update>(env, "wolfSSL_SHA512_Update", 2));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_Final"), wolfcrypt_stats_function<bind_wolfSSL_SHA512_Final>(env, "wolfSSL_SHA512_Final"));
 
 #ifndef WOLFSSL_NOSHA512_224
-  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA512_224_CTX"), Napi::Function::New(env, sizeof_WOLFSSL_SHA512_224_CTX));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_224_Init"), Napi::Function::New(env, bind_wolfSSL_SHA512_224_Init));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_224_Update"), Napi::Function::New(env, bind_wolfSSL_SHA512_224_Update));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_224_Final"), Napi::Function::New(env, bind_wolfSSL_SHA512_224_Final));
+  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA512_224_CTX"), wolfcrypt_stats_function<sizeof_WOLFSSL_SHA512_224_CTX>(env, "sizeof_WOLFSSL_SHA512_224_CTX"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_224_Init"), wolfcrypt_stats_function<bind_wolfSSL_SHA512_224_Init>(env, "wolfSSL_SHA512_224_Init"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_224_Update"), wolfcrypt_stats_function<bind_wolfSSL_SHA512_224_Update>(env, "wolfSSL_SHA512_224_Update", 2));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_224_Final"), wolfcrypt_stats_function<bind_wolfSSL_SHA512_224_Final>(env, "wolfSSL_SHA512_224_Final"));
 #endif
 
 #ifndef WOLFSSL_NOSHA512_256
-  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA512_256_CTX"), Napi::Function::New(env, sizeof_WOLFSSL_SHA512_256_CTX));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_256_Init"), Napi::Function::New(env, bind_wolfSSL_SHA512_256_Init));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_256_Update"), Napi::Function::New(env, bind_wolfSSL_SHA512_256_Update));
-  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_256_Final"), Napi::Function::New(env, bind_wolfSSL_SHA512_256_Final));
+  exports.Set(Napi::String::New(env, "sizeof_WOLFSSL_SHA512_256_CTX"), wolfcrypt_stats_function<sizeof_WOLFSSL_SHA512_256_CTX>(env, "sizeof_WOLFSSL_SHA512_256_CTX"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_256_Init"), wolfcrypt_stats_function<bind_wolfSSL_SHA512_256_Init>(env, "wolfSSL_SHA512_256_Init"));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_256_Update"), wolfcrypt_stats_function<bind_wolfSSL_SHA512_256_Update>(env, "wolfSSL_SHA512_256_Update", 2));
+  exports.Set(Napi::String::New(env, "wolfSSL_SHA512_256_Final"), wolfcrypt_stats_function<bind_wolfSSL_SHA512_256_Final>(env, "wolfSSL_SHA512_256_Final"));
 #endif
 
-  exports.Set(Napi::String::New(env, "sizeof_ecc_key"), Napi::Function::New(env, sizeof_ecc_key));
-  exports.Set(Napi::String::New(env, "sizeof_ecc_point"), Napi::Function::New(env, sizeof_ecc_point));
-  exports.Set(Napi::String::New(env, "wc_ecc_size"), Napi::Function::New(env, bind_wc_ecc_size));
-  exports.Set(Napi::String::New(env, "wc_ecc_init"), Napi::Function::New(env, bind_wc_ecc_init));
-  exports.Set(Napi::String::New(env, "wc_ecc_make_key"), Napi::Function::New(env, bind_wc_ecc_make_key));
-  exports.Set(Napi::String::New(env, "wc_ecc_make_key_async"), Napi::Function::New(env, wc_ecc_make_key_async));
-  exports.Set(Napi::String::New(env, "sizeof_ecc_x963"), Napi::Function::New(env, sizeof_ecc_x963));
-  exports.Set(Napi::String::New(env, "wc_ecc_export_x963"), Napi::Function::New(env, bind_wc_ecc_export_x963));
-  exports.Set(Napi::String::New(env, "wc_ecc_import_x963"), Napi::Function::New(env, bind_wc_ecc_import_x963));
-  exports.Set(Napi::String::New(env, "wc_EccKeyDerSize"), Napi::Function::New(env, bind_wc_EccKeyDerSize));
-  exports.Set(Napi::String::New(env, "wc_EccPublicKeyToDer"), Napi::Function::New(env, bind_wc_EccPublicKeyToDer));
-  exports.Set(Napi::String::New(env, "wc_EccPublicKeyDecode"), Napi::Function::New(env, bind_wc_EccPublicKeyDecode));
-  exports.Set(Napi::String::New(env, "wc_EccPublicKeyDerSize"), Napi::Function::New(env, bind_wc_EccPublicKeyDerSize));
-  exports.Set(Napi::String::New(env, "wc_EccPrivateKeyToDer"), Napi::Function::New(env, bind_wc_EccPrivateKeyToDer));
-  exports.Set(Napi::String::New(env, "wc_EccPrivateKeyDecode"), Napi::Function::New(env, bind_wc_EccPrivateKeyDecode));
-  exports.Set(Napi::String::New(env, "wc_ecc_set_curve"), Napi::Function::New(env, bind_wc_ecc_set_curve));
-  exports.Set(Napi::String::New(env, "wc_ecc_shared_secret"), Napi::Function::New(env, bind_wc_ecc_shared_secret));
-  exports.Set(Napi::String::New(env, "wc_ecc_sig_size"), Napi::Function::New(env, bind_wc_ecc_sig_size));
-  exports.Set(Napi::String::New(env, "wc_ecc_sign_hash"), Napi::Function::New(env, bind_wc_ecc_sign_hash));
-  exports.Set(Napi::String::New(env, "wc_ecc_verify_hash"), Napi::Function::New(env, bind_wc_ecc_verify_hash));
-  exports.Set(Napi::String::New(env, "wc_ecc_free"), Napi::Function::New(env, bind_wc_ecc_free));
-
-  exports.Set(Napi::String::New(env, "wc_PBKDF2"), Napi::Function::New(env, bind_wc_PBKDF2));
+  exports.Set(Napi::String::New(env, "sizeof_ecc_key"), wolfcrypt_stats_function<sizeof_ecc_key>(env, "sizeof_ecc_key"));
+  exports.Set(Napi::String::New(env, "sizeof_ecc_point"), wolfcrypt_stats_function<sizeof_ecc_point>(env, "sizeof_ecc_point"));
+  exports.Set(Napi::String::New(env, "wc_ecc_size"), wolfcrypt_stats_function<bind_wc_ecc_size>(env, "wc_ecc_size"));
+  exports.Set(Napi::String::New(env, "wc_ecc_init"), wolfcrypt_stats_function<bind_wc_ecc_init>(env, "wc_ecc_init"));
+  exports.Set(Napi::String::New(env, "wc_ecc_make_key"), wolfcrypt_stats_function<bind_wc_ecc_make_key>(env, "wc_ecc_make_key"));
+  exports.Set(Napi::String::New(env, "wc_ecc_make_key_async"), wolfcrypt_stats_function<wc_ecc_make_key_async>(env, "wc_ecc_make_key_async"));
+  exports.Set(Napi::String::New(env, "sizeof_ecc_x963"), wolfcrypt_stats_function<sizeof_ecc_x963>(env, "sizeof_ecc_x963"));
+  exports.Set(Napi::String::New(env, "wc_ecc_export_x963"), wolfcrypt_stats_function<bind_wc_ecc_export_x963>(env, "wc_ecc_export_x963"));
+  exports.Set(Napi::String::New(env, "wc_ecc_import_x963"), wolfcrypt_stats_function<bind_wc_ecc_import_x963>(env, "wc_ecc_import_x963"));
+  exports.Set(Napi::String::New(env, "wc_EccKeyDerSize"), wolfcrypt_stats_function<bind_wc_EccKeyDerSize>(env, "wc_EccKeyDerSize"));
+  exports.Set(Napi::String::New(env, "wc_EccPublicKeyToDer"), wolfcrypt_stats_function<bind_wc_EccPublicKeyToDer>(env, "wc_EccPublicKeyToDer"));
+  exports.Set(Napi::String::New(env, "wc_EccPublicKeyDecode"), wolfcrypt_stats_function<bind_wc_EccPublicKeyDecode>(env, "wc_EccPublicKeyDecode"));
+  exports.Set(Napi::String::New(env, "wc_EccPublicKeyDerSize"), wolfcrypt_stats_function<bind_wc_EccPublicKeyDerSize>(env, "wc_EccPublicKeyDerSize"));
+  exports.Set(Napi::String::New(env, "wc_EccPrivateKeyToDer"), wolfcrypt_stats_function<bind_wc_EccPrivateKeyToDer>(env, "wc_EccPrivateKeyToDer"));
+  exports.Set(Napi::String::New(env, "wc_EccPrivateKeyDecode"), wolfcrypt_stats_function<bind_wc_EccPrivateKeyDecode>(env, "wc_EccPrivateKeyDecode"));
+  exports.Set(Napi::String::New(env, "nodejsEccKeyCached"), wolfcrypt_stats_function<nodejsEccKeyCached>(env, "nodejsEccKeyCached"));
+  exports.Set(Napi::String::New(env, "wc_ecc_set_curve"), wolfcrypt_stats_function<bind_wc_ecc_set_curve>(env, "wc_ecc_set_curve"));
+  exports.Set(Napi::String::New(env, "wc_ecc_shared_secret"), wolfcrypt_stats_function<bind_wc_ecc_shared_secret>(env, "wc_ecc_shared_secret"));
+  exports.Set(Napi::String::New(env, "wc_ecc_sig_size"), wolfcrypt_stats_function<bind_wc_ecc_sig_size>(env, "wc_ecc_sig_size"));
+  exports.Set(Napi::String::New(env, "wc_ecc_sign_hash"), wolfcrypt_stats_function<bind_wc_ecc_sign_hash>(env, "wc_ecc_sign_hash", 1));
+  exports.Set(Napi::String::New(env, "wc_ecc_verify_hash"), wolfcrypt_stats_function<bind_wc_ecc_verify_hash>(env, "wc_ecc_verify_hash", 3));
+  exports.Set(Napi::String::New(env, "wc_ecc_sign_hash_async"), wolfcrypt_stats_function<wc_ecc_sign_hash_async>(env, "wc_ecc_sign_hash_async", 1));
+  exports.Set(Napi::String::New(env, "wc_ecc_verify_hash_async"), wolfcrypt_stats_function<wc_ecc_verify_hash_async>(env, "wc_ecc_verify_hash_async", 3));
+  exports.Set(Napi::String::New(env, "wc_ecc_verify_hash_batch"), wolfcrypt_stats_function<wc_ecc_verify_hash_batch>(env, "wc_ecc_verify_hash_batch"));
+  exports.Set(Napi::String::New(env, "wc_ecc_verify_hash_batch_multi"), wolfcrypt_stats_function<wc_ecc_verify_hash_batch_multi>(env, "wc_ecc_verify_hash_batch_multi"));
+  exports.Set(Napi::String::New(env, "wc_ecc_shared_secret_async"), wolfcrypt_stats_function<wc_ecc_shared_secret_async>(env, "wc_ecc_shared_secret_async"));
+  exports.Set(Napi::String::New(env, "wc_ecc_free"), wolfcrypt_stats_function<bind_wc_ecc_free>(env, "wc_ecc_free"));
+  exports.Set(Napi::String::New(env, "nodejsEccFpWarm"), wolfcrypt_stats_function<nodejsEccFpWarm>(env, "nodejsEccFpWarm"));
+  exports.Set(Napi::String::New(env, "nodejsEccFpWarmSync"), wolfcrypt_stats_function<nodejsEccFpWarmSync>(env, "nodejsEccFpWarmSync"));
+  exports.Set(Napi::String::New(env, "nodejsEccFpFree"), wolfcrypt_stats_function<nodejsEccFpFree>(env, "nodejsEccFpFree"));
+  exports.Set(Napi::String::New(env, "nodejsEccFpStats"), Napi::Function::New(env, nodejsEccFpStats));
+
+#ifdef HAVE_ED25519
+  exports.Set(Napi::String::New(env, "sizeof_ed25519_key"), wolfcrypt_stats_function<sizeof_ed25519_key>(env, "sizeof_ed25519_key"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_init"), wolfcrypt_stats_function<bind_wc_ed25519_init>(env, "wc_ed25519_init"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_make_key"), wolfcrypt_stats_function<bind_wc_ed25519_make_key>(env, "wc_ed25519_make_key"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_make_key_async"), wolfcrypt_stats_function<wc_ed25519_make_key_async>(env, "wc_ed25519_make_key_async"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_export_public"), wolfcrypt_stats_function<bind_wc_ed25519_export_public>(env, "wc_ed25519_export_public"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_import_public"), wolfcrypt_stats_function<bind_wc_ed25519_import_public>(env, "wc_ed25519_import_public"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_export_private_only"), wolfcrypt_stats_function<bind_wc_ed25519_export_private_only>(env, "wc_ed25519_export_private_only"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_import_private_key"), wolfcrypt_stats_function<bind_wc_ed25519_import_private_key>(env, "wc_ed25519_import_private_key"));
+  exports.Set(Napi::String::New(env, "wc_Ed25519KeyToDer"), wolfcrypt_stats_function<bind_wc_Ed25519KeyToDer>(env, "wc_Ed25519KeyToDer"));
+  exports.Set(Napi::String::New(env, "wc_Ed25519PublicKeyToDer"), wolfcrypt_stats_function<bind_wc_Ed25519PublicKeyToDer>(env, "wc_Ed25519PublicKeyToDer"));
+  exports.Set(Napi::String::New(env, "wc_Ed25519PrivateKeyDecode"), wolfcrypt_stats_function<bind_wc_Ed25519PrivateKeyDecode>(env, "wc_Ed25519PrivateKeyDecode"));
+  exports.Set(Napi::String::New(env, "wc_Ed25519PublicKeyDecode"), wolfcrypt_stats_function<bind_wc_Ed25519PublicKeyDecode>(env, "wc_Ed25519PublicKeyDecode"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_sign_msg"), wolfcrypt_stats_function<bind_wc_ed25519_sign_msg>(env, "wc_ed25519_sign_msg", 1));
+  exports.Set(Napi::String::New(env, "wc_ed25519_verify_msg"), wolfcrypt_stats_function<bind_wc_ed25519_verify_msg>(env, "wc_ed25519_verify_msg", 3));
+  exports.Set(Napi::String::New(env, "wc_ed25519_sign_msg_async"), wolfcrypt_stats_function<wc_ed25519_sign_msg_async>(env, "wc_ed25519_sign_msg_async", 1));
+  exports.Set(Napi::String::New(env, "wc_ed25519_verify_msg_async"), wolfcrypt_stats_function<wc_ed25519_verify_msg_async>(env, "wc_ed25519_verify_msg_async", 3));
+  exports.Set(Napi::String::New(env, "wc_ed25519_verify_msg_batch"), wolfcrypt_stats_function<wc_ed25519_verify_msg_batch>(env, "wc_ed25519_verify_msg_batch"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_verify_msg_batch_multi"), wolfcrypt_stats_function<wc_ed25519_verify_msg_batch_multi>(env, "wc_ed25519_verify_msg_batch_multi"));
+  exports.Set(Napi::String::New(env, "wc_ed25519_free"), wolfcrypt_stats_function<bind_wc_ed25519_free>(env, "wc_ed25519_free"));
+#endif
+
+#ifdef HAVE_CURVE25519
+  exports.Set(Napi::String::New(env, "sizeof_curve25519_key"), wolfcrypt_stats_function<sizeof_curve25519_key>(env, "sizeof_curve25519_key"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_init"), wolfcrypt_stats_function<bind_wc_curve25519_init>(env, "wc_curve25519_init"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_make_key"), wolfcrypt_stats_function<bind_wc_curve25519_make_key>(env, "wc_curve25519_make_key"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_make_key_async"), wolfcrypt_stats_function<wc_curve25519_make_key_async>(env, "wc_curve25519_make_key_async"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_export_public"), wolfcrypt_stats_function<bind_wc_curve25519_export_public>(env, "wc_curve25519_export_public"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_import_public"), wolfcrypt_stats_function<bind_wc_curve25519_import_public>(env, "wc_curve25519_import_public"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_export_private_raw"), wolfcrypt_stats_function<bind_wc_curve25519_export_private_raw>(env, "wc_curve25519_export_private_raw"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_import_private"), wolfcrypt_stats_function<bind_wc_curve25519_import_private>(env, "wc_curve25519_import_private"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_shared_secret"), wolfcrypt_stats_function<bind_wc_curve25519_shared_secret>(env, "wc_curve25519_shared_secret"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_shared_secret_async"), wolfcrypt_stats_function<wc_curve25519_shared_secret_async>(env, "wc_curve25519_shared_secret_async"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_shared_secret_many"), wolfcrypt_stats_function<bind_wc_curve25519_shared_secret_many>(env, "wc_curve25519_shared_secret_many"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_shared_secret_many_async"), wolfcrypt_stats_function<wc_curve25519_shared_secret_many_async>(env, "wc_curve25519_shared_secret_many_async"));
+  exports.Set(Napi::String::New(env, "wc_curve25519_free"), wolfcrypt_stats_function<bind_wc_curve25519_free>(env, "wc_curve25519_free"));
+#endif
+
+  exports.Set(Napi::String::New(env, "wc_PBKDF2"), wolfcrypt_stats_function<bind_wc_PBKDF2>(env, "wc_PBKDF2"));
+  exports.Set(Napi::String::New(env, "wc_PBKDF2_async"), wolfcrypt_stats_function<bind_wc_PBKDF2_async>(env, "wc_PBKDF2_async"));
+  exports.Set(Napi::String::New(env, "wc_PBKDF2_batch"), wolfcrypt_stats_function<bind_wc_PBKDF2_batch>(env, "wc_PBKDF2_batch"));
+  exports.Set(Napi::String::New(env, "nodejsThreadPoolSize"), Napi::Function::New(env, nodejsThreadPoolSize));
+
+  exports.Set(Napi::String::New(env, "wc_HKDF"), wolfcrypt_stats_function<bind_wc_HKDF>(env, "wc_HKDF"));
+  exports.Set(Napi::String::New(env, "wc_HKDF_Extract"), wolfcrypt_stats_function<bind_wc_HKDF_Extract>(env, "wc_HKDF_Extract"));
+  exports.Set(Napi::String::New(env, "wc_HKDF_Expand"), wolfcrypt_stats_function<bind_wc_HKDF_Expand>(env, "wc_HKDF_Expand"));
+  exports.Set(Napi::String::New(env, "wc_X963_KDF"), wolfcrypt_stats_function<bind_wc_X963_KDF>(env, "wc_X963_KDF"));
+  exports.Set(Napi::String::New(env, "wc_HKDF_async"), wolfcrypt_stats_function<bind_wc_HKDF_async>(env, "wc_HKDF_async"));
+  exports.Set(Napi::String::New(env, "wc_HKDF_Extract_async"), wolfcrypt_stats_function<bind_wc_HKDF_Extract_async>(env, "wc_HKDF_Extract_async"));
+  exports.Set(Napi::String::New(env, "wc_HKDF_Expand_async"), wolfcrypt_stats_function<bind_wc_HKDF_Expand_async>(env, "wc_HKDF_Expand_async"));
+  exports.Set(Napi::String::New(env, "wc_X963_KDF_async"), wolfcrypt_stats_function<bind_wc_X963_KDF_async>(env, "wc_X963_KDF_async"));
+  exports.Set(Napi::String::New(env, "wc_HKDF_batch"), wolfcrypt_stats_function<bind_wc_HKDF_batch>(env, "wc_HKDF_batch"));
+  exports.Set(Napi::String::New(env, "wc_X963_KDF_batch"), wolfcrypt_stats_function<bind_wc_X963_KDF_batch>(env, "wc_X963_KDF_batch"));
 
 #ifdef HAVE_PKCS7
-  exports.Set(Napi::String::New(env, "sizeof_PKCS7"), Napi::Function::New(env, sizeof_PKCS7));
-  exports.Set(Napi::String::New(env, "typeof_Key_Sum"), Napi::Function::New(env, typeof_Key_Sum));
-  exports.Set(Napi::String::New(env, "typeof_Hash_Sum"), Napi::Function::New(env, typeof_Hash_Sum));
-  exports.Set(Napi::String::New(env, "wc_PKCS7_Init"), Napi::Function::New(env, bind_wc_PKCS7_Init));
-  exports.Set(Napi::String::New(env, "wc_PKCS7_InitWithCert"), Napi::Function::New(env, bind_wc_PKCS7_InitWithCert));
-  exports.Set(Napi::String::New(env, "wc_PKCS7_AddCertificate"), Napi::Function::New(env, bind_wc_PKCS7_AddCertificate));
-  exports.Set(Napi::String::New(env, "wc_PKCS7_EncodeData"), Napi::Function::New(env, bind_wc_PKCS7_EncodeData));
-  exports.Set(Napi::String::New(env, "wc_PKCS7_EncodeSignedData"), Napi::Function::New(env, bind_wc_PKCS7_EncodeSignedData));
-  exports.Set(Napi::String::New(env, "wc_PKCS7_VerifySignedData"), Napi::Function::New(env, bind_wc_PKCS7_VerifySignedData));
-  exports.Set(Napi::String::New(env, "sizeof_wc_PKCS7_GetAttributeValue"), Napi::Function::New(env, sizeof_wc_PKCS7_GetAttributeValue));
-  exports.Set(Napi::String::New(env, "wc_PKCS7_GetAttributeValue"), Napi::Function::New(env, bind_wc_PKCS7_GetAttributeValue));
-  exports.Set(Napi::String::New(env, "sizeof_wc_PKCS7_GetSignerSID"), Napi::Function::New(env, sizeof_wc_PKCS7_GetSignerSID));
-  exports.Set(Napi::String::New(env, "wc_PKCS7_GetSignerSID"), Napi::Function::New(env, bind_wc_PKCS7_GetSignerSID));
-  exports.Set(Napi::String::New(env, "wc_PKCS7_Free"), Napi::Function::New(env, bind_wc_PKCS7_Free));
+  exports.Set(Napi::String::New(env, "sizeof_PKCS7"), wolfcrypt_stats_function<sizeof_PKCS7>(env, "sizeof_PKCS7"));
+  exports.Set(Napi::String::New(env, "typeof_Key_Sum"), wolfcrypt_stats_function<typeof_Key_Sum>(env, "typeof_Key_Sum"));
+  exports.Set(Napi::String::New(env, "typeof_Hash_Sum"), wolfcrypt_stats_function<typeof_Hash_Sum>(env, "typeof_Hash_Sum"));
+  exports.Set(Napi::String::New(env, "nodejsPKCS7New"), wolfcrypt_stats_function<nodejsPKCS7New>(env, "nodejsPKCS7New"));
+  exports.Set(Napi::String::New(env, "wc_PKCS7_Init"), wolfcrypt_stats_function<bind_wc_PKCS7_Init>(env, "wc_PKCS7_Init"));
+  exports.Set(Napi::String::New(env, "wc_PKCS7_InitWithCert"), wolfcrypt_stats_function<bind_wc_PKCS7_InitWithCert>(env, "wc_PKCS7_InitWithCert"));
+  exports.Set(Napi::String::New(env, "wc_PKCS7_AddCertificate"), wolfcrypt_stats_function<bind_wc_PKCS7_AddCertificate>(env, "wc_PKCS7_AddCertificate"));
+  exports.Set(Napi::String::New(env, "wc_PKCS7_EncodeData"), wolfcrypt_stats_function<bind_wc_PKCS7_EncodeData>(env, "wc_PKCS7_EncodeData"));
+  exports.Set(Napi::String::New(env, "wc_PKCS7_EncodeSignedData"), wolfcrypt_stats_function<bind_wc_PKCS7_EncodeSignedData>(env, "wc_PKCS7_EncodeSignedData"));
+  exports.Set(Napi::String::New(env, "wc_PKCS7_VerifySignedData"), wolfcrypt_stats_function<bind_wc_PKCS7_VerifySignedData>(env, "wc_PKCS7_VerifySignedData"));
+  exports.Set(Napi::String::New(env, "sizeof_wc_PKCS7_GetAttributeValue"), wolfcrypt_stats_function<sizeof_wc_PKCS7_GetAttributeValue>(env, "sizeof_wc_PKCS7_GetAttributeValue"));
+  exports.Set(Napi::String::New(env, "wc_PKCS7_GetAttributeValue"), wolfcrypt_stats_function<bind_wc_PKCS7_GetAttributeValue>(env, "wc_PKCS7_GetAttributeValue"));
+  exports.Set(Napi::String::New(env, "sizeof_wc_PKCS7_GetSignerSID"), wolfcrypt_stats_function<sizeof_wc_PKCS7_GetSignerSID>(env, "sizeof_wc_PKCS7_GetSignerSID"));
+  exports.Set(Napi::String::New(env, "wc_PKCS7_GetSignerSID"), wolfcrypt_stats_function<bind_wc_PKCS7_GetSignerSID>(env, "wc_PKCS7_GetSignerSID"));
+  exports.Set(Napi::String::New(env, "wc_PKCS7_Free"), wolfcrypt_stats_function<bind_wc_PKCS7_Free>(env, "wc_PKCS7_Free"));
 #endif
 
-  exports.Set(Napi::String::New(env, "wc_PKCS12_new"), Napi::Function::New(env, bind_wc_PKCS12_new));
-  exports.Set(Napi::String::New(env, "nodejsPKCS12Create"), Napi::Function::New(env, nodejsPKCS12Create));
-  exports.Set(Napi::String::New(env, "nodejsPKCS12Parse"), Napi::Function::New(env, nodejsPKCS12Parse));
-  exports.Set(Napi::String::New(env, "wc_d2i_PKCS12"), Napi::Function::New(env, bind_wc_d2i_PKCS12));
-  exports.Set(Napi::String::New(env, "nodejsPKCS12InternalToDer"), Napi::Function::New(env, nodejsPKCS12InternalToDer));
-  exports.Set(Napi::String::New(env, "wc_PKCS12_free"), Napi::Function::New(env, bind_wc_PKCS12_free));
-
-  exports.Set(Napi::String::New(env, "sizeof_WC_RNG"), Napi::Function::New(env, sizeof_WC_RNG));
-  exports.Set(Napi::String::New(env, "wc_InitRng"), Napi::Function::New(env, bind_wc_InitRng));
-  exports.Set(Napi::String::New(env, "wc_RNG_GenerateBlock"), Napi::Function::New(env, bind_wc_RNG_GenerateBlock));
-  exports.Set(Napi::String::New(env, "wc_FreeRng"), Napi::Function::New(env, bind_wc_FreeRng));
+  exports.Set(Napi::String::New(env, "wc_PKCS12_new"), wolfcrypt_stats_function<bind_wc_PKCS12_new>(env, "wc_PKCS12_new"));
+  exports.Set(Napi::String::New(env, "nodejsPKCS12Create"), wolfcrypt_stats_function<nodejsPKCS12Create>(env, "nodejsPKCS12Create"));
+  exports.Set(Napi::String::New(env, "nodejsPKCS12Parse"), wolfcrypt_stats_function<nodejsPKCS12Parse>(env, "nodejsPKCS12Parse"));
+  exports.Set(Napi::String::New(env, "wc_d2i_PKCS12"), wolfcrypt_stats_function<bind_wc_d2i_PKCS12>(env, "wc_d2i_PKCS12"));
+  exports.Set(Napi::String::New(env, "nodejsPKCS12InternalToDer"), wolfcrypt_stats_function<nodejsPKCS12InternalToDer>(env, "nodejsPKCS12InternalToDer"));
+  exports.Set(Napi::String::New(env, "wc_PKCS12_free"), wolfcrypt_stats_function<bind_wc_PKCS12_free>(env, "wc_PKCS12_free"));
+
+  exports.Set(Napi::String::New(env, "sizeof_WC_RNG"), wolfcrypt_stats_function<sizeof_WC_RNG>(env, "sizeof_WC_RNG"));
+  exports.Set(Napi::String::New(env, "wc_InitRng"), wolfcrypt_stats_function<bind_wc_InitRng>(env, "wc_InitRng"));
+  exports.Set(Napi::String::New(env, "wc_RNG_GenerateBlock"), wolfcrypt_stats_function<bind_wc_RNG_GenerateBlock>(env, "wc_RNG_GenerateBlock"));
+  exports.Set(Napi::String::New(env, "wc_FreeRng"), wolfcrypt_stats_function<bind_wc_FreeRng>(env, "wc_FreeRng"));
+  exports.Set(Napi::String::New(env, "nodejsRngStats"), Napi::Function::New(env, nodejsRngStats));
+
+  exports.Set(Napi::String::New(env, "nodejsRsaKeyNew"), wolfcrypt_stats_function<nodejsRsaKeyNew>(env, "nodejsRsaKeyNew"));
+  exports.Set(Napi::String::New(env, "nodejsEccKeyNew"), wolfcrypt_stats_function<nodejsEccKeyNew>(env, "nodejsEccKeyNew"));
+#ifdef HAVE_ED25519
+  exports.Set(Napi::String::New(env, "nodejsEd25519KeyNew"), wolfcrypt_stats_function<nodejsEd25519KeyNew>(env, "nodejsEd25519KeyNew"));
+#endif
+#ifdef HAVE_CURVE25519
+  exports.Set(Napi::String::New(env, "nodejsCurve25519KeyNew"), wolfcrypt_stats_function<nodejsCurve25519KeyNew>(env, "nodejsCurve25519KeyNew"));
+#endif
+  exports.Set(Napi::String::New(env, "nodejsHmacNew"), wolfcrypt_stats_function<nodejsHmacNew>(env, "nodejsHmacNew"));
+  exports.Set(Napi::String::New(env, "nodejsHmacKeyNew"), wolfcrypt_stats_function<nodejsHmacKeyNew>(env, "nodejsHmacKeyNew"));
+  exports.Set(Napi::String::New(env, "nodejsShaNew"), wolfcrypt_stats_function<nodejsShaNew>(env, "nodejsShaNew"));
+  exports.Set(Napi::String::New(env, "nodejsHandleRelease"), wolfcrypt_stats_function<nodejsHandleRelease>(env, "nodejsHandleRelease"));
+  exports.Set(Napi::String::New(env, "nodejsHandleStats"), Napi::Function::New(env, nodejsHandleStats));
+  exports.Set(Napi::String::New(env, "nodejsPoolStats"), Napi::Function::New(env, nodejsPoolStats));
+  exports.Set(Napi::String::New(env, "nodejsPoolLimit"), Napi::Function::New(env, nodejsPoolLimit));
+  exports.Set(Napi::String::New(env, "nodejsKeyCacheStats"), Napi::Function::New(env, nodejsKeyCacheStats));
+  exports.Set(Napi::String::New(env, "nodejsKeyCacheLimit"), Napi::Function::New(env, nodejsKeyCacheLimit));
+  exports.Set(Napi::String::New(env, "nodejsKeyCacheClear"), Napi::Function::New(env, nodejsKeyCacheClear));
+  exports.Set(Napi::String::New(env, "nodejsKeyPoolConfigure"), Napi::Function::New(env, nodejsKeyPoolConfigure));
+  exports.Set(Napi::String::New(env, "nodejsRsaKeyPooled"), wolfcrypt_stats_function<nodejsRsaKeyPooled>(env, "nodejsRsaKeyPooled"));
+  exports.Set(Napi::String::New(env, "nodejsEccKeyPooled"), wolfcrypt_stats_function<nodejsEccKeyPooled>(env, "nodejsEccKeyPooled"));
+  exports.Set(Napi::String::New(env, "nodejsKeyPoolStats"), Napi::Function::New(env, nodejsKeyPoolStats));
+  exports.Set(Napi::String::New(env, "nodejsKeyPoolClear"), Napi::Function::New(env, nodejsKeyPoolClear));
+
+  exports.Set(Napi::String::New(env, "nodejsBenchmark"), Napi::Function::New(env, nodejsBenchmark));
+
+  exports.Set(Napi::String::New(env, "nodejsStats"), Napi::Function::New(env, nodejsStats));
+  exports.Set(Napi::String::New(env, "nodejsStatsReset"), Napi::Function::New(env, nodejsStatsReset));
+  exports.Set(Napi::String::New(env, "nodejsStatsEnabled"), Napi::Function::New(env, nodejsStatsEnabled));
+  exports.Set(Napi::String::New(env, "nodejsWatchdog"), Napi::Function::New(env, nodejsWatchdog));
+  exports.Set(Napi::String::New(env, "nodejsWatchdogEvents"), Napi::Function::New(env, nodejsWatchdogEvents));
+  exports.Set(Napi::String::New(env, "nodejsWatchdogRerouted"), Napi::Function::New(env, nodejsWatchdogRerouted));
 
   return exports;
 }
@@ -0,0 +1,389 @@
+/* native.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/native.h"
+#include <cstring>
+#include <stdlib.h>
+#include <unordered_map>
+#include <vector>
+
+// keys and contexts used to live in Buffer.alloc memory, these functions hand
+// out Buffers over natively allocated memory instead so the structs don't sit
+// on the js heap, and a finalizer frees whatever the wolfcrypt struct still
+// owns, such as mp_int memory, when a caller forgets to call free. Every
+// binding keeps taking the struct as a Uint8Array, so nothing else changes
+
+typedef struct native_handle
+{
+  int type;
+  // the wc_HashType of a NATIVE_SHA handle
+  int hash_type;
+  size_t size;
+  // set once the wolfcrypt free function has been called from js
+  bool released;
+} native_handle;
+
+// finalizers run on the main thread but the registry is small enough that a
+// lock costs nothing and keeps worker threads safe should they ever look
+static std::mutex handles_lock;
+static std::unordered_map<void*, native_handle> handles;
+static std::atomic<size_t> handles_bytes( 0 );
+
+// released memory of every type is kept on a free list per size, up to
+// pool_limit entries each, and zeroed on release so a reused struct looks
+// exactly like a fresh calloc
+static size_t pool_limit = NATIVE_POOL_DEFAULT_LIMIT;
+static std::unordered_map<size_t, std::vector<uint8_t*>> pool_free;
+static std::atomic<uint64_t> pool_hits[NATIVE_TYPE_COUNT];
+static std::atomic<uint64_t> pool_misses[NATIVE_TYPE_COUNT];
+
+static const char* pool_names[NATIVE_TYPE_COUNT] = { "rsa", "ecc", "hmac", "sha", "pkcs7", "evp", "ed25519", "curve25519", "hmac_key" };
+
+void* wolfcrypt_pool_alloc( int type, size_t size )
+{
+  {
+    std::lock_guard<std::mutex> guard( handles_lock );
+    auto it = pool_free.find( size );
+
+    if ( it != pool_free.end() && !it->second.empty() )
+    {
+      uint8_t* data = it->second.back();
+
+      it->second.pop_back();
+      pool_hits[type]++;
+
+      return data;
+    }
+  }
+
+  pool_misses[type]++;
+
+  return calloc( 1, size );
+}
+
+void wolfcrypt_pool_release( int type, void* data, size_t size )
+{
+  // keys hold secrets, and the next user expects zeroed memory
+  memset( data, 0, size );
+
+  std::lock_guard<std::mutex> guard( handles_lock );
+  std::vector<uint8_t*>& list = pool_free[size];
+
+  if ( list.size() < pool_limit )
+  {
+    list.push_back( (uint8_t*)data );
+
+    return;
+  }
+
+  free( data );
+}
+
+static void native_handle_free( native_handle& handle, void* data )
+{
+  // an async worker still using the key holds a reference to its Buffer, so
+  // this lock only waits out a sync call that is about to return
+  std::lock_guard<std::mutex> guard( wolfcrypt_key_lock( data ) );
+
+  switch ( handle.type )
+  {
+    case NATIVE_RSA:
+      wc_FreeRsaKey( (RsaKey*)data );
+      break;
+    case NATIVE_ECC:
+      wc_ecc_free( (ecc_key*)data );
+      break;
+    case NATIVE_HMAC:
+      wc_HmacFree( (Hmac*)data );
+      break;
+    case NATIVE_SHA:
+      wc_HashFree( (wc_HashAlg*)data, (enum wc_HashType)handle.hash_type );
+      break;
+#ifdef HAVE_PKCS7
+    case NATIVE_PKCS7:
+      wc_PKCS7_Free( (PKCS7*)data );
+      break;
+#endif
+#ifdef HAVE_ED25519
+    case NATIVE_ED25519:
+      wc_ed25519_free( (ed25519_key*)data );
+      break;
+#endif
+#ifdef HAVE_CURVE25519
+    case NATIVE_CURVE25519:
+      wc_curve25519_free( (curve25519_key*)data );
+      break;
+#endif
+    case NATIVE_HMAC_KEY:
+    {
+      HmacKey* hk = (HmacKey*)data;
+
+      wc_HashFree( &hk->inner, (enum wc_HashType)hk->type );
+      wc_HashFree( &hk->outer, (enum wc_HashType)hk->type );
+      wc_HashFree( &hk->current, (enum wc_HashType)hk->type );
+      break;
+    }
+  }
+}
+
+static void native_handle_finalize( Napi::Env env, uint8_t* data )
+{
+  native_handle handle;
+
+  {
+    std::lock_guard<std::mutex> guard( handles_lock );
+    auto it = handles.find( data );
+
+    if ( it == handles.end() )
+    {
+      return;
+    }
+
+    handle = it->second;
+    handles.erase( it );
+  }
+
+  if ( !handle.released )
+  {
+    native_handle_free( handle, data );
+  }
+
+  wolfcrypt_pool_release( handle.type, data, handle.size );
+
+  handles_bytes -= handle.size;
+  Napi::MemoryManagement::AdjustExternalMemory( env, -(int64_t)handle.size );
+}
+
+// returns MEMORY_E instead of a Buffer when out of memory, the memory starts
+// zeroed like Buffer.alloc, which every wolfcrypt free function accepts in
+// case the struct is never initialized
+static Napi::Value native_handle_register( Napi::Env env, int type, int hash_type, uint8_t* data, size_t size )
+{
+  {
+    std::lock_guard<std::mutex> guard( handles_lock );
+
+    handles[data] = { type, hash_type, size, false };
+  }
+
+  handles_bytes += size;
+  Napi::MemoryManagement::AdjustExternalMemory( env, (int64_t)size );
+
+  return Napi::Buffer<uint8_t>::New( env, data, size, native_handle_finalize );
+}
+
+static Napi::Value native_handle_new( Napi::Env env, int type, int hash_type, size_t size )
+{
+  uint8_t* data = (uint8_t*)wolfcrypt_pool_alloc( type, size );
+
+  if ( data == NULL )
+  {
+    return Napi::Number::New( env, MEMORY_E );
+  }
+
+  return native_handle_register( env, type, hash_type, data, size );
+}
+
+Napi::Value wolfcrypt_native_handle_adopt( Napi::Env env, int type, void* data, size_t size )
+{
+  return native_handle_register( env, type, 0, (uint8_t*)data, size );
+}
+
+Napi::Value nodejsRsaKeyNew(const Napi::CallbackInfo& info)
+{
+  return native_handle_new( info.Env(), NATIVE_RSA, 0, sizeof( RsaKey ) );
+}
+
+Napi::Value nodejsEccKeyNew(const Napi::CallbackInfo& info)
+{
+  return native_handle_new( info.Env(), NATIVE_ECC, 0, sizeof( ecc_key ) );
+}
+
+Napi::Value nodejsHmacNew(const Napi::CallbackInfo& info)
+{
+  return native_handle_new( info.Env(), NATIVE_HMAC, 0, sizeof( Hmac ) );
+}
+
+Napi::Value nodejsHmacKeyNew(const Napi::CallbackInfo& info)
+{
+  return native_handle_new( info.Env(), NATIVE_HMAC_KEY, 0, sizeof( HmacKey ) );
+}
+
+// nodejsShaNew( type ) takes a typeof_Hash value and returns a handle big
+// enough for the matching WOLFSSL_SHA*_CTX
+Napi::Value nodejsShaNew(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int type = info[0].As<Napi::Number>().Int32Value();
+  size_t size;
+
+  switch ( type )
+  {
+    case WC_HASH_TYPE_SHA:
+      size = sizeof( WOLFSSL_SHA_CTX );
+      break;
+    case WC_HASH_TYPE_SHA224:
+      size = sizeof( WOLFSSL_SHA224_CTX );
+      break;
+    case WC_HASH_TYPE_SHA256:
+      size = sizeof( WOLFSSL_SHA256_CTX );
+      break;
+    case WC_HASH_TYPE_SHA384:
+      size = sizeof( WOLFSSL_SHA384_CTX );
+      break;
+    case WC_HASH_TYPE_SHA512:
+      size = sizeof( WOLFSSL_SHA512_CTX );
+      break;
+    case WC_HASH_TYPE_SHA512_224:
+      size = sizeof( WOLFSSL_SHA512_224_CTX );
+      break;
+    case WC_HASH_TYPE_SHA512_256:
+      size = sizeof( WOLFSSL_SHA512_256_CTX );
+      break;
+    default:
+      size = sizeof( wc_HashAlg );
+      break;
+  }
+
+  return native_handle_new( env, NATIVE_SHA, type, size );
+}
+
+#ifdef HAVE_PKCS7
+Napi::Value nodejsPKCS7New(const Napi::CallbackInfo& info)
+{
+  return native_handle_new( info.Env(), NATIVE_PKCS7, 0, sizeof( PKCS7 ) );
+}
+#endif
+
+#ifdef HAVE_ED25519
+Napi::Value nodejsEd25519KeyNew(const Napi::CallbackInfo& info)
+{
+  return native_handle_new( info.Env(), NATIVE_ED25519, 0, sizeof( ed25519_key ) );
+}
+#endif
+
+#ifdef HAVE_CURVE25519
+Napi::Value nodejsCurve25519KeyNew(const Napi::CallbackInfo& info)
+{
+  return native_handle_new( info.Env(), NATIVE_CURVE25519, 0, sizeof( curve25519_key ) );
+}
+#endif
+
+// nodejsHandleRelease( handle ) is called after the wolfcrypt free function,
+// the memory itself stays valid until the Buffer is collected
+Napi::Number nodejsHandleRelease(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  void* data = info[0].As<Napi::Uint8Array>().Data();
+  std::lock_guard<std::mutex> guard( handles_lock );
+  auto it = handles.find( data );
+
+  if ( it == handles.end() )
+  {
+    return Napi::Number::New( env, BAD_FUNC_ARG );
+  }
+
+  it->second.released = true;
+
+  return Napi::Number::New( env, 0 );
+}
+
+// nodejsHandleStats() returns the number of native handles that have not been
+// collected yet and the bytes they hold
+Napi::Object nodejsHandleStats(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New( env );
+  size_t live;
+
+  {
+    std::lock_guard<std::mutex> guard( handles_lock );
+
+    live = handles.size();
+  }
+
+  stats.Set( "live", Napi::Number::New( env, live ) );
+  stats.Set( "bytes", Napi::Number::New( env, handles_bytes.load() ) );
+
+  return stats;
+}
+
+// nodejsPoolStats() returns the free list limit, how many released structs are
+// waiting for reuse and the bytes they hold, and hits and misses per type
+Napi::Object nodejsPoolStats(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New( env );
+  Napi::Object types = Napi::Object::New( env );
+  size_t pooled = 0;
+  size_t pooled_bytes = 0;
+  size_t limit;
+
+  {
+    std::lock_guard<std::mutex> guard( handles_lock );
+
+    for ( auto& entry : pool_free )
+    {
+      pooled += entry.second.size();
+      pooled_bytes += entry.first * entry.second.size();
+    }
+
+    limit = pool_limit;
+  }
+
+  for ( int i = 0; i < NATIVE_TYPE_COUNT; i++ )
+  {
+    Napi::Object type = Napi::Object::New( env );
+
+    type.Set( "hits", Napi::Number::New( env, pool_hits[i].load() ) );
+    type.Set( "misses", Napi::Number::New( env, pool_misses[i].load() ) );
+    types.Set( pool_names[i], type );
+  }
+
+  stats.Set( "limit", Napi::Number::New( env, limit ) );
+  stats.Set( "pooled", Napi::Number::New( env, pooled ) );
+  stats.Set( "bytes", Napi::Number::New( env, pooled_bytes ) );
+  stats.Set( "types", types );
+
+  return stats;
+}
+
+// nodejsPoolLimit( [limit] ) sets how many released structs of one size are
+// kept when given, 0 turns pooling off, and returns the limit
+Napi::Number nodejsPoolLimit(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  std::lock_guard<std::mutex> guard( handles_lock );
+
+  if ( info.Length() > 0 && info[0].IsNumber() )
+  {
+    pool_limit = info[0].As<Napi::Number>().Uint32Value();
+
+    for ( auto& entry : pool_free )
+    {
+      while ( entry.second.size() > pool_limit )
+      {
+        free( entry.second.back() );
+        entry.second.pop_back();
+      }
+    }
+  }
+
+  return Napi::Number::New( env, pool_limit );
+}
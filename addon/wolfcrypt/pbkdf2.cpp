@@ -19,6 +19,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 #include "./h/pbkdf2.h"
+#include <cstring>
+#include <vector>
 
 Napi::Number bind_wc_PBKDF2(const Napi::CallbackInfo& info)
 {
@@ -37,3 +39,169 @@ Napi::Number bind_wc_PBKDF2(const Napi::CallbackInfo& info)
 
   return Napi::Number::New( env, ret );
 }
+
+// the password and salt are copied so the js buffers can be reused or
+// collected while the job waits in the pool
+class wc_PBKDF2_job : public wolfcrypt_pool_job
+{
+  public:
+    wc_PBKDF2_job( Napi::Env env, Napi::Function& callback, uint8_t* passwd, int p_len, uint8_t* salt, int s_len, int iterations, int k_len, int type_h )
+      : wolfcrypt_pool_job( env, callback ),
+        passwd( passwd, passwd + p_len ),
+        salt( salt, salt + s_len ),
+        out( k_len ),
+        iterations( iterations ),
+        type_h( type_h ),
+        ret( 0 )
+    {
+    }
+
+    ~wc_PBKDF2_job()
+    {
+      memset( passwd.data(), 0, passwd.size() );
+      memset( out.data(), 0, out.size() );
+    }
+
+    void execute()
+    {
+      ret = wc_PBKDF2( out.data(), passwd.data(), passwd.size(), salt.data(), salt.size(), iterations, out.size(), type_h );
+    }
+
+    void complete( Napi::Env env, Napi::Function callback )
+    {
+      if ( ret != 0 )
+      {
+        callback.Call( { env.Undefined(), Napi::Number::New( env, ret ) } );
+
+        return;
+      }
+
+      callback.Call( { env.Undefined(), Napi::Number::New( env, ret ), Napi::Buffer<uint8_t>::Copy( env, out.data(), out.size() ) } );
+    }
+
+  private:
+    std::vector<uint8_t> passwd;
+    std::vector<uint8_t> salt;
+    std::vector<uint8_t> out;
+    int iterations;
+    int type_h;
+    int ret;
+};
+
+// wc_PBKDF2_async( passwd, p_len, salt, s_len, iterations, k_len, type_h, cb )
+// runs on the wolfcrypt thread pool, cb gets ( undefined, ret, key ), the
+// lengths are checked before the job copies anything
+void bind_wc_PBKDF2_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array passwd_arr = info[0].As<Napi::Uint8Array>();
+  int p_len = info[1].As<Napi::Number>().Int32Value();
+  Napi::Uint8Array salt_arr = info[2].As<Napi::Uint8Array>();
+  int s_len = info[3].As<Napi::Number>().Int32Value();
+  int iterations = info[4].As<Napi::Number>().Int32Value();
+  int k_len = info[5].As<Napi::Number>().Int32Value();
+  int type_h = info[6].As<Napi::Number>().Int32Value();
+  Napi::Function callback = info[7].As<Napi::Function>();
+
+  if ( k_len <= 0 || iterations <= 0 || p_len < 0 || s_len < 0 ||
+    (size_t)p_len > passwd_arr.ByteLength() || (size_t)s_len > salt_arr.ByteLength() )
+  {
+    callback.Call( { env.Undefined(), Napi::Number::New( env, BAD_FUNC_ARG ) } );
+
+    return;
+  }
+
+  uint8_t* passwd = passwd_arr.Data();
+  uint8_t* salt = salt_arr.Data();
+
+  wolfcrypt_pool_queue( std::make_shared<wc_PBKDF2_job>( env, callback, passwd, p_len, salt, s_len, iterations, k_len, type_h ) );
+}
+
+// the packed inputs are copied for the same reason as in wc_PBKDF2_job, the
+// keys are written next to each other into one output of count * k_len bytes
+class wc_PBKDF2_batch : public wolfcrypt_pool_batch
+{
+  public:
+    wc_PBKDF2_batch( Napi::Uint8Array& passwds_arr, Napi::Uint32Array& passwd_offsets_arr, Napi::Uint8Array& salts_arr,
+      Napi::Uint32Array& salt_offsets_arr, Napi::Uint32Array& iterations_arr, int k_len, int type_h )
+      : wolfcrypt_pool_batch( iterations_arr.ElementLength() ),
+        passwds( passwds_arr.Data(), passwds_arr.Data() + passwds_arr.ByteLength() ),
+        passwd_offsets( passwd_offsets_arr.Data(), passwd_offsets_arr.Data() + passwd_offsets_arr.ElementLength() ),
+        salts( salts_arr.Data(), salts_arr.Data() + salts_arr.ByteLength() ),
+        salt_offsets( salt_offsets_arr.Data(), salt_offsets_arr.Data() + salt_offsets_arr.ElementLength() ),
+        iterations( iterations_arr.Data(), iterations_arr.Data() + iterations_arr.ElementLength() ),
+        out( count * k_len ),
+        k_len( k_len ),
+        type_h( type_h )
+    {
+    }
+
+    ~wc_PBKDF2_batch()
+    {
+      memset( passwds.data(), 0, passwds.size() );
+      memset( out.data(), 0, out.size() );
+    }
+
+    int run( size_t index ) override
+    {
+      uint32_t p_start = passwd_offsets[index];
+      uint32_t s_start = salt_offsets[index];
+
+      return wc_PBKDF2( out.data() + index * k_len, passwds.data() + p_start, passwd_offsets[index + 1] - p_start,
+        salts.data() + s_start, salt_offsets[index + 1] - s_start, iterations[index], k_len, type_h );
+    }
+
+    Napi::Value result( Napi::Env env ) override
+    {
+      return Napi::Buffer<uint8_t>::Copy( env, out.data(), out.size() );
+    }
+
+  private:
+    std::vector<uint8_t> passwds;
+    std::vector<uint32_t> passwd_offsets;
+    std::vector<uint8_t> salts;
+    std::vector<uint32_t> salt_offsets;
+    std::vector<uint32_t> iterations;
+    std::vector<uint8_t> out;
+    int k_len;
+    int type_h;
+};
+
+// wc_PBKDF2_batch( passwds, passwdOffsets, salts, saltOffsets, iterations, k_len, type_h, progress, cb )
+// passwords and salts are packed with count + 1 offsets, iterations is a
+// Uint32Array with one count per key, progress may be null
+void bind_wc_PBKDF2_batch(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array passwds = info[0].As<Napi::Uint8Array>();
+  Napi::Uint32Array passwd_offsets = info[1].As<Napi::Uint32Array>();
+  Napi::Uint8Array salts = info[2].As<Napi::Uint8Array>();
+  Napi::Uint32Array salt_offsets = info[3].As<Napi::Uint32Array>();
+  Napi::Uint32Array iterations = info[4].As<Napi::Uint32Array>();
+  int k_len = info[5].As<Napi::Number>().Int32Value();
+  int type_h = info[6].As<Napi::Number>().Int32Value();
+  Napi::Function callback = info[8].As<Napi::Function>();
+  size_t count = iterations.ElementLength();
+
+  if ( k_len <= 0 || passwd_offsets.ElementLength() != count + 1 || salt_offsets.ElementLength() != count + 1 ||
+    passwd_offsets[count] > passwds.ByteLength() || salt_offsets[count] > salts.ByteLength() )
+  {
+    callback.Call( { env.Undefined(), Napi::Number::New( env, BAD_FUNC_ARG ) } );
+
+    return;
+  }
+
+  for ( size_t i = 0; i < count; i++ )
+  {
+    if ( passwd_offsets[i] > passwd_offsets[i + 1] || salt_offsets[i] > salt_offsets[i + 1] )
+    {
+      callback.Call( { env.Undefined(), Napi::Number::New( env, BAD_FUNC_ARG ) } );
+
+      return;
+    }
+  }
+
+  std::shared_ptr<wc_PBKDF2_batch> batch = std::make_shared<wc_PBKDF2_batch>( passwds, passwd_offsets, salts, salt_offsets, iterations, k_len, type_h );
+
+  wolfcrypt_pool_batch_queue( env, batch, callback, info[7] );
+}
@@ -203,7 +203,6 @@ Napi::Number bind_wc_PKCS7_EncodeSignedData(const Napi::CallbackInfo& info)
 {
   int ret;
   Napi::Env env = info.Env();
-  WC_RNG rng;
   PKCS7* pkcs7 = (PKCS7*)( info[0].As<Napi::Uint8Array>().Data() );
   uint8_t* data = info[1].As<Napi::Uint8Array>().Data();
   int data_size = info[2].As<Napi::Number>().Int32Value();
@@ -214,8 +213,6 @@ Napi::Number bind_wc_PKCS7_EncodeSignedData(const Napi::CallbackInfo& info)
   uint8_t* output = info[7].As<Napi::Uint8Array>().Data();
   int output_size = info[8].As<Napi::Number>().Int32Value();
 
-  wc_InitRng( &rng );
-
   ret = wc_PKCS7_SetSignerIdentifierType( pkcs7, CMS_SKID );
 
   if ( ret != 0 )
@@ -230,11 +227,11 @@ Napi::Number bind_wc_PKCS7_EncodeSignedData(const Napi::CallbackInfo& info)
   pkcs7->encryptOID = key_sum;
   pkcs7->publicKeyOID = key_sum;
   pkcs7->hashOID = hash_sum;
-  pkcs7->rng = &rng;
+  pkcs7->rng = wolfcrypt_thread_rng();
 
   ret = wc_PKCS7_EncodeSignedData( pkcs7, output, output_size );
 
-  wc_FreeRng( &rng );
+  pkcs7->rng = NULL;
 
   return Napi::Number::New( env, ret );
 }
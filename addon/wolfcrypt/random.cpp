@@ -19,6 +19,60 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 #include "./h/random.h"
+#include <atomic>
+
+static std::atomic<unsigned long> rng_created( 0 );
+static std::atomic<unsigned long> rng_reused( 0 );
+
+class wolfcrypt_rng_holder
+{
+  public:
+    ~wolfcrypt_rng_holder()
+    {
+      if ( rng != NULL )
+      {
+        wc_rng_free( rng );
+      }
+    }
+
+    WC_RNG* rng = NULL;
+};
+
+static thread_local wolfcrypt_rng_holder thread_rng;
+
+// one DRBG per thread, seeded the first time the thread needs it and reused
+// by every key operation that runs on it afterwards, the main thread and the
+// libuv pool threads live for the whole process so this is seeded a handful
+// of times instead of once per call
+WC_RNG* wolfcrypt_thread_rng()
+{
+  if ( thread_rng.rng == NULL )
+  {
+    thread_rng.rng = wc_rng_new( NULL, 0, NULL );
+
+    if ( thread_rng.rng != NULL )
+    {
+      rng_created++;
+    }
+  }
+  else
+  {
+    rng_reused++;
+  }
+
+  return thread_rng.rng;
+}
+
+Napi::Object nodejsRngStats(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New( env );
+
+  stats.Set( "created", Napi::Number::New( env, (double)rng_created.load() ) );
+  stats.Set( "reused", Napi::Number::New( env, (double)rng_reused.load() ) );
+
+  return stats;
+}
 
 Napi::Number sizeof_WC_RNG(const Napi::CallbackInfo& info)
 {
@@ -20,6 +20,20 @@
  */
 #include "./h/rsa.h"
 
+// keys don't own an rng, each operation uses the one of the thread it runs on
+// and points the key at it for blinding, must be called on the key of a
+// wolfcrypt_key_use, which is locked or a copy only this operation has
+static WC_RNG* rsa_thread_rng( RsaKey* rsa )
+{
+  WC_RNG* rng = wolfcrypt_thread_rng();
+
+#ifdef WC_RSA_BLINDING
+  wc_RsaSetRNG( rsa, rng );
+#endif
+
+  return rng;
+}
+
 Napi::Number sizeof_RsaKey(const Napi::CallbackInfo& info)
 {
   Napi::Env env = info.Env();
@@ -27,13 +41,91 @@ Napi::Number sizeof_RsaKey(const Napi::CallbackInfo& info)
   return Napi::Number::New( env, sizeof( RsaKey ) );
 }
 
+// padding for the _ex functions, "PKCSV15", "OAEP", "PSS" or "NONE"
+Napi::Number typeof_RsaPad(const Napi::CallbackInfo& info)
+{
+  int ret = -1;
+  Napi::Env env = info.Env();
+  std::string type = info[0].As<Napi::String>().Utf8Value();
+
+  if ( strcmp( type.c_str(), "PKCSV15" ) == 0 )
+  {
+    ret = WC_RSA_PKCSV15_PAD;
+  }
+#ifndef WC_NO_RSA_OAEP
+  else if ( strcmp( type.c_str(), "OAEP" ) == 0 )
+  {
+    ret = WC_RSA_OAEPPAD;
+  }
+#endif
+#ifdef WC_RSA_PSS
+  else if ( strcmp( type.c_str(), "PSS" ) == 0 )
+  {
+    ret = WC_RSA_PSSPAD;
+  }
+#endif
+#ifdef WC_RSA_NO_PADDING
+  else if ( strcmp( type.c_str(), "NONE" ) == 0 )
+  {
+    ret = WC_RSA_NOPAD;
+  }
+#endif
+
+  return Napi::Number::New( env, ret );
+}
+
+// mask generation function for OAEP and PSS, takes the same names as
+// typeof_Hash, the hash and the mgf are normally the same
+Napi::Number typeof_RsaMgf(const Napi::CallbackInfo& info)
+{
+  int ret = -1;
+  Napi::Env env = info.Env();
+  std::string type = info[0].As<Napi::String>().Utf8Value();
+
+  if ( strcmp( type.c_str(), "SHA" ) == 0 )
+  {
+    ret = WC_MGF1SHA1;
+  }
+  else if ( strcmp( type.c_str(), "SHA224" ) == 0 )
+  {
+    ret = WC_MGF1SHA224;
+  }
+  else if ( strcmp( type.c_str(), "SHA256" ) == 0 )
+  {
+    ret = WC_MGF1SHA256;
+  }
+  else if ( strcmp( type.c_str(), "SHA384" ) == 0 )
+  {
+    ret = WC_MGF1SHA384;
+  }
+  else if ( strcmp( type.c_str(), "SHA512" ) == 0 )
+  {
+    ret = WC_MGF1SHA512;
+  }
+#ifndef WOLFSSL_NOSHA512_224
+  else if ( strcmp( type.c_str(), "SHA512_224" ) == 0 )
+  {
+    ret = WC_MGF1SHA512_224;
+  }
+#endif
+#ifndef WOLFSSL_NOSHA512_256
+  else if ( strcmp( type.c_str(), "SHA512_256" ) == 0 )
+  {
+    ret = WC_MGF1SHA512_256;
+  }
+#endif
+
+  return Napi::Number::New( env, ret );
+}
+
 Napi::Number bind_wc_RsaEncryptSize(const Napi::CallbackInfo& info)
 {
   int ret;
   Napi::Env env = info.Env();
   RsaKey* rsa = (RsaKey*)( info[0].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
 
-  ret = wc_RsaEncryptSize( rsa );
+  ret = wc_RsaEncryptSize( use.key );
 
   return Napi::Number::New( env, ret );
 }
@@ -45,9 +137,6 @@ Napi::Number bind_wc_InitRsaKey(const Napi::CallbackInfo& info)
   RsaKey* rsa = (RsaKey*)( info[0].As<Napi::Uint8Array>().Data() );
 
   ret = wc_InitRsaKey( rsa, NULL );
-#ifdef WC_RSA_BLINDING
-  rsa->rng = wc_rng_new( NULL, 0, NULL );
-#endif
 
   return Napi::Number::New( env, ret );
 }
@@ -57,28 +146,21 @@ Napi::Number bind_wc_MakeRsaKey(const Napi::CallbackInfo& info)
   int ret;
   Napi::Env env = info.Env();
   RsaKey* rsa = (RsaKey*)( info[0].As<Napi::Uint8Array>().Data() );
-#ifdef WC_RSA_BLINDING
-  WC_RNG* rng = rsa->rng;
-#else
-  WC_RNG* rng = wc_rng_new( NULL, 0, NULL );
-#endif
   int size = info[1].As<Napi::Number>().Int32Value();
   long e = info[2].As<Napi::Number>().Int64Value();
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( rsa ) );
+  WC_RNG* rng = rsa_thread_rng( rsa );
 
   ret = wc_MakeRsaKey( rsa, size, e, rng );
 
-#ifndef WC_RSA_BLINDING
-  wc_rng_free( rng );
-#endif
-
   return Napi::Number::New( env, ret );
 }
 
 class wc_MakeRsaKeyAsyncWorker : public Napi::AsyncWorker
 {
   public:
-    wc_MakeRsaKeyAsyncWorker( Napi::Function& callback, RsaKey* rsa, int size, long e )
-      : Napi::AsyncWorker( callback ), rsa( rsa ), size( size ), e( e )
+    wc_MakeRsaKeyAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, RsaKey* rsa, int size, long e )
+      : Napi::AsyncWorker( callback ), rsa( rsa ), size( size ), e( e ), stats( info )
     {
     }
 
@@ -86,17 +168,13 @@ class wc_MakeRsaKeyAsyncWorker : public Napi::AsyncWorker
 
     void Execute() override
     {
-#ifdef WC_RSA_BLINDING
-      WC_RNG* rng = rsa->rng;
-#else
-      WC_RNG* rng = wc_rng_new( NULL, 0, NULL );
-#endif
+      stats.start();
 
-      ret = wc_MakeRsaKey( rsa, size, e, rng );
+      std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( rsa ) );
+      WC_RNG* rng = rsa_thread_rng( rsa );
 
-#ifndef WC_RSA_BLINDING
-      wc_rng_free( rng );
-#endif
+      ret = wc_MakeRsaKey( rsa, size, e, rng );
+      stats.finish( ret );
     }
 
     void OnOK() override
@@ -109,6 +187,7 @@ class wc_MakeRsaKeyAsyncWorker : public Napi::AsyncWorker
     int size;
     long e;
     int ret;
+    wolfcrypt_stats_async stats;
 };
 
 // uses the above async worker to make the key, callback will be called
@@ -121,7 +200,7 @@ Napi::Value wc_MakeRsaKey_async(const Napi::CallbackInfo& info)
   long e = info[2].As<Napi::Number>().Int64Value();
   Napi::Function callback = info[3].As<Napi::Function>();
 
-  wc_MakeRsaKeyAsyncWorker* key_worker = new wc_MakeRsaKeyAsyncWorker( callback, rsa, size, e );
+  wc_MakeRsaKeyAsyncWorker* key_worker = new wc_MakeRsaKeyAsyncWorker( callback, info, rsa, size, e );
   key_worker->Queue();
 
   return env.Undefined();
@@ -132,8 +211,9 @@ Napi::Number RsaPrivateDerSize(const Napi::CallbackInfo& info)
   int ret;
   Napi::Env env = info.Env();
   RsaKey* rsa = (RsaKey*)( info[0].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
 
-  ret = wc_RsaKeyToDer( rsa, NULL, 0 );
+  ret = wc_RsaKeyToDer( use.key, NULL, 0 );
 
   return Napi::Number::New( env, ret );
 }
@@ -145,8 +225,9 @@ Napi::Number bind_wc_RsaKeyToDer(const Napi::CallbackInfo& info)
   RsaKey* rsa = (RsaKey*)( info[0].As<Napi::Uint8Array>().Data() );
   uint8_t* out = info[1].As<Napi::Uint8Array>().Data();
   int outSz = info[2].As<Napi::Number>().Int32Value();
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
 
-  ret = wc_RsaKeyToDer( rsa, out, outSz );
+  ret = wc_RsaKeyToDer( use.key, out, outSz );
 
   return Napi::Number::New( env, ret );
 }
@@ -156,8 +237,9 @@ Napi::Number RsaPublicDerSize(const Napi::CallbackInfo& info)
   int ret;
   Napi::Env env = info.Env();
   RsaKey* rsa = (RsaKey*)( info[0].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
 
-  ret = wc_RsaKeyToPublicDer( rsa, NULL, 0 );
+  ret = wc_RsaKeyToPublicDer( use.key, NULL, 0 );
 
   return Napi::Number::New( env, ret );
 }
@@ -169,8 +251,9 @@ Napi::Number bind_wc_RsaKeyToPublicDer(const Napi::CallbackInfo& info)
   RsaKey* rsa = (RsaKey*)( info[0].As<Napi::Uint8Array>().Data() );
   uint8_t* out = info[1].As<Napi::Uint8Array>().Data();
   int outSz = info[2].As<Napi::Number>().Int32Value();
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
 
-  ret = wc_RsaKeyToPublicDer( rsa, out, outSz );
+  ret = wc_RsaKeyToPublicDer( use.key, out, outSz );
 
   return Napi::Number::New( env, ret );
 }
@@ -203,6 +286,44 @@ Napi::Number bind_wc_RsaPublicKeyDecode(const Napi::CallbackInfo& info)
   return Napi::Number::New( env, ret );
 }
 
+wolfcrypt_key_cache<RsaKey>& wolfcrypt_rsa_key_cache()
+{
+  static wolfcrypt_key_cache<RsaKey>* cache = new wolfcrypt_key_cache<RsaKey>(
+    []( RsaKey* rsa ) { return wc_InitRsaKey( rsa, NULL ); },
+    []( RsaKey* rsa ) { wc_FreeRsaKey( rsa ); } );
+
+  return *cache;
+}
+
+// nodejsRsaKeyCached( in, inSz, isPrivate ) returns a handle to the key
+// decoded from the der in, shared with every other handle for the same der,
+// or an error code, operations on it run on copies of the key checked out
+// from the cache
+Napi::Value nodejsRsaKeyCached(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Uint8Array in = info[0].As<Napi::Uint8Array>();
+  int inSz = info[1].As<Napi::Number>().Int32Value();
+  bool is_private = info[2].As<Napi::Boolean>().Value();
+  wolfcrypt_key_cache<RsaKey>::entry_ptr rsa;
+  int ret;
+
+  if ( inSz < 0 || (size_t)inSz > in.ByteLength() )
+  {
+    return Napi::Number::New( env, BAD_FUNC_ARG );
+  }
+
+  ret = wolfcrypt_rsa_key_cache().get( in.Data(), inSz, is_private ? 'd' : 'p',
+    is_private ? wc_RsaPrivateKeyDecode : wc_RsaPublicKeyDecode, rsa );
+
+  if ( ret != 0 )
+  {
+    return Napi::Number::New( env, ret );
+  }
+
+  return wolfcrypt_rsa_key_cache().handle( env, rsa );
+}
+
 Napi::Number bind_wc_RsaPublicEncrypt(const Napi::CallbackInfo& info)
 {
   int ret;
@@ -212,17 +333,10 @@ Napi::Number bind_wc_RsaPublicEncrypt(const Napi::CallbackInfo& info)
   uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
   int out_len = info[3].As<Napi::Number>().Int32Value();
   RsaKey* rsa = (RsaKey*)( info[4].As<Napi::Uint8Array>().Data() );
-#ifdef WC_RSA_BLINDING
-  WC_RNG* rng = rsa->rng;
-#else
-  WC_RNG* rng = wc_rng_new( NULL, 0, NULL );
-#endif
-
-  ret = wc_RsaPublicEncrypt( in, in_len, out, out_len, rsa, rng );
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+  WC_RNG* rng = rsa_thread_rng( use.key );
 
-#ifndef WC_RSA_BLINDING
-  wc_rng_free( rng );
-#endif
+  ret = wc_RsaPublicEncrypt( in, in_len, out, out_len, use.key, rng );
 
   return Napi::Number::New( env, ret );
 }
@@ -236,8 +350,10 @@ Napi::Number bind_wc_RsaPrivateDecrypt(const Napi::CallbackInfo& info)
   uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
   int out_len = info[3].As<Napi::Number>().Int32Value();
   RsaKey* rsa = (RsaKey*)( info[4].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+  rsa_thread_rng( use.key );
 
-  ret = wc_RsaPrivateDecrypt( in, in_len, out, out_len, rsa );
+  ret = wc_RsaPrivateDecrypt( in, in_len, out, out_len, use.key );
 
   return Napi::Number::New( env, ret );
 }
@@ -251,17 +367,10 @@ Napi::Number bind_wc_RsaSSL_Sign(const Napi::CallbackInfo& info)
   uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
   int out_len = info[3].As<Napi::Number>().Int32Value();
   RsaKey* rsa = (RsaKey*)( info[4].As<Napi::Uint8Array>().Data() );
-#ifdef WC_RSA_BLINDING
-  WC_RNG* rng = rsa->rng;
-#else
-  WC_RNG* rng = wc_rng_new( NULL, 0, NULL );
-#endif
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+  WC_RNG* rng = rsa_thread_rng( use.key );
 
-  ret = wc_RsaSSL_Sign( in, in_len, out, out_len, rsa, rng );
-
-#ifndef WC_RSA_BLINDING
-  wc_rng_free( rng );
-#endif
+  ret = wc_RsaSSL_Sign( in, in_len, out, out_len, use.key, rng );
 
   return Napi::Number::New( env, ret );
 }
@@ -275,17 +384,574 @@ Napi::Number bind_wc_RsaSSL_Verify(const Napi::CallbackInfo& info)
   uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
   int out_len = info[3].As<Napi::Number>().Int32Value();
   RsaKey* rsa = (RsaKey*)( info[4].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+
+  ret = wc_RsaSSL_Verify( in, in_len, out, out_len, use.key );
+
+  return Napi::Number::New( env, ret );
+}
+
+#ifndef WC_NO_RSA_OAEP
+// wc_RsaPublicEncrypt_ex( in, in_len, out, out_len, rsa, type, hash, mgf,
+// label, label_len ), type comes from typeof_RsaPad, hash from typeof_Hash and
+// mgf from typeof_RsaMgf, label may be null for an empty label
+Napi::Number bind_wc_RsaPublicEncrypt_ex(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  uint8_t* in = info[0].As<Napi::Uint8Array>().Data();
+  int in_len = info[1].As<Napi::Number>().Int32Value();
+  uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
+  int out_len = info[3].As<Napi::Number>().Int32Value();
+  RsaKey* rsa = (RsaKey*)( info[4].As<Napi::Uint8Array>().Data() );
+  int type = info[5].As<Napi::Number>().Int32Value();
+  enum wc_HashType hash = (enum wc_HashType)info[6].As<Napi::Number>().Int32Value();
+  int mgf = info[7].As<Napi::Number>().Int32Value();
+  uint8_t* label = NULL;
+  int label_len = 0;
+
+  if ( info[8].IsTypedArray() )
+  {
+    label = info[8].As<Napi::Uint8Array>().Data();
+    label_len = info[9].As<Napi::Number>().Int32Value();
+  }
 
-  ret = wc_RsaSSL_Verify( in, in_len, out, out_len, rsa );
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+  WC_RNG* rng = rsa_thread_rng( use.key );
+
+  ret = wc_RsaPublicEncrypt_ex( in, in_len, out, out_len, use.key, rng, type, hash, mgf, label, label_len );
 
   return Napi::Number::New( env, ret );
 }
 
+// wc_RsaPrivateDecrypt_ex takes the same arguments as wc_RsaPublicEncrypt_ex
+Napi::Number bind_wc_RsaPrivateDecrypt_ex(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  uint8_t* in = info[0].As<Napi::Uint8Array>().Data();
+  int in_len = info[1].As<Napi::Number>().Int32Value();
+  uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
+  int out_len = info[3].As<Napi::Number>().Int32Value();
+  RsaKey* rsa = (RsaKey*)( info[4].As<Napi::Uint8Array>().Data() );
+  int type = info[5].As<Napi::Number>().Int32Value();
+  enum wc_HashType hash = (enum wc_HashType)info[6].As<Napi::Number>().Int32Value();
+  int mgf = info[7].As<Napi::Number>().Int32Value();
+  uint8_t* label = NULL;
+  int label_len = 0;
+
+  if ( info[8].IsTypedArray() )
+  {
+    label = info[8].As<Napi::Uint8Array>().Data();
+    label_len = info[9].As<Napi::Number>().Int32Value();
+  }
+
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+  rsa_thread_rng( use.key );
+
+  ret = wc_RsaPrivateDecrypt_ex( in, in_len, out, out_len, use.key, type, hash, mgf, label, label_len );
+
+  return Napi::Number::New( env, ret );
+}
+#endif
+
+#ifdef WC_RSA_PSS
+// wc_RsaPSS_Sign( in, in_len, out, out_len, hash, mgf, rsa ), in is the
+// digest of the message and the salt is as long as the digest
+Napi::Number bind_wc_RsaPSS_Sign(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  uint8_t* in = info[0].As<Napi::Uint8Array>().Data();
+  int in_len = info[1].As<Napi::Number>().Int32Value();
+  uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
+  int out_len = info[3].As<Napi::Number>().Int32Value();
+  enum wc_HashType hash = (enum wc_HashType)info[4].As<Napi::Number>().Int32Value();
+  int mgf = info[5].As<Napi::Number>().Int32Value();
+  RsaKey* rsa = (RsaKey*)( info[6].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+  WC_RNG* rng = rsa_thread_rng( use.key );
+
+  ret = wc_RsaPSS_Sign( in, in_len, out, out_len, hash, mgf, use.key, rng );
+
+  return Napi::Number::New( env, ret );
+}
+
+// wc_RsaPSS_Verify( in, in_len, out, out_len, hash, mgf, rsa ) writes the
+// decoded PSS block to out, which still has to be checked against the digest
+// with wc_RsaPSS_CheckPadding, nodejsRsaPSS_VerifyHash does both
+Napi::Number bind_wc_RsaPSS_Verify(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  uint8_t* in = info[0].As<Napi::Uint8Array>().Data();
+  int in_len = info[1].As<Napi::Number>().Int32Value();
+  uint8_t* out = info[2].As<Napi::Uint8Array>().Data();
+  int out_len = info[3].As<Napi::Number>().Int32Value();
+  enum wc_HashType hash = (enum wc_HashType)info[4].As<Napi::Number>().Int32Value();
+  int mgf = info[5].As<Napi::Number>().Int32Value();
+  RsaKey* rsa = (RsaKey*)( info[6].As<Napi::Uint8Array>().Data() );
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+
+  ret = wc_RsaPSS_Verify( in, in_len, out, out_len, hash, mgf, use.key );
+
+  return Napi::Number::New( env, ret );
+}
+
+// hashes msg and checks the PSS signature against the digest in one call,
+// the decoded block only lives in a scratch buffer on this side, returns 1
+// for a valid signature, 0 for an invalid one and an error code otherwise
+static int rsa_pss_verify_hash( const uint8_t* sig, int sig_len, const uint8_t* msg,
+  int msg_len, enum wc_HashType hash, int mgf, RsaKey* rsa )
+{
+  int ret;
+  uint8_t digest[WC_MAX_DIGEST_SIZE];
+  int digest_len = wc_HashGetDigestSize( hash );
+  std::vector<uint8_t> decoded;
+
+  if ( digest_len <= 0 )
+  {
+    return BAD_FUNC_ARG;
+  }
+
+  ret = wc_Hash( hash, msg, msg_len, digest, sizeof( digest ) );
+
+  if ( ret != 0 )
+  {
+    return ret;
+  }
+
+  wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+
+  ret = wc_RsaEncryptSize( use.key );
+
+  if ( ret <= 0 )
+  {
+    return ret;
+  }
+
+  decoded.resize( ret );
+
+  ret = wc_RsaPSS_VerifyCheck( (byte*)sig, sig_len, decoded.data(), decoded.size(),
+    digest, digest_len, hash, mgf, use.key );
+
+  if ( ret == BAD_PADDING_E || ret == PSS_SALTLEN_E || ret == RSA_OUT_OF_RANGE_E )
+  {
+    return 0;
+  }
+
+  return ret < 0 ? ret : 1;
+}
+
+// nodejsRsaPSS_VerifyHash( sig, sig_len, msg, msg_len, hash, mgf, rsa )
+Napi::Number nodejsRsaPSS_VerifyHash(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  uint8_t* sig = info[0].As<Napi::Uint8Array>().Data();
+  int sig_len = info[1].As<Napi::Number>().Int32Value();
+  uint8_t* msg = info[2].As<Napi::Uint8Array>().Data();
+  int msg_len = info[3].As<Napi::Number>().Int32Value();
+  enum wc_HashType hash = (enum wc_HashType)info[4].As<Napi::Number>().Int32Value();
+  int mgf = info[5].As<Napi::Number>().Int32Value();
+  RsaKey* rsa = (RsaKey*)( info[6].As<Napi::Uint8Array>().Data() );
+
+  ret = rsa_pss_verify_hash( sig, sig_len, msg, msg_len, hash, mgf, rsa );
+
+  return Napi::Number::New( env, ret );
+}
+#endif
+
+// base for the rsa operations that run on the thread pool, the arguments
+// match the sync bindings ( in, in_len, out, out_len, rsa ) and references
+// are held on all three buffers so they stay alive until the worker is done,
+// rsa_index is for the functions that take more arguments before the key
+class RsaAsyncWorker : public Napi::AsyncWorker
+{
+  public:
+    RsaAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info, int rsa_index = 4 )
+      : Napi::AsyncWorker( callback ), stats( info )
+    {
+      Napi::Uint8Array in_arr = info[0].As<Napi::Uint8Array>();
+      Napi::Uint8Array out_arr = info[2].As<Napi::Uint8Array>();
+      Napi::Uint8Array rsa_arr = info[rsa_index].As<Napi::Uint8Array>();
+
+      in = in_arr.Data();
+      in_len = info[1].As<Napi::Number>().Int32Value();
+      out = out_arr.Data();
+      out_len = info[3].As<Napi::Number>().Int32Value();
+      rsa = (RsaKey*)( rsa_arr.Data() );
+
+      in_ref = Napi::Persistent( in_arr );
+      out_ref = Napi::Persistent( out_arr );
+      rsa_ref = Napi::Persistent( rsa_arr );
+    }
+
+    virtual ~RsaAsyncWorker() {}
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope(Env());
+      Callback().Call({Env().Undefined(), Napi::Number::New(Env(), ret)});
+    }
+  protected:
+    uint8_t* in;
+    int in_len;
+    uint8_t* out;
+    int out_len;
+    RsaKey* rsa;
+    int ret;
+    // Execute calls start before taking the key lock and finish with ret
+    wolfcrypt_stats_async stats;
+  private:
+    Napi::Reference<Napi::Uint8Array> in_ref;
+    Napi::Reference<Napi::Uint8Array> out_ref;
+    Napi::Reference<Napi::Uint8Array> rsa_ref;
+};
+
+class wc_RsaPublicEncryptAsyncWorker : public RsaAsyncWorker
+{
+  public:
+    wc_RsaPublicEncryptAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaAsyncWorker( callback, info )
+    {
+    }
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+      WC_RNG* rng = rsa_thread_rng( use.key );
+
+      ret = wc_RsaPublicEncrypt( in, in_len, out, out_len, use.key, rng );
+      stats.finish( ret );
+    }
+};
+
+class wc_RsaPrivateDecryptAsyncWorker : public RsaAsyncWorker
+{
+  public:
+    wc_RsaPrivateDecryptAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaAsyncWorker( callback, info )
+    {
+    }
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+      rsa_thread_rng( use.key );
+
+      ret = wc_RsaPrivateDecrypt( in, in_len, out, out_len, use.key );
+      stats.finish( ret );
+    }
+};
+
+class wc_RsaSSL_SignAsyncWorker : public RsaAsyncWorker
+{
+  public:
+    wc_RsaSSL_SignAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaAsyncWorker( callback, info )
+    {
+    }
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+      WC_RNG* rng = rsa_thread_rng( use.key );
+
+      ret = wc_RsaSSL_Sign( in, in_len, out, out_len, use.key, rng );
+      stats.finish( ret );
+    }
+};
+
+class wc_RsaSSL_VerifyAsyncWorker : public RsaAsyncWorker
+{
+  public:
+    wc_RsaSSL_VerifyAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaAsyncWorker( callback, info )
+    {
+    }
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+
+      ret = wc_RsaSSL_Verify( in, in_len, out, out_len, use.key );
+      stats.finish( ret );
+    }
+};
+
+#ifndef WC_NO_RSA_OAEP
+// the _ex functions add ( type, hash, mgf, label, label_len ) after the key,
+// the label is optional and referenced like the other buffers
+class RsaExAsyncWorker : public RsaAsyncWorker
+{
+  public:
+    RsaExAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaAsyncWorker( callback, info )
+    {
+      type = info[5].As<Napi::Number>().Int32Value();
+      hash = (enum wc_HashType)info[6].As<Napi::Number>().Int32Value();
+      mgf = info[7].As<Napi::Number>().Int32Value();
+      label = NULL;
+      label_len = 0;
+
+      if ( info[8].IsTypedArray() )
+      {
+        Napi::Uint8Array label_arr = info[8].As<Napi::Uint8Array>();
+
+        label = label_arr.Data();
+        label_len = info[9].As<Napi::Number>().Int32Value();
+        label_ref = Napi::Persistent( label_arr );
+      }
+    }
+  protected:
+    int type;
+    enum wc_HashType hash;
+    int mgf;
+    uint8_t* label;
+    int label_len;
+  private:
+    Napi::Reference<Napi::Uint8Array> label_ref;
+};
+
+class wc_RsaPublicEncrypt_exAsyncWorker : public RsaExAsyncWorker
+{
+  public:
+    wc_RsaPublicEncrypt_exAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaExAsyncWorker( callback, info )
+    {
+    }
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+      WC_RNG* rng = rsa_thread_rng( use.key );
+
+      ret = wc_RsaPublicEncrypt_ex( in, in_len, out, out_len, use.key, rng, type, hash, mgf, label, label_len );
+      stats.finish( ret );
+    }
+};
+
+class wc_RsaPrivateDecrypt_exAsyncWorker : public RsaExAsyncWorker
+{
+  public:
+    wc_RsaPrivateDecrypt_exAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaExAsyncWorker( callback, info )
+    {
+    }
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+      rsa_thread_rng( use.key );
+
+      ret = wc_RsaPrivateDecrypt_ex( in, in_len, out, out_len, use.key, type, hash, mgf, label, label_len );
+      stats.finish( ret );
+    }
+};
+#endif
+
+#ifdef WC_RSA_PSS
+// the PSS functions take ( in, in_len, out, out_len, hash, mgf, rsa ) like
+// wolfcrypt, so the key comes after the hash and mgf
+class RsaPSSAsyncWorker : public RsaAsyncWorker
+{
+  public:
+    RsaPSSAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaAsyncWorker( callback, info, 6 )
+    {
+      hash = (enum wc_HashType)info[4].As<Napi::Number>().Int32Value();
+      mgf = info[5].As<Napi::Number>().Int32Value();
+    }
+  protected:
+    enum wc_HashType hash;
+    int mgf;
+};
+
+class wc_RsaPSS_SignAsyncWorker : public RsaPSSAsyncWorker
+{
+  public:
+    wc_RsaPSS_SignAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaPSSAsyncWorker( callback, info )
+    {
+    }
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+      WC_RNG* rng = rsa_thread_rng( use.key );
+
+      ret = wc_RsaPSS_Sign( in, in_len, out, out_len, hash, mgf, use.key, rng );
+      stats.finish( ret );
+    }
+};
+
+class wc_RsaPSS_VerifyAsyncWorker : public RsaPSSAsyncWorker
+{
+  public:
+    wc_RsaPSS_VerifyAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaPSSAsyncWorker( callback, info )
+    {
+    }
+
+    void Execute() override
+    {
+      stats.start();
+
+      wolfcrypt_key_use<RsaKey> use( wolfcrypt_rsa_key_cache(), rsa );
+
+      ret = wc_RsaPSS_Verify( in, in_len, out, out_len, hash, mgf, use.key );
+      stats.finish( ret );
+    }
+};
+
+// in is the signature and out the message, which is only read
+class nodejsRsaPSS_VerifyHashAsyncWorker : public RsaPSSAsyncWorker
+{
+  public:
+    nodejsRsaPSS_VerifyHashAsyncWorker( Napi::Function& callback, const Napi::CallbackInfo& info )
+      : RsaPSSAsyncWorker( callback, info )
+    {
+    }
+
+    void Execute() override
+    {
+      stats.start();
+
+      // takes the key itself after hashing
+      ret = rsa_pss_verify_hash( in, in_len, out, out_len, hash, mgf, rsa );
+      stats.finish( ret );
+    }
+};
+#endif
+
+// the async versions take the same arguments as the sync bindings plus a
+// callback, which is called with the return value of the wolfcrypt function
+Napi::Value wc_RsaPublicEncrypt_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[5].As<Napi::Function>();
+
+  wc_RsaPublicEncryptAsyncWorker* worker = new wc_RsaPublicEncryptAsyncWorker( callback, info );
+  worker->Queue();
+
+  return env.Undefined();
+}
+
+Napi::Value wc_RsaPrivateDecrypt_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[5].As<Napi::Function>();
+
+  wc_RsaPrivateDecryptAsyncWorker* worker = new wc_RsaPrivateDecryptAsyncWorker( callback, info );
+  worker->Queue();
+
+  return env.Undefined();
+}
+
+Napi::Value wc_RsaSSL_Sign_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[5].As<Napi::Function>();
+
+  wc_RsaSSL_SignAsyncWorker* worker = new wc_RsaSSL_SignAsyncWorker( callback, info );
+  worker->Queue();
+
+  return env.Undefined();
+}
+
+Napi::Value wc_RsaSSL_Verify_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[5].As<Napi::Function>();
+
+  wc_RsaSSL_VerifyAsyncWorker* worker = new wc_RsaSSL_VerifyAsyncWorker( callback, info );
+  worker->Queue();
+
+  return env.Undefined();
+}
+
+#ifndef WC_NO_RSA_OAEP
+// the _ex versions take the callback after label_len
+Napi::Value wc_RsaPublicEncrypt_ex_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[10].As<Napi::Function>();
+
+  wc_RsaPublicEncrypt_exAsyncWorker* worker = new wc_RsaPublicEncrypt_exAsyncWorker( callback, info );
+  worker->Queue();
+
+  return env.Undefined();
+}
+
+Napi::Value wc_RsaPrivateDecrypt_ex_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[10].As<Napi::Function>();
+
+  wc_RsaPrivateDecrypt_exAsyncWorker* worker = new wc_RsaPrivateDecrypt_exAsyncWorker( callback, info );
+  worker->Queue();
+
+  return env.Undefined();
+}
+#endif
+
+#ifdef WC_RSA_PSS
+// the PSS versions take the callback after the key
+Napi::Value wc_RsaPSS_Sign_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[7].As<Napi::Function>();
+
+  wc_RsaPSS_SignAsyncWorker* worker = new wc_RsaPSS_SignAsyncWorker( callback, info );
+  worker->Queue();
+
+  return env.Undefined();
+}
+
+Napi::Value wc_RsaPSS_Verify_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[7].As<Napi::Function>();
+
+  wc_RsaPSS_VerifyAsyncWorker* worker = new wc_RsaPSS_VerifyAsyncWorker( callback, info );
+  worker->Queue();
+
+  return env.Undefined();
+}
+
+Napi::Value nodejsRsaPSS_VerifyHash_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Function callback = info[7].As<Napi::Function>();
+
+  nodejsRsaPSS_VerifyHashAsyncWorker* worker = new nodejsRsaPSS_VerifyHashAsyncWorker( callback, info );
+  worker->Queue();
+
+  return env.Undefined();
+}
+#endif
+
 Napi::Number bind_wc_FreeRsaKey(const Napi::CallbackInfo& info)
 {
   int ret;
   Napi::Env env = info.Env();
   RsaKey* rsa = (RsaKey*)( info[0].As<Napi::Uint8Array>().Data() );
+  std::lock_guard<std::mutex> lock( wolfcrypt_key_lock( rsa ) );
 
   ret = wc_FreeRsaKey( rsa );
 
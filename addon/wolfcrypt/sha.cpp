@@ -62,6 +62,328 @@ Napi::Number Sha_digest_length(const Napi::CallbackInfo& info)
   return Napi::Number::New( env, length );
 }
 
+Napi::Number typeof_Hash(const Napi::CallbackInfo& info)
+{
+  int ret = -1;
+  Napi::Env env = info.Env();
+  std::string type = info[0].As<Napi::String>().Utf8Value();
+
+  if ( strcmp( type.c_str(), "SHA" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA;
+  }
+  else if ( strcmp( type.c_str(), "SHA224" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA224;
+  }
+  else if ( strcmp( type.c_str(), "SHA256" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA256;
+  }
+  else if ( strcmp( type.c_str(), "SHA384" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA384;
+  }
+  else if ( strcmp( type.c_str(), "SHA512" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA512;
+  }
+#ifndef WOLFSSL_NOSHA512_224
+  else if ( strcmp( type.c_str(), "SHA512_224" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA512_224;
+  }
+#endif
+#ifndef WOLFSSL_NOSHA512_256
+  else if ( strcmp( type.c_str(), "SHA512_256" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA512_256;
+  }
+#endif
+  else if ( strcmp( type.c_str(), "SHA3_224" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA3_224;
+  }
+  else if ( strcmp( type.c_str(), "SHA3_256" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA3_256;
+  }
+  else if ( strcmp( type.c_str(), "SHA3_384" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA3_384;
+  }
+  else if ( strcmp( type.c_str(), "SHA3_512" ) == 0 )
+  {
+    ret = WC_HASH_TYPE_SHA3_512;
+  }
+
+  return Napi::Number::New( env, ret );
+}
+
+// one shot digest, type comes from typeof_Hash and data may be a string or a
+// Uint8Array, the hash context only lives on the stack of wc_Hash
+//
+// wc_Hash( type, data ) returns the digest as a Buffer or an error code
+// wc_Hash( type, data, out[, offset] ) writes the digest into out and returns
+// its length or an error code
+Napi::Value bind_wc_Hash(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  enum wc_HashType type = (enum wc_HashType)info[0].As<Napi::Number>().Int32Value();
+  std::string data_str;
+  const uint8_t* data;
+  size_t data_len;
+  int digest_len = wc_HashGetDigestSize( type );
+  uint8_t digest[WC_MAX_DIGEST_SIZE];
+
+  if ( digest_len <= 0 )
+  {
+    return Napi::Number::New( env, digest_len == 0 ? BAD_FUNC_ARG : digest_len );
+  }
+
+  if ( info[1].IsString() )
+  {
+    data_str = info[1].As<Napi::String>().Utf8Value();
+    data = (const uint8_t*)data_str.data();
+    data_len = data_str.size();
+  }
+  else
+  {
+    Napi::Uint8Array data_arr = info[1].As<Napi::Uint8Array>();
+    data = data_arr.Data();
+    data_len = data_arr.ElementLength();
+  }
+
+  if ( info.Length() > 2 && info[2].IsTypedArray() )
+  {
+    Napi::Uint8Array out = info[2].As<Napi::Uint8Array>();
+    size_t offset = 0;
+
+    if ( info.Length() > 3 && info[3].IsNumber() )
+    {
+      offset = info[3].As<Napi::Number>().Uint32Value();
+    }
+
+    if ( offset > out.ElementLength() || out.ElementLength() - offset < (size_t)digest_len )
+    {
+      return Napi::Number::New( env, BUFFER_E );
+    }
+
+    ret = wc_Hash( type, data, (word32)data_len, out.Data() + offset, digest_len );
+
+    return Napi::Number::New( env, ret == 0 ? digest_len : ret );
+  }
+
+  ret = wc_Hash( type, data, (word32)data_len, digest, digest_len );
+
+  if ( ret != 0 )
+  {
+    return Napi::Number::New( env, ret );
+  }
+
+  return Napi::Buffer<uint8_t>::Copy( env, digest, digest_len );
+}
+
+// hashes messages start to end of a packed buffer, message i is
+// data[offsets[i]] up to data[offsets[i + 1]] and its digest is written to
+// out + i * digest_len, returns the first error
+static int hash_many_range( enum wc_HashType type, const uint8_t* data, const uint32_t* offsets,
+  size_t start, size_t end, uint8_t* out, int digest_len )
+{
+  int ret = 0;
+  size_t i;
+
+  for ( i = start; i < end; i++ )
+  {
+    int err = wc_Hash( type, data + offsets[i], offsets[i + 1] - offsets[i], out + i * digest_len, digest_len );
+
+    if ( err != 0 && ret == 0 )
+    {
+      ret = err;
+    }
+  }
+
+  return ret;
+}
+
+// wc_HashMany( type, data, offsets ) hashes offsets.length - 1 messages
+// packed into data and returns their digests back to back in one Buffer, or
+// an error code, BAD_FUNC_ARG when the offsets don't fit data
+Napi::Value bind_wc_HashMany(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  enum wc_HashType type = (enum wc_HashType)info[0].As<Napi::Number>().Int32Value();
+  long count = wolfcrypt_packed_count( info[2] );
+  int digest_len = wc_HashGetDigestSize( type );
+
+  if ( count < 0 || !wolfcrypt_packed_valid( info[1], info[2], count ) )
+  {
+    return Napi::Number::New( env, BAD_FUNC_ARG );
+  }
+
+  uint8_t* data = info[1].As<Napi::Uint8Array>().Data();
+  Napi::Uint32Array offsets = info[2].As<Napi::Uint32Array>();
+
+  if ( digest_len <= 0 )
+  {
+    return Napi::Number::New( env, digest_len == 0 ? BAD_FUNC_ARG : digest_len );
+  }
+
+  Napi::Buffer<uint8_t> out = Napi::Buffer<uint8_t>::New( env, count * digest_len );
+
+  ret = hash_many_range( type, data, offsets.Data(), 0, count, out.Data(), digest_len );
+
+  if ( ret != 0 )
+  {
+    return Napi::Number::New( env, ret );
+  }
+
+  return out;
+}
+
+// the output buffer is created up front so workers write their digests into
+// it directly
+class hash_many_batch : public wolfcrypt_batch
+{
+  public:
+    hash_many_batch( Napi::Env env, Napi::Function& callback, size_t count, enum wc_HashType type, int digest_len,
+      Napi::Uint8Array& data_arr, Napi::Uint32Array& offsets_arr )
+      : wolfcrypt_batch( callback, count ), type( type ), digest_len( digest_len ),
+        data( data_arr.Data() ), offsets( offsets_arr.Data() )
+    {
+      Napi::Buffer<uint8_t> out_buf = Napi::Buffer<uint8_t>::New( env, count * digest_len );
+
+      out = out_buf.Data();
+      out_ref = Napi::Persistent( out_buf );
+
+      pin( data_arr );
+      pin( offsets_arr );
+    }
+
+    void run( size_t start, size_t end ) override
+    {
+      int err = hash_many_range( type, data, offsets, start, end, out, digest_len );
+
+      if ( err != 0 )
+      {
+        ret = err;
+      }
+    }
+
+    Napi::Value result( Napi::Env env ) override
+    {
+      return out_ref.Value();
+    }
+
+  private:
+    enum wc_HashType type;
+    int digest_len;
+    uint8_t* data;
+    uint32_t* offsets;
+    uint8_t* out;
+    Napi::Reference<Napi::Buffer<uint8_t>> out_ref;
+};
+
+#define HASH_MANY_MIN_CHUNK 64
+
+// same arguments as wc_HashMany plus a callback, the messages are split
+// across the thread pool and the callback is called with the first error and
+// the Buffer of digests
+Napi::Value wc_HashMany_async(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  enum wc_HashType type = (enum wc_HashType)info[0].As<Napi::Number>().Int32Value();
+  long count = wolfcrypt_packed_count( info[2] );
+  Napi::Function callback = info[3].As<Napi::Function>();
+  int digest_len = wc_HashGetDigestSize( type );
+
+  if ( count < 0 || !wolfcrypt_packed_valid( info[1], info[2], count ) )
+  {
+    wolfcrypt_batch_fail( callback, BAD_FUNC_ARG );
+
+    return env.Undefined();
+  }
+
+  Napi::Uint8Array data = info[1].As<Napi::Uint8Array>();
+  Napi::Uint32Array offsets = info[2].As<Napi::Uint32Array>();
+
+  if ( digest_len <= 0 )
+  {
+    wolfcrypt_batch_fail( callback, digest_len == 0 ? BAD_FUNC_ARG : digest_len );
+
+    return env.Undefined();
+  }
+
+  std::shared_ptr<hash_many_batch> batch = std::make_shared<hash_many_batch>( env, callback, count, type, digest_len, data, offsets );
+
+  wolfcrypt_batch_queue( env, batch, HASH_MANY_MIN_CHUNK );
+
+  return env.Undefined();
+}
+
+// copies the state of a hash context, the compat SHA contexts and the hash
+// inside an Hmac are the wolfcrypt structs underneath so this covers both
+int wolfcrypt_hash_copy( enum wc_HashType type, void* src, void* dst )
+{
+  switch ( type )
+  {
+#ifndef NO_MD5
+    case WC_HASH_TYPE_MD5:
+      return wc_Md5Copy( (wc_Md5*)src, (wc_Md5*)dst );
+#endif
+    case WC_HASH_TYPE_SHA:
+      return wc_ShaCopy( (wc_Sha*)src, (wc_Sha*)dst );
+    case WC_HASH_TYPE_SHA224:
+      return wc_Sha224Copy( (wc_Sha224*)src, (wc_Sha224*)dst );
+    case WC_HASH_TYPE_SHA256:
+      return wc_Sha256Copy( (wc_Sha256*)src, (wc_Sha256*)dst );
+    case WC_HASH_TYPE_SHA384:
+      return wc_Sha384Copy( (wc_Sha384*)src, (wc_Sha384*)dst );
+    case WC_HASH_TYPE_SHA512:
+      return wc_Sha512Copy( (wc_Sha512*)src, (wc_Sha512*)dst );
+#ifndef WOLFSSL_NOSHA512_224
+    case WC_HASH_TYPE_SHA512_224:
+      return wc_Sha512_224Copy( (wc_Sha512*)src, (wc_Sha512*)dst );
+#endif
+#ifndef WOLFSSL_NOSHA512_256
+    case WC_HASH_TYPE_SHA512_256:
+      return wc_Sha512_256Copy( (wc_Sha512*)src, (wc_Sha512*)dst );
+#endif
+    case WC_HASH_TYPE_SHA3_224:
+      return wc_Sha3_224_Copy( (wc_Sha3*)src, (wc_Sha3*)dst );
+    case WC_HASH_TYPE_SHA3_256:
+      return wc_Sha3_256_Copy( (wc_Sha3*)src, (wc_Sha3*)dst );
+    case WC_HASH_TYPE_SHA3_384:
+      return wc_Sha3_384_Copy( (wc_Sha3*)src, (wc_Sha3*)dst );
+    case WC_HASH_TYPE_SHA3_512:
+      return wc_Sha3_512_Copy( (wc_Sha3*)src, (wc_Sha3*)dst );
+    default:
+      return BAD_FUNC_ARG;
+  }
+}
+
+// nodejsShaCopy( type, src, dst ) copies a compat SHA context of the given
+// typeof_Hash type into dst, which must be a Buffer of the same size
+Napi::Number nodejsShaCopy(const Napi::CallbackInfo& info)
+{
+  int ret;
+  Napi::Env env = info.Env();
+  enum wc_HashType type = (enum wc_HashType)info[0].As<Napi::Number>().Int32Value();
+  Napi::Uint8Array src = info[1].As<Napi::Uint8Array>();
+  Napi::Uint8Array dst = info[2].As<Napi::Uint8Array>();
+
+  if ( dst.ElementLength() < src.ElementLength() )
+  {
+    return Napi::Number::New( env, BUFFER_E );
+  }
+
+  ret = wolfcrypt_hash_copy( type, src.Data(), dst.Data() );
+
+  return Napi::Number::New( env, ret );
+}
+
 Napi::Number sizeof_WOLFSSL_SHA_CTX(const Napi::CallbackInfo& info)
 {
   Napi::Env env = info.Env();
@@ -0,0 +1,327 @@
+/* stats.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/stats.h"
+#include "./h/watchdog.h"
+#include <vector>
+
+std::atomic<int> wolfcrypt_stats_flags( 0 );
+
+// ops are registered once per name and never freed, so every environment
+// loading the addon shares the same counters and the pointers handed out as
+// function data stay valid
+static std::mutex ops_lock;
+static std::vector<wolfcrypt_stats_op*>& stats_ops()
+{
+  static std::vector<wolfcrypt_stats_op*>* ops = new std::vector<wolfcrypt_stats_op*>();
+
+  return *ops;
+}
+
+static std::unordered_map<std::string, wolfcrypt_stats_op*>& stats_names()
+{
+  static std::unordered_map<std::string, wolfcrypt_stats_op*>* names = new std::unordered_map<std::string, wolfcrypt_stats_op*>();
+
+  return *names;
+}
+
+static void stats_clear( wolfcrypt_stats_op* op )
+{
+  op->calls = 0;
+  op->bytes = 0;
+  op->ns = 0;
+  op->async_calls = 0;
+  op->queue_ns = 0;
+  op->queue_max_ns = 0;
+  op->execute_ns = 0;
+
+  for ( int i = 0; i < WOLFCRYPT_STATS_BUCKETS; i++ )
+  {
+    op->histogram[i] = 0;
+    op->execute_histogram[i] = 0;
+  }
+
+  std::lock_guard<std::mutex> lock( op->errors_lock );
+  op->errors.clear();
+}
+
+wolfcrypt_stats_op* wolfcrypt_stats_register( const char* name, int data_arg )
+{
+  std::lock_guard<std::mutex> lock( ops_lock );
+  auto found = stats_names().find( name );
+
+  if ( found != stats_names().end() )
+  {
+    return found->second;
+  }
+
+  wolfcrypt_stats_op* op = new wolfcrypt_stats_op();
+
+  op->name = name;
+  op->data_arg = data_arg;
+  op->slow = false;
+  stats_clear( op );
+  stats_ops().push_back( op );
+  stats_names()[name] = op;
+
+  return op;
+}
+
+wolfcrypt_stats_op* wolfcrypt_stats_find( const std::string& name )
+{
+  std::lock_guard<std::mutex> lock( ops_lock );
+  auto found = stats_names().find( name );
+
+  return found == stats_names().end() ? NULL : found->second;
+}
+
+void wolfcrypt_stats_each( void ( *fn )( wolfcrypt_stats_op* op ) )
+{
+  std::lock_guard<std::mutex> lock( ops_lock );
+
+  for ( wolfcrypt_stats_op* op : stats_ops() )
+  {
+    fn( op );
+  }
+}
+
+static int stats_bucket( uint64_t ns )
+{
+  int bucket = 0;
+
+  while ( ns > 1 && bucket < WOLFCRYPT_STATS_BUCKETS - 1 )
+  {
+    ns >>= 1;
+    bucket++;
+  }
+
+  return bucket;
+}
+
+// wolfcrypt reports errors as negative return values, the bindings pass them
+// on as they are
+static void stats_error( wolfcrypt_stats_op* op, int ret )
+{
+  std::lock_guard<std::mutex> lock( op->errors_lock );
+
+  op->errors[ret]++;
+}
+
+void wolfcrypt_stats_record( wolfcrypt_stats_op* op, const Napi::CallbackInfo& info, Napi::Value ret, uint64_t ns, int flags )
+{
+  if ( op == NULL )
+  {
+    return;
+  }
+
+  if ( flags & WOLFCRYPT_STATS_WATCHDOG )
+  {
+    wolfcrypt_watchdog_check( op, info, ns );
+  }
+
+  if ( !( flags & WOLFCRYPT_STATS_COUNT ) )
+  {
+    return;
+  }
+
+  op->calls.fetch_add( 1, std::memory_order_relaxed );
+  op->ns.fetch_add( ns, std::memory_order_relaxed );
+  op->histogram[stats_bucket( ns )].fetch_add( 1, std::memory_order_relaxed );
+
+  if ( op->data_arg >= 0 && (size_t)op->data_arg < info.Length() )
+  {
+    Napi::Value data = info[op->data_arg];
+
+    if ( data.IsNumber() )
+    {
+      int64_t len = data.As<Napi::Number>().Int64Value();
+
+      op->bytes.fetch_add( len > 0 ? len : 0, std::memory_order_relaxed );
+    }
+    else if ( data.IsTypedArray() )
+    {
+      op->bytes.fetch_add( data.As<Napi::TypedArray>().ByteLength(), std::memory_order_relaxed );
+    }
+  }
+
+  if ( ret.IsNumber() )
+  {
+    int code = ret.As<Napi::Number>().Int32Value();
+
+    if ( code < 0 )
+    {
+      stats_error( op, code );
+    }
+  }
+}
+
+void wolfcrypt_stats_record_async( wolfcrypt_stats_op* op, uint64_t queue_ns, uint64_t execute_ns, int ret )
+{
+  uint64_t queue_max = op->queue_max_ns.load( std::memory_order_relaxed );
+
+  op->async_calls.fetch_add( 1, std::memory_order_relaxed );
+  op->queue_ns.fetch_add( queue_ns, std::memory_order_relaxed );
+  op->execute_ns.fetch_add( execute_ns, std::memory_order_relaxed );
+  op->execute_histogram[stats_bucket( execute_ns )].fetch_add( 1, std::memory_order_relaxed );
+
+  while ( queue_ns > queue_max && !op->queue_max_ns.compare_exchange_weak( queue_max, queue_ns, std::memory_order_relaxed ) )
+  {
+  }
+
+  if ( ret < 0 )
+  {
+    stats_error( op, ret );
+  }
+}
+
+wolfcrypt_stats_async::wolfcrypt_stats_async( const Napi::CallbackInfo& info )
+  : op( NULL )
+{
+  if ( wolfcrypt_stats_flags.load( std::memory_order_relaxed ) & WOLFCRYPT_STATS_COUNT )
+  {
+    op = (wolfcrypt_stats_op*)info.Data();
+    queued = std::chrono::steady_clock::now();
+  }
+}
+
+void wolfcrypt_stats_async::start()
+{
+  if ( op != NULL )
+  {
+    started = std::chrono::steady_clock::now();
+  }
+}
+
+void wolfcrypt_stats_async::finish( int ret )
+{
+  if ( op != NULL )
+  {
+    auto finished = std::chrono::steady_clock::now();
+
+    wolfcrypt_stats_record_async( op,
+      std::chrono::duration_cast<std::chrono::nanoseconds>( started - queued ).count(),
+      std::chrono::duration_cast<std::chrono::nanoseconds>( finished - started ).count(), ret );
+  }
+}
+
+static Napi::Array stats_histogram( Napi::Env env, std::atomic<uint64_t>* histogram )
+{
+  Napi::Array array = Napi::Array::New( env, WOLFCRYPT_STATS_BUCKETS );
+
+  for ( int i = 0; i < WOLFCRYPT_STATS_BUCKETS; i++ )
+  {
+    array.Set( i, Napi::Number::New( env, (double)histogram[i].load( std::memory_order_relaxed ) ) );
+  }
+
+  return array;
+}
+
+// nodejsStats() returns { enabled, ops: { name: { calls, bytes, ns, histogram,
+// errors: { code: count }, async: { calls, queueNs, queueMaxNs, executeNs,
+// histogram } } } } for every function called since the last reset, the
+// counters are read one by one so a snapshot taken under load is not exact
+Napi::Value nodejsStats(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Object result = Napi::Object::New( env );
+  Napi::Object ops = Napi::Object::New( env );
+  std::lock_guard<std::mutex> lock( ops_lock );
+
+  for ( wolfcrypt_stats_op* op : stats_ops() )
+  {
+    uint64_t calls = op->calls.load( std::memory_order_relaxed );
+    uint64_t async_calls = op->async_calls.load( std::memory_order_relaxed );
+
+    if ( calls == 0 && async_calls == 0 )
+    {
+      continue;
+    }
+
+    Napi::Object entry = Napi::Object::New( env );
+    Napi::Object errors = Napi::Object::New( env );
+
+    entry.Set( "calls", Napi::Number::New( env, (double)calls ) );
+    entry.Set( "bytes", Napi::Number::New( env, (double)op->bytes.load( std::memory_order_relaxed ) ) );
+    entry.Set( "ns", Napi::Number::New( env, (double)op->ns.load( std::memory_order_relaxed ) ) );
+    entry.Set( "histogram", stats_histogram( env, op->histogram ) );
+
+    {
+      std::lock_guard<std::mutex> errors_lock( op->errors_lock );
+
+      for ( auto& error : op->errors )
+      {
+        errors.Set( std::to_string( error.first ), Napi::Number::New( env, (double)error.second ) );
+      }
+    }
+
+    entry.Set( "errors", errors );
+
+    if ( async_calls > 0 )
+    {
+      Napi::Object async = Napi::Object::New( env );
+
+      async.Set( "calls", Napi::Number::New( env, (double)async_calls ) );
+      async.Set( "queueNs", Napi::Number::New( env, (double)op->queue_ns.load( std::memory_order_relaxed ) ) );
+      async.Set( "queueMaxNs", Napi::Number::New( env, (double)op->queue_max_ns.load( std::memory_order_relaxed ) ) );
+      async.Set( "executeNs", Napi::Number::New( env, (double)op->execute_ns.load( std::memory_order_relaxed ) ) );
+      async.Set( "histogram", stats_histogram( env, op->execute_histogram ) );
+      entry.Set( "async", async );
+    }
+
+    ops.Set( op->name, entry );
+  }
+
+  result.Set( "enabled", Napi::Boolean::New( env, ( wolfcrypt_stats_flags.load() & WOLFCRYPT_STATS_COUNT ) != 0 ) );
+  result.Set( "ops", ops );
+
+  return result;
+}
+
+void nodejsStatsReset(const Napi::CallbackInfo& info)
+{
+  std::lock_guard<std::mutex> lock( ops_lock );
+
+  for ( wolfcrypt_stats_op* op : stats_ops() )
+  {
+    stats_clear( op );
+  }
+}
+
+// nodejsStatsEnabled( [enabled] ) switches the counters on or off and returns
+// whether they were on before
+Napi::Value nodejsStatsEnabled(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  int flags = wolfcrypt_stats_flags.load();
+
+  if ( info.Length() > 0 && info[0].IsBoolean() )
+  {
+    if ( info[0].As<Napi::Boolean>().Value() )
+    {
+      flags = wolfcrypt_stats_flags.fetch_or( WOLFCRYPT_STATS_COUNT );
+    }
+    else
+    {
+      flags = wolfcrypt_stats_flags.fetch_and( ~WOLFCRYPT_STATS_COUNT );
+    }
+  }
+
+  return Napi::Boolean::New( env, ( flags & WOLFCRYPT_STATS_COUNT ) != 0 );
+}
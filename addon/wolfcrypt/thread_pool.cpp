@@ -0,0 +1,262 @@
+/* thread_pool.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/thread_pool.h"
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+#define WOLFCRYPT_POOL_MAX_SIZE 256
+
+typedef struct wolfcrypt_pool
+{
+  std::mutex lock;
+  std::condition_variable ready;
+  std::deque<std::shared_ptr<wolfcrypt_pool_job>> jobs;
+  size_t size;
+  size_t threads;
+} wolfcrypt_pool;
+
+// never destroyed, the threads are detached and may still be waiting on it
+// while the process exits
+static wolfcrypt_pool* pool_get()
+{
+  static wolfcrypt_pool* pool = NULL;
+  static std::once_flag once;
+
+  std::call_once( once, []() {
+    size_t cores = std::thread::hardware_concurrency();
+
+    pool = new wolfcrypt_pool();
+    pool->size = cores > 0 ? cores : 2;
+    pool->threads = 0;
+  } );
+
+  return pool;
+}
+
+static void pool_thread( wolfcrypt_pool* pool )
+{
+  std::unique_lock<std::mutex> guard( pool->lock );
+
+  while ( true )
+  {
+    pool->ready.wait( guard, [pool]() {
+      return !pool->jobs.empty() || pool->threads > pool->size;
+    } );
+
+    // the pool was shrunk
+    if ( pool->threads > pool->size )
+    {
+      pool->threads--;
+
+      return;
+    }
+
+    std::shared_ptr<wolfcrypt_pool_job> job = pool->jobs.front();
+    pool->jobs.pop_front();
+
+    guard.unlock();
+    job->run();
+    job.reset();
+    guard.lock();
+  }
+}
+
+wolfcrypt_pool_job::wolfcrypt_pool_job( Napi::Env env, Napi::Function& callback )
+{
+  tsfn = Napi::ThreadSafeFunction::New( env, callback, "wolfcrypt_pool_job", 0, 1 );
+}
+
+wolfcrypt_pool_job::wolfcrypt_pool_job()
+{
+}
+
+void wolfcrypt_pool_job::run()
+{
+  std::shared_ptr<wolfcrypt_pool_job> self = shared_from_this();
+
+  execute();
+
+  if ( (napi_threadsafe_function)tsfn == NULL )
+  {
+    return;
+  }
+
+  tsfn.BlockingCall( [self]( Napi::Env env, Napi::Function callback ) {
+    self->complete( env, callback );
+  } );
+
+  tsfn.Release();
+}
+
+void wolfcrypt_pool_queue( std::shared_ptr<wolfcrypt_pool_job> job )
+{
+  wolfcrypt_pool* pool = pool_get();
+  std::lock_guard<std::mutex> guard( pool->lock );
+
+  pool->jobs.push_back( job );
+
+  // threads are only started once there is work so loading the addon stays
+  // free, this also picks up a grown pool size
+  while ( pool->threads < pool->size )
+  {
+    std::thread( pool_thread, pool ).detach();
+    pool->threads++;
+  }
+
+  pool->ready.notify_one();
+}
+
+wolfcrypt_pool_batch::wolfcrypt_pool_batch( size_t count )
+  : count( count ), next( 0 ), done( 0 ), ret( 0 ), outstanding( 0 ), progress_step( 0 )
+{
+}
+
+class wolfcrypt_pool_batch_job : public wolfcrypt_pool_job
+{
+  public:
+    wolfcrypt_pool_batch_job( Napi::Env env, Napi::Function& callback, std::shared_ptr<wolfcrypt_pool_batch> batch )
+      : wolfcrypt_pool_job( env, callback ), batch( batch )
+    {
+    }
+
+    void execute()
+    {
+      wolfcrypt_pool_batch* b = batch.get();
+      size_t index;
+
+      while ( b->ret.load() == 0 && ( index = b->next++ ) < b->count )
+      {
+        int err = b->run( index );
+        int expected = 0;
+
+        if ( err != 0 )
+        {
+          b->ret.compare_exchange_strong( expected, err );
+        }
+
+        size_t done = ++b->done;
+
+        if ( b->progress_step > 0 && ( done % b->progress_step == 0 || done == b->count ) )
+        {
+          std::shared_ptr<wolfcrypt_pool_batch> keep = batch;
+
+          // progress calls queued by this job run before its completion, so
+          // every one of them runs before the batch callback
+          tsfn.NonBlockingCall( [keep, done]( Napi::Env env, Napi::Function callback ) {
+            if ( !keep->progress.IsEmpty() )
+            {
+              keep->progress.Call( { Napi::Number::New( env, done ), Napi::Number::New( env, keep->count ) } );
+            }
+          } );
+        }
+      }
+    }
+
+    void complete( Napi::Env env, Napi::Function callback )
+    {
+      if ( --batch->outstanding > 0 )
+      {
+        return;
+      }
+
+      Napi::Value result = batch->result( env );
+
+      batch->progress.Reset();
+
+      callback.Call( { env.Undefined(), Napi::Number::New( env, batch->ret.load() ), result } );
+    }
+
+  private:
+    std::shared_ptr<wolfcrypt_pool_batch> batch;
+};
+
+void wolfcrypt_pool_batch_queue( Napi::Env env, std::shared_ptr<wolfcrypt_pool_batch> batch, Napi::Function& callback, Napi::Value progress )
+{
+  size_t jobs = wolfcrypt_pool_size();
+
+  if ( jobs > batch->count )
+  {
+    jobs = batch->count;
+  }
+
+  // an empty batch still needs one job to call back
+  if ( jobs == 0 )
+  {
+    jobs = 1;
+  }
+
+  if ( progress.IsFunction() )
+  {
+    batch->progress = Napi::Persistent( progress.As<Napi::Function>() );
+    batch->progress_step = batch->count >= 100 ? batch->count / 100 : 1;
+  }
+
+  batch->outstanding = jobs;
+
+  for ( size_t i = 0; i < jobs; i++ )
+  {
+    wolfcrypt_pool_queue( std::make_shared<wolfcrypt_pool_batch_job>( env, callback, batch ) );
+  }
+}
+
+size_t wolfcrypt_pool_size()
+{
+  wolfcrypt_pool* pool = pool_get();
+  std::lock_guard<std::mutex> guard( pool->lock );
+
+  return pool->size;
+}
+
+void wolfcrypt_pool_set_size( size_t size )
+{
+  wolfcrypt_pool* pool = pool_get();
+  std::lock_guard<std::mutex> guard( pool->lock );
+
+  if ( size < 1 )
+  {
+    size = 1;
+  }
+
+  if ( size > WOLFCRYPT_POOL_MAX_SIZE )
+  {
+    size = WOLFCRYPT_POOL_MAX_SIZE;
+  }
+
+  pool->size = size;
+
+  // extra threads exit once they wake up, new ones start with the next job
+  pool->ready.notify_all();
+}
+
+// nodejsThreadPoolSize( [size] ) sets the size when given and returns it
+Napi::Number nodejsThreadPoolSize(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+
+  if ( info.Length() > 0 && info[0].IsNumber() )
+  {
+    wolfcrypt_pool_set_size( info[0].As<Napi::Number>().Uint32Value() );
+  }
+
+  return Napi::Number::New( env, wolfcrypt_pool_size() );
+}
@@ -0,0 +1,217 @@
+/* util.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/util.h"
+#include <stdlib.h>
+
+#define WOLFCRYPT_KEY_LOCK_COUNT 64
+
+static std::mutex key_locks[WOLFCRYPT_KEY_LOCK_COUNT];
+
+// key structs live in js owned buffers so there is nowhere to keep a mutex
+// next to them, instead the address of the struct picks one of a fixed set of
+// locks, two keys sharing a lock only costs some extra serialization
+std::mutex& wolfcrypt_key_lock( const void* key )
+{
+  uintptr_t addr = (uintptr_t)key;
+
+  return key_locks[( addr >> 4 ) % WOLFCRYPT_KEY_LOCK_COUNT];
+}
+
+wolfcrypt_key_pair_lock::wolfcrypt_key_pair_lock( const void* a, const void* b )
+  : first( wolfcrypt_key_lock( a ), std::defer_lock ),
+    second( wolfcrypt_key_lock( b ), std::defer_lock )
+{
+  if ( first.mutex() == second.mutex() )
+  {
+    first.lock();
+  }
+  else
+  {
+    std::lock( first, second );
+  }
+}
+
+wolfcrypt_batch::wolfcrypt_batch( Napi::Function& callback, size_t count )
+  : count( count ), ret( 0 ), outstanding( 0 )
+{
+  this->callback = Napi::Persistent( callback );
+}
+
+void wolfcrypt_batch::pin( Napi::Object value )
+{
+  pinned.push_back( Napi::Persistent( value ) );
+}
+
+void wolfcrypt_batch::chunk_done( Napi::Env env )
+{
+  if ( --outstanding > 0 )
+  {
+    return;
+  }
+
+  Napi::HandleScope scope( env );
+  callback.Call( { env.Undefined(), Napi::Number::New( env, ret.load() ), result( env ) } );
+}
+
+class wolfcrypt_batch_worker : public Napi::AsyncWorker
+{
+  public:
+    wolfcrypt_batch_worker( Napi::Env env, std::shared_ptr<wolfcrypt_batch> batch, size_t start, size_t end )
+      : Napi::AsyncWorker( env ), batch( batch ), start( start ), end( end )
+    {}
+
+    ~wolfcrypt_batch_worker() {}
+
+    void Execute() override
+    {
+      batch->run( start, end );
+    }
+
+    void OnOK() override
+    {
+      batch->chunk_done( Env() );
+    }
+  private:
+    std::shared_ptr<wolfcrypt_batch> batch;
+    size_t start;
+    size_t end;
+};
+
+class wolfcrypt_batch_fail_worker : public Napi::AsyncWorker
+{
+  public:
+    wolfcrypt_batch_fail_worker( Napi::Function& callback, int err )
+      : Napi::AsyncWorker( callback ), err( err )
+    {}
+
+    ~wolfcrypt_batch_fail_worker() {}
+
+    void Execute() override
+    {
+    }
+
+    void OnOK() override
+    {
+      Napi::HandleScope scope( Env() );
+      Callback().Call( { Env().Undefined(), Napi::Number::New( Env(), err ) } );
+    }
+  private:
+    int err;
+};
+
+void wolfcrypt_batch_fail( Napi::Function& callback, int err )
+{
+  ( new wolfcrypt_batch_fail_worker( callback, err ) )->Queue();
+}
+
+long wolfcrypt_packed_count( Napi::Value offsets )
+{
+  if ( !offsets.IsTypedArray() || offsets.As<Napi::TypedArray>().TypedArrayType() != napi_uint32_array )
+  {
+    return -1;
+  }
+
+  size_t length = offsets.As<Napi::Uint32Array>().ElementLength();
+
+  return length == 0 ? -1 : (long)( length - 1 );
+}
+
+bool wolfcrypt_packed_valid( Napi::Value data, Napi::Value offsets, size_t count )
+{
+  if ( !data.IsTypedArray() || wolfcrypt_packed_count( offsets ) != (long)count )
+  {
+    return false;
+  }
+
+  size_t data_len = data.As<Napi::TypedArray>().ByteLength();
+  Napi::Uint32Array offsets_arr = offsets.As<Napi::Uint32Array>();
+  size_t i;
+
+  if ( offsets_arr[count] > data_len )
+  {
+    return false;
+  }
+
+  for ( i = 0; i < count; i++ )
+  {
+    if ( offsets_arr[i] > offsets_arr[i + 1] )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// the libuv pool size can only be changed through the environment before the
+// pool starts, so reading it here matches what the pool actually uses
+size_t wolfcrypt_uv_pool_size()
+{
+  const char* env_size = getenv( "UV_THREADPOOL_SIZE" );
+  long size = 4;
+
+  if ( env_size != NULL && atol( env_size ) > 0 )
+  {
+    size = atol( env_size );
+  }
+
+  return size > 1024 ? 1024 : (size_t)size;
+}
+
+void wolfcrypt_batch_queue( Napi::Env env, std::shared_ptr<wolfcrypt_batch> batch, size_t min_chunk )
+{
+  size_t chunks = wolfcrypt_uv_pool_size();
+  size_t chunk_size;
+  size_t start;
+
+  if ( min_chunk == 0 )
+  {
+    min_chunk = 1;
+  }
+
+  if ( batch->count / min_chunk < chunks )
+  {
+    chunks = batch->count / min_chunk;
+  }
+
+  if ( chunks == 0 )
+  {
+    chunks = 1;
+  }
+
+  chunk_size = ( batch->count + chunks - 1 ) / chunks;
+
+  // an empty batch still gets one worker so the callback stays async
+  if ( chunk_size == 0 )
+  {
+    chunk_size = 1;
+  }
+
+  chunks = batch->count == 0 ? 1 : ( batch->count + chunk_size - 1 ) / chunk_size;
+  batch->outstanding = chunks;
+
+  for ( start = 0; chunks > 0; chunks--, start += chunk_size )
+  {
+    size_t end = start + chunk_size > batch->count ? batch->count : start + chunk_size;
+
+    ( new wolfcrypt_batch_worker( env, batch, start, end ) )->Queue();
+  }
+}
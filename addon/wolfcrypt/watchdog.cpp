@@ -0,0 +1,234 @@
+/* watchdog.cpp
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+#include "./h/watchdog.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// a sync call on the main thread that takes longer than the threshold blocks
+// every other request for that long, the watchdog notes which call it was,
+// what it was called with and how long it took, and marks the function slow
+// so the _auto interface methods send later calls to the async path
+typedef struct watchdog_event
+{
+  const char* name;
+  std::string args;
+  uint64_t ns;
+  double time;
+} watchdog_event;
+
+static std::atomic<uint64_t> threshold_ns( 0 );
+static std::atomic<bool> reroute( false );
+static std::mutex events_lock;
+static std::vector<watchdog_event> events;
+static size_t events_next = 0;
+static uint64_t events_total = 0;
+
+// sizes and numbers only, the contents of buffers and strings may be keys
+static std::string watchdog_args( const Napi::CallbackInfo& info )
+{
+  std::string args;
+
+  for ( size_t i = 0; i < info.Length(); i++ )
+  {
+    Napi::Value arg = info[i];
+
+    if ( i > 0 )
+    {
+      args += ", ";
+    }
+
+    if ( arg.IsNumber() )
+    {
+      double value = arg.As<Napi::Number>().DoubleValue();
+      char number[32];
+
+      if ( value == std::floor( value ) && std::fabs( value ) < 1e15 )
+      {
+        snprintf( number, sizeof( number ), "%lld", (long long)value );
+      }
+      else
+      {
+        snprintf( number, sizeof( number ), "%g", value );
+      }
+
+      args += number;
+    }
+    else if ( arg.IsTypedArray() )
+    {
+      args += "buffer(" + std::to_string( arg.As<Napi::TypedArray>().ByteLength() ) + ")";
+    }
+    else if ( arg.IsString() )
+    {
+      args += "string(" + std::to_string( arg.As<Napi::String>().Utf8Value().size() ) + ")";
+    }
+    else if ( arg.IsBoolean() )
+    {
+      args += arg.As<Napi::Boolean>().Value() ? "true" : "false";
+    }
+    else if ( arg.IsFunction() )
+    {
+      args += "function";
+    }
+    else if ( arg.IsExternal() )
+    {
+      args += "external";
+    }
+    else if ( arg.IsNull() || arg.IsUndefined() )
+    {
+      args += arg.IsNull() ? "null" : "undefined";
+    }
+    else
+    {
+      args += "object";
+    }
+  }
+
+  return args;
+}
+
+void wolfcrypt_watchdog_check( wolfcrypt_stats_op* op, const Napi::CallbackInfo& info, uint64_t ns )
+{
+  uint64_t threshold = threshold_ns.load( std::memory_order_relaxed );
+
+  if ( threshold == 0 || ns < threshold )
+  {
+    return;
+  }
+
+  watchdog_event event;
+
+  event.name = op->name;
+  event.args = watchdog_args( info );
+  event.ns = ns;
+  event.time = (double)std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::system_clock::now().time_since_epoch() ).count();
+
+  op->slow = true;
+
+  std::lock_guard<std::mutex> lock( events_lock );
+
+  if ( events.size() < WOLFCRYPT_WATCHDOG_EVENTS )
+  {
+    events.push_back( event );
+  }
+  else
+  {
+    events[events_next] = event;
+  }
+
+  events_next = ( events_next + 1 ) % WOLFCRYPT_WATCHDOG_EVENTS;
+  events_total++;
+}
+
+// nodejsWatchdog( [thresholdNs, reroute] ) sets the time a sync call may take
+// before it is reported, 0 turns the watchdog off, and whether the _auto
+// methods should move functions that went over it to their async versions,
+// returns the previous { thresholdNs, reroute }
+Napi::Value nodejsWatchdog(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Object result = Napi::Object::New( env );
+
+  result.Set( "thresholdNs", Napi::Number::New( env, (double)threshold_ns.load() ) );
+  result.Set( "reroute", Napi::Boolean::New( env, reroute.load() ) );
+
+  if ( info.Length() > 0 && info[0].IsNumber() )
+  {
+    int64_t threshold = info[0].As<Napi::Number>().Int64Value();
+
+    threshold_ns = threshold > 0 ? threshold : 0;
+
+    if ( threshold > 0 )
+    {
+      wolfcrypt_stats_flags.fetch_or( WOLFCRYPT_STATS_WATCHDOG );
+    }
+    else
+    {
+      wolfcrypt_stats_flags.fetch_and( ~WOLFCRYPT_STATS_WATCHDOG );
+    }
+  }
+
+  if ( info.Length() > 1 && info[1].IsBoolean() )
+  {
+    reroute = info[1].As<Napi::Boolean>().Value();
+  }
+
+  return result;
+}
+
+// nodejsWatchdogEvents( [clear] ) returns { total, events: [ { name, args, ns,
+// time } ] } with the kept events oldest first, clear also forgets which
+// functions were marked slow
+Napi::Value nodejsWatchdogEvents(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  Napi::Object result = Napi::Object::New( env );
+  bool clear = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>().Value();
+  std::lock_guard<std::mutex> lock( events_lock );
+  Napi::Array array = Napi::Array::New( env, events.size() );
+  size_t first = events.size() < WOLFCRYPT_WATCHDOG_EVENTS ? 0 : events_next;
+
+  for ( size_t i = 0; i < events.size(); i++ )
+  {
+    const watchdog_event& event = events[( first + i ) % events.size()];
+    Napi::Object entry = Napi::Object::New( env );
+
+    entry.Set( "name", event.name );
+    entry.Set( "args", event.args );
+    entry.Set( "ns", Napi::Number::New( env, (double)event.ns ) );
+    entry.Set( "time", Napi::Number::New( env, event.time ) );
+    array.Set( i, entry );
+  }
+
+  result.Set( "total", Napi::Number::New( env, (double)events_total ) );
+  result.Set( "events", array );
+
+  if ( clear )
+  {
+    events.clear();
+    events_next = 0;
+    events_total = 0;
+
+    wolfcrypt_stats_each( []( wolfcrypt_stats_op* op ) {
+      op->slow = false;
+    } );
+  }
+
+  return result;
+}
+
+// nodejsWatchdogRerouted( name ) tells the _auto methods whether rerouting is
+// on and the named sync function went over the threshold
+Napi::Value nodejsWatchdogRerouted(const Napi::CallbackInfo& info)
+{
+  Napi::Env env = info.Env();
+  wolfcrypt_stats_op* op;
+
+  if ( !reroute.load( std::memory_order_relaxed ) )
+  {
+    return Napi::Boolean::New( env, false );
+  }
+
+  op = wolfcrypt_stats_find( info[0].As<Napi::String>().Utf8Value() );
+
+  return Napi::Boolean::New( env, op != NULL && op->slow.load( std::memory_order_relaxed ) );
+}
@@ -0,0 +1,209 @@
+/* bench.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const os = require( 'os' )
+const wolfcrypt = require( './build/Release/wolfcrypt' )
+const benches = require( './bench/index' )
+
+// node bench.js [--json] [--time ms] [--no-native] [filter ...]
+//
+// every bench in bench/*.js returns a list of cases, a case is
+// { name, run, bytes, calls, minOps, native, done } where run does one
+// operation, bytes is the data processed per operation for MB/s, calls is the
+// number of native calls one operation makes, native describes the same
+// operation for nodejsBenchmark and done cleans up after the case
+const args = process.argv.slice( 2 )
+const options = { json: false, time: 1000, native: true, filters: [] }
+
+for ( let i = 0; i < args.length; i++ )
+{
+  if ( args[i] == '--json' )
+  {
+    options.json = true
+  }
+  else if ( args[i] == '--time' )
+  {
+    options.time = parseInt( args[++i] )
+  }
+  else if ( args[i] == '--no-native' )
+  {
+    options.native = false
+  }
+  else
+  {
+    options.filters.push( args[i] )
+  }
+}
+
+function percentile( sorted, p )
+{
+  return sorted[Math.min( sorted.length - 1, Math.floor( sorted.length * p ) )]
+}
+
+// runs op until the time budget is used up, timing every call on its own so
+// the latency percentiles come from real samples
+function measure( run, minOps, time )
+{
+  let samples = []
+  const deadline = process.hrtime.bigint() + BigInt( time ) * 1000000n
+  let start
+
+  // warm up caches and lazily allocated state
+  run()
+
+  do
+  {
+    start = process.hrtime.bigint()
+    run()
+    samples.push( Number( process.hrtime.bigint() - start ) )
+  } while ( samples.length < minOps || process.hrtime.bigint() < deadline )
+
+  const total = samples.reduce( ( sum, sample ) => sum + sample, 0 )
+
+  samples.sort( ( a, b ) => a - b )
+
+  return {
+    ops: samples.length,
+    totalNs: total,
+    p50Ns: percentile( samples, 0.5 ),
+    p99Ns: percentile( samples, 0.99 )
+  }
+}
+
+// the cost of one native call that does no work, every case reports its
+// number of calls times this as the part of its time spent crossing N-API
+function napiBaseline()
+{
+  const count = 1000000
+  let start = process.hrtime.bigint()
+
+  for ( let i = 0; i < count; i++ )
+  {
+    wolfcrypt.sizeof_Hmac()
+  }
+
+  return Number( process.hrtime.bigint() - start ) / count
+}
+
+// the same workload run in a loop inside the addon, what the js case takes on
+// top of this per operation is the cost of the bindings and interface classes
+function measureNative( c, time )
+{
+  if ( !options.native || !c.native )
+  {
+    return null
+  }
+
+  const stats = wolfcrypt.nodejsBenchmark( Object.assign( { minOps: c.minOps || 5, time: time }, c.native ) )
+
+  // a number is the error the native workload stopped with, the case is
+  // reported as failed rather than silently losing its native columns
+  if ( typeof stats == 'number' )
+  {
+    return { error: stats }
+  }
+
+  return stats
+}
+
+function selected( group, name )
+{
+  return options.filters.length == 0 || options.filters.some( ( filter ) => group.includes( filter ) || name.includes( filter ) )
+}
+
+function format( value, digits )
+{
+  return value == null ? '-' : value.toFixed( digits )
+}
+
+const baselineNs = napiBaseline()
+let results = []
+
+if ( !options.json )
+{
+  console.log( `N-API call baseline ${ baselineNs.toFixed( 1 ) } ns` )
+  console.log( [ 'bench'.padEnd( 36 ), 'ops/s'.padStart( 12 ), 'MB/s'.padStart( 10 ), 'p50 us'.padStart( 10 ),
+    'p99 us'.padStart( 10 ), 'napi %'.padStart( 8 ), 'native ops/s'.padStart( 14 ), 'overhead ns'.padStart( 12 ) ].join( ' ' ) )
+}
+
+for ( const group of Object.keys( benches ) )
+{
+  const cases = benches[group]().filter( ( c ) => selected( group, c.name ) )
+
+  for ( const c of cases )
+  {
+    const stats = measure( c.run, c.minOps || 5, options.time )
+    const perOpNs = stats.totalNs / stats.ops
+    const napiNs = ( c.calls || 1 ) * baselineNs
+    let native = measureNative( c, options.time )
+
+    if ( native && native.error !== undefined )
+    {
+      console.error( `FAIL native ${ group } ${ c.name } ${ native.error }` )
+      process.exitCode = 1
+      native = null
+    }
+    const nativePerOpNs = native ? native.totalNs / native.ops : null
+
+    const result = {
+      group: group,
+      name: c.name,
+      ops: stats.ops,
+      opsPerSec: stats.ops / ( stats.totalNs / 1e9 ),
+      mbPerSec: c.bytes ? c.bytes * stats.ops / ( stats.totalNs / 1e3 ) : null,
+      p50Us: stats.p50Ns / 1e3,
+      p99Us: stats.p99Ns / 1e3,
+      calls: c.calls || 1,
+      napiNs: napiNs,
+      napiPercent: 100 * napiNs / perOpNs,
+      nativeOpsPerSec: native ? native.ops / ( native.totalNs / 1e9 ) : null,
+      nativeP50Us: native ? native.p50Ns / 1e3 : null,
+      nativeP99Us: native ? native.p99Ns / 1e3 : null,
+      overheadNs: native ? perOpNs - nativePerOpNs : null
+    }
+
+    results.push( result )
+
+    if ( c.done )
+    {
+      c.done()
+    }
+
+    if ( !options.json )
+    {
+      console.log( [ `${ group } ${ c.name }`.padEnd( 36 ), format( result.opsPerSec, 1 ).padStart( 12 ),
+        format( result.mbPerSec, 1 ).padStart( 10 ), format( result.p50Us, 2 ).padStart( 10 ),
+        format( result.p99Us, 2 ).padStart( 10 ), format( result.napiPercent, 1 ).padStart( 8 ),
+        format( result.nativeOpsPerSec, 1 ).padStart( 14 ), format( result.overheadNs, 0 ).padStart( 12 ) ].join( ' ' ) )
+    }
+  }
+}
+
+if ( options.json )
+{
+  console.log( JSON.stringify( {
+    node: process.version,
+    arch: process.arch,
+    cpu: os.cpus()[0] ? os.cpus()[0].model : null,
+    time: options.time,
+    napiBaselineNs: baselineNs,
+    results: results
+  }, null, 2 ) )
+}
@@ -0,0 +1,90 @@
+/* ecc.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const { WolfSSLEcc } = require( '../interfaces/ecc' )
+
+const message = 'Hello WolfSSL!'
+
+const ecc_bench =
+{
+  ecc: function()
+  {
+    let cases = []
+
+    for ( const curve of [ { name: 'P-256', size: 32 }, { name: 'P-384', size: 48 }, { name: 'P-521', size: 66 } ] )
+    {
+      let ecc0 = null
+      let ecc1 = null
+      let sig = null
+
+      const keys = () => {
+        if ( ecc0 == null )
+        {
+          ecc0 = new WolfSSLEcc()
+          ecc1 = new WolfSSLEcc()
+          ecc0.make_key( curve.size )
+          ecc1.make_key( curve.size )
+          sig = ecc0.sign_hash( message )
+        }
+
+        return ecc0
+      }
+
+      // new, init, make key, free and release
+      cases.push( {
+        name: `${ curve.name } keygen`,
+        calls: 5,
+        run: () => {
+          let ecc = new WolfSSLEcc()
+          ecc.make_key( curve.size )
+          ecc.free()
+        },
+        native: { workload: 'ecc-keygen', size: curve.size }
+      } )
+
+      cases.push( {
+        name: `${ curve.name } sign`,
+        calls: 2,
+        run: () => keys().sign_hash( message ),
+        native: { workload: 'ecc-sign', size: curve.size }
+      } )
+      cases.push( {
+        name: `${ curve.name } verify`,
+        calls: 1,
+        run: () => keys().verify_hash( sig, message ),
+        native: { workload: 'ecc-verify', size: curve.size }
+      } )
+      cases.push( {
+        name: `${ curve.name } ecdh`,
+        calls: 2,
+        run: () => keys().shared_secret( ecc1 ),
+        native: { workload: 'ecc-ecdh', size: curve.size },
+        done: () => {
+          ecc0.free()
+          ecc1.free()
+        }
+      } )
+    }
+
+    return cases
+  }
+}
+
+module.exports = ecc_bench
@@ -0,0 +1,92 @@
+/* evp.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const { WolfSSLEncryptor, WolfSSLDecryptor } = require( '../interfaces/evp' )
+
+const key = Buffer.from( '12345678901234567890123456789012' )
+const iv = Buffer.from( '1234567890123456' )
+const sizes = [ 16, 1024, 16384, 1048576 ]
+
+function sizeName( size )
+{
+  return size >= 1048576 ? `${ size / 1048576 }MiB` : size >= 1024 ? `${ size / 1024 }KiB` : `${ size }B`
+}
+
+const evp_bench =
+{
+  evp: function()
+  {
+    let cases = []
+
+    for ( const size of sizes )
+    {
+      const data = Buffer.alloc( size, 0xa5 )
+      let ciphertext = null
+
+      // new context, init, block size, update, final and free
+      cases.push( {
+        name: `AES-256-CBC encrypt ${ sizeName( size ) }`,
+        bytes: size,
+        calls: 6,
+        run: () => {
+          let encrypt = new WolfSSLEncryptor( 'AES-256-CBC', key, iv )
+          ciphertext = Buffer.concat( [ encrypt.update( data ), encrypt.finalize() ] )
+        },
+        native: { workload: 'aes-256-cbc-encrypt', size: size }
+      } )
+
+      cases.push( {
+        name: `AES-256-CBC decrypt ${ sizeName( size ) }`,
+        bytes: size,
+        calls: 6,
+        run: () => {
+          let decrypt = new WolfSSLDecryptor( 'AES-256-CBC', key, iv )
+          Buffer.concat( [ decrypt.update( ciphertext ), decrypt.finalize() ] )
+        },
+        native: { workload: 'aes-256-cbc-decrypt', size: size }
+      } )
+    }
+
+    // one long running stream, every operation is a single updateInto of a
+    // 16KiB chunk into a reused output buffer
+    const chunk = Buffer.alloc( 16384, 0xa5 )
+    let stream = null
+    let output = null
+
+    cases.push( {
+      name: 'AES-256-CBC stream 16KiB chunks',
+      bytes: chunk.length,
+      run: () => {
+        if ( stream == null )
+        {
+          stream = new WolfSSLEncryptor( 'AES-256-CBC', key, iv )
+          output = Buffer.alloc( stream.updateSize( chunk.length ) )
+        }
+
+        stream.updateInto( chunk, output, 0 )
+      },
+      done: () => stream.finalize()
+    } )
+
+    return cases
+  }
+}
+
+module.exports = evp_bench
@@ -0,0 +1,76 @@
+/* hmac.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { WolfSSLHmac, WolfSSLHmacKey } = require( '../interfaces/hmac' )
+
+const key = Buffer.from( '12345678901234567890123456789012' )
+const sizes = [ 16, 1024, 16384, 1048576 ]
+
+function sizeName( size )
+{
+  return size >= 1048576 ? `${ size / 1048576 }MiB` : size >= 1024 ? `${ size / 1024 }KiB` : `${ size }B`
+}
+
+const hmac_bench =
+{
+  hmac: function()
+  {
+    let cases = []
+    let hmacKey = null
+
+    for ( const size of sizes )
+    {
+      const data = Buffer.alloc( size, 0xa5 )
+
+      // typeof, new, digest length, set key, update, final, free and release
+      cases.push( {
+        name: `SHA256 ${ sizeName( size ) }`,
+        bytes: size,
+        calls: 8,
+        run: () => {
+          let hmac = new WolfSSLHmac( 'SHA256', key )
+          hmac.update( data )
+          hmac.finalize()
+        },
+        native: { workload: 'hmac', type: wolfcrypt.typeof_Hmac( 'SHA256' ), size: size }
+      } )
+
+      cases.push( {
+        name: `SHA256 key.mac ${ sizeName( size ) }`,
+        bytes: size,
+        run: () => {
+          if ( hmacKey == null )
+          {
+            hmacKey = new WolfSSLHmacKey( 'SHA256', key )
+          }
+
+          hmacKey.mac( data )
+        }
+      } )
+    }
+
+    cases[cases.length - 1].done = () => hmacKey.free()
+
+    return cases
+  }
+}
+
+module.exports = hmac_bench
@@ -0,0 +1,40 @@
+/* pbkdf2.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { WolfSSL_PBKDF2 } = require( '../interfaces/pbkdf2' )
+
+const password = Buffer.from( 'super secret password' )
+const salt = Buffer.from( 'super secret salt' )
+
+const pbkdf2_bench =
+{
+  pbkdf2: function()
+  {
+    return [ 1000, 10000, 100000 ].map( ( iterations ) => ( {
+      name: `SHA256 ${ iterations } iterations`,
+      calls: 2,
+      run: () => WolfSSL_PBKDF2( password, salt, iterations, 32, 'SHA256' ),
+      native: { workload: 'pbkdf2', type: wolfcrypt.typeof_Hmac( 'SHA256' ), iterations: iterations, size: 32 }
+    } ) )
+  }
+}
+
+module.exports = pbkdf2_bench
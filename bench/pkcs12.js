@@ -0,0 +1,63 @@
+/* pkcs12.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const fs = require( 'fs' )
+const path = require( 'path' )
+const { WolfSSL_PKCS12 } = require( '../interfaces/pkcs12' )
+
+const password = 'my secure password :D'
+
+const pkcs12_bench =
+{
+  pkcs12: function()
+  {
+    const cert = fs.readFileSync( path.join( __dirname, '../client-cert.der' ) )
+    const key = fs.readFileSync( path.join( __dirname, '../client-key.der' ) )
+    let der = null
+
+    const create = () => {
+      let pkcs12 = new WolfSSL_PKCS12()
+      pkcs12.Create( password, key, cert, [], WolfSSL_PKCS12.PBE_SHA1_DES3, WolfSSL_PKCS12.PBE_SHA1_DES3, 2048, 2048 )
+      der = pkcs12.InternalToDer()
+      pkcs12.free()
+    }
+
+    return [
+      { name: 'create 2048 iterations', calls: 4, run: create },
+      {
+        name: 'parse 2048 iterations',
+        calls: 4,
+        run: () => {
+          if ( der == null )
+          {
+            create()
+          }
+
+          let pkcs12 = new WolfSSL_PKCS12()
+          pkcs12.DerToInternal( der )
+          pkcs12.Parse( password )
+          pkcs12.free()
+        }
+      }
+    ]
+  }
+}
+
+module.exports = pkcs12_bench
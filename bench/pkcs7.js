@@ -0,0 +1,62 @@
+/* pkcs7.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const fs = require( 'fs' )
+const path = require( 'path' )
+const { WolfSSL_PKCS7 } = require( '../interfaces/pkcs7' )
+
+const message = 'Hello WolfSSL!'
+
+const pkcs7_bench =
+{
+  pkcs7: function()
+  {
+    const cert = fs.readFileSync( path.join( __dirname, '../client-cert.der' ) )
+    const key = fs.readFileSync( path.join( __dirname, '../client-key.der' ) )
+    let encoded = null
+
+    const sign = () => {
+      let pkcs7 = new WolfSSL_PKCS7()
+      pkcs7.AddCertificate( cert )
+      encoded = pkcs7.EncodeSignedData( message, key, 'RSA', 'SHA256' )
+      pkcs7.free()
+    }
+
+    return [
+      { name: 'RSA-2048 SHA256 sign', calls: 8, run: sign },
+      {
+        name: 'RSA-2048 SHA256 verify',
+        calls: 4,
+        run: () => {
+          if ( encoded == null )
+          {
+            sign()
+          }
+
+          let pkcs7 = new WolfSSL_PKCS7()
+          pkcs7.VerifySignedData( encoded )
+          pkcs7.free()
+        }
+      }
+    ]
+  }
+}
+
+module.exports = pkcs7_bench
@@ -0,0 +1,82 @@
+/* rsa.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const { WolfSSLRsa } = require( '../interfaces/rsa' )
+
+const message = Buffer.from( 'Hello WolfSSL! 0123456789abcdef' )
+
+const rsa_bench =
+{
+  rsa: function()
+  {
+    let cases = []
+
+    for ( const bits of [ 2048, 3072, 4096 ] )
+    {
+      let rsa = null
+      let sig = null
+      let ciphertext = null
+
+      // key generation is not part of the numbers, the first run of every
+      // case is an untimed warm up
+      const key = () => {
+        if ( rsa == null )
+        {
+          rsa = new WolfSSLRsa()
+          rsa.MakeRsaKey( bits, 65537 )
+          sig = rsa.SSL_Sign( message )
+          ciphertext = rsa.PublicEncrypt( message )
+        }
+
+        return rsa
+      }
+
+      cases.push( {
+        name: `RSA-${ bits } sign`,
+        calls: 2,
+        run: () => key().SSL_Sign( message ),
+        native: { workload: 'rsa-sign', bits: bits }
+      } )
+      cases.push( {
+        name: `RSA-${ bits } verify`,
+        calls: 2,
+        run: () => key().SSL_Verify( sig, message ),
+        native: { workload: 'rsa-verify', bits: bits }
+      } )
+      cases.push( {
+        name: `RSA-${ bits } encrypt`,
+        calls: 2,
+        run: () => key().PublicEncrypt( message ),
+        native: { workload: 'rsa-encrypt', bits: bits }
+      } )
+      cases.push( {
+        name: `RSA-${ bits } decrypt`,
+        calls: 2,
+        run: () => key().PrivateDecrypt( ciphertext ),
+        native: { workload: 'rsa-decrypt', bits: bits },
+        done: () => rsa.free()
+      } )
+    }
+
+    return cases
+  }
+}
+
+module.exports = rsa_bench
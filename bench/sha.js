@@ -0,0 +1,70 @@
+/* sha.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { WolfSSLSha } = require( '../interfaces/sha' )
+
+const sizes = [ 16, 1024, 16384, 1048576, 16777216 ]
+
+function sizeName( size )
+{
+  return size >= 1048576 ? `${ size / 1048576 }MiB` : size >= 1024 ? `${ size / 1024 }KiB` : `${ size }B`
+}
+
+const sha_bench =
+{
+  sha: function()
+  {
+    let cases = []
+
+    for ( const type of [ 'SHA', 'SHA256', 'SHA512' ] )
+    {
+      for ( const size of sizes )
+      {
+        const data = Buffer.alloc( size, 0xa5 )
+
+        cases.push( {
+          name: `${ type } ${ sizeName( size ) }`,
+          bytes: size,
+          run: () => WolfSSLSha.hash( type, data ),
+          native: { workload: 'hash', type: wolfcrypt.typeof_Hash( type ), size: size }
+        } )
+      }
+    }
+
+    // the context api: nodejsShaNew, init, digest length, update and final
+    const data = Buffer.alloc( 1024, 0xa5 )
+
+    cases.push( {
+      name: 'SHA256 context 1KiB',
+      bytes: 1024,
+      calls: 5,
+      run: () => {
+        let sha = new WolfSSLSha( 'SHA256' )
+        sha.update( data )
+        sha.finalize()
+      }
+    } )
+
+    return cases
+  }
+}
+
+module.exports = sha_bench
@@ -3,6 +3,7 @@
         "target_name": "wolfcrypt",
         "cflags!": [ "-fno-exceptions" ],
         "cflags_cc!": [ "-fno-exceptions" ],
+        "cflags_cc": [ "-std=c++17" ],
         "sources": [
             "addon/wolfcrypt/main.cpp",
             "addon/wolfcrypt/evp.cpp",
@@ -10,10 +11,22 @@
             "addon/wolfcrypt/rsa.cpp",
             "addon/wolfcrypt/sha.cpp",
             "addon/wolfcrypt/ecc.cpp",
+            "addon/wolfcrypt/ed25519.cpp",
+            "addon/wolfcrypt/curve25519.cpp",
             "addon/wolfcrypt/pbkdf2.cpp",
+            "addon/wolfcrypt/kdf.cpp",
             "addon/wolfcrypt/pkcs7.cpp",
             "addon/wolfcrypt/pkcs12.cpp",
-            "addon/wolfcrypt/random.cpp"
+            "addon/wolfcrypt/random.cpp",
+            "addon/wolfcrypt/util.cpp",
+            "addon/wolfcrypt/thread_pool.cpp",
+            "addon/wolfcrypt/native.cpp",
+            "addon/wolfcrypt/bench.cpp",
+            "addon/wolfcrypt/stats.cpp",
+            "addon/wolfcrypt/watchdog.cpp",
+            "addon/wolfcrypt/key_cache.cpp",
+            "addon/wolfcrypt/key_pool.cpp",
+            "addon/wolfcrypt/ecc_fp.cpp"
         ],
         "include_dirs": [
             "<!@(node -p \"require('node-addon-api').include\")"
@@ -50,8 +63,12 @@
         'msvs_settings': {
             'VCCLCompilerTool': {
                 'ExceptionHandling': '1',
+                'LanguageStandard': 'stdcpp17',
                 'AdditionalOptions': ['/EHsc']
             }
+        },
+        'xcode_settings': {
+            'CLANG_CXX_LANGUAGE_STANDARD': 'c++17'
         }
     }]
 }
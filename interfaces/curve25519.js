@@ -0,0 +1,475 @@
+/* curve25519.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { runAuto } = require( './util/auto' )
+
+const CURVE25519_KEY_SIZE = 32
+
+// packs the public keys of pubKeys, WolfSSLCurve25519 keys or raw 32 byte
+// Buffers, back to back as wc_curve25519_shared_secret_many takes them
+function packPublics( pubKeys )
+{
+  if ( !Array.isArray( pubKeys ) )
+  {
+    throw 'pubKeys must be an array'
+  }
+
+  return Buffer.concat( pubKeys.map( ( pubKey ) => {
+    const pubBuf = Buffer.isBuffer( pubKey ) ? pubKey : pubKey.export_public()
+
+    if ( pubBuf.length != CURVE25519_KEY_SIZE )
+    {
+      throw `public keys must be ${ CURVE25519_KEY_SIZE } bytes`
+    }
+
+    return pubBuf
+  } ) )
+}
+
+// splits the secrets back into one Buffer per public key, null where the
+// exchange failed and the secret was left all zeros
+function splitSecrets( secrets )
+{
+  let results = []
+
+  for ( let i = 0; i < secrets.length; i += CURVE25519_KEY_SIZE )
+  {
+    const secret = Buffer.from( secrets.subarray( i, i + CURVE25519_KEY_SIZE ) )
+
+    results.push( secret.some( ( b ) => b != 0 ) ? secret : null )
+  }
+
+  return results
+}
+
+class WolfSSLCurve25519
+{
+  /**
+   * Creates a new curve25519_key structure in native memory and calls
+   * wc_curve25519_init, keys go in and out in the little endian format of
+   * RFC 7748 used by other X25519 implementations
+   *
+   * @remarks free should be called to free the curve25519 key data, a key
+   * that is collected without it is freed by its finalizer
+   *
+   * @throws {Error} If wolfcrypt is built without HAVE_CURVE25519.
+   */
+  constructor()
+  {
+    if ( wolfcrypt.nodejsCurve25519KeyNew == null )
+    {
+      throw 'Curve25519 not compiled in'
+    }
+
+    this.curve25519 = wolfcrypt.nodejsCurve25519KeyNew()
+
+    if ( typeof this.curve25519 == 'number' )
+    {
+      throw `Failed to nodejsCurve25519KeyNew ${ this.curve25519 }`
+    }
+
+    this.pending = 0
+
+    let ret = wolfcrypt.wc_curve25519_init( this.curve25519 )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_curve25519_init ${ ret }`
+    }
+  }
+
+  /**
+   * Makes a new curve25519 key and fills the key struct with the key data
+   *
+   * @throws {Error} If the curve25519 key is not allocated.
+   *
+   * @throws {Error} If wc_curve25519_make_key fails.
+   */
+  make_key()
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    let ret = wolfcrypt.wc_curve25519_make_key( this.curve25519 )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_curve25519_make_key ${ ret }`
+    }
+  }
+
+  /**
+   * Makes a new curve25519 key and fills the key struct with the key data, callback
+   *
+   * @param cb The callback function to call when the key has been completed.
+   *
+   * @throws {Error} If the curve25519 key is not allocated.
+   */
+  make_key_cb( cb )
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    wolfcrypt.wc_curve25519_make_key_async( this.curve25519, cb )
+  }
+
+  /**
+   * Makes a new curve25519 key and fills the key struct with the key data, promise
+   *
+   * @returns A promise that will resolve when the key is ready and reject if the key fails.
+   *
+   * @throws {Error} If the curve25519 key is not allocated.
+   */
+  make_key_promise()
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    this.pending++
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_curve25519_make_key_async( this.curve25519, ( err, ret ) => {
+        this.pending--
+
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( ret != 0 )
+        {
+          return rej( ret )
+        }
+
+        res()
+      } )
+    } );
+  }
+
+  /**
+   * Exports the raw 32 byte public key
+   *
+   * @returns The public key as a data Buffer.
+   *
+   * @throws {Error} If the curve25519 key is not allocated.
+   *
+   * @throws {Error} If wc_curve25519_export_public fails.
+   */
+  export_public()
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    let pubBuf = Buffer.alloc( CURVE25519_KEY_SIZE )
+
+    let ret = wolfcrypt.wc_curve25519_export_public( this.curve25519, pubBuf, pubBuf.length )
+
+    if ( ret <= 0 )
+    {
+      throw `Failed to wc_curve25519_export_public ${ ret }`
+    }
+
+    return pubBuf
+  }
+
+  /**
+   * Imports a raw 32 byte public key
+   *
+   * @param pubBuf A data Buffer containing the public key.
+   *
+   * @throws {Error} If the curve25519 key is not allocated.
+   *
+   * @throws {Error} If pubBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_curve25519_import_public fails.
+   */
+  import_public( pubBuf )
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    if ( !Buffer.isBuffer( pubBuf ) )
+    {
+      throw 'Public key must be a Buffer'
+    }
+
+    let ret = wolfcrypt.wc_curve25519_import_public( pubBuf, pubBuf.length, this.curve25519 )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_curve25519_import_public ${ ret }`
+    }
+  }
+
+  /**
+   * Exports the raw 32 byte private key
+   *
+   * @returns The private key as a data Buffer.
+   *
+   * @throws {Error} If the curve25519 key is not allocated.
+   *
+   * @throws {Error} If wc_curve25519_export_private_raw fails.
+   */
+  export_private()
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    let privBuf = Buffer.alloc( CURVE25519_KEY_SIZE )
+
+    let ret = wolfcrypt.wc_curve25519_export_private_raw( this.curve25519, privBuf, privBuf.length )
+
+    if ( ret <= 0 )
+    {
+      throw `Failed to wc_curve25519_export_private_raw ${ ret }`
+    }
+
+    return privBuf
+  }
+
+  /**
+   * Imports a raw 32 byte private key, the public key is derived from it
+   *
+   * @param privBuf A data Buffer containing the private key.
+   *
+   * @throws {Error} If the curve25519 key is not allocated.
+   *
+   * @throws {Error} If privBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_curve25519_import_private fails.
+   */
+  import_private( privBuf )
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    if ( !Buffer.isBuffer( privBuf ) )
+    {
+      throw 'Private key must be a Buffer'
+    }
+
+    let ret = wolfcrypt.wc_curve25519_import_private( privBuf, privBuf.length, this.curve25519 )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_curve25519_import_private ${ ret }`
+    }
+  }
+
+  /**
+   * Computes the X25519 shared secret of this key and the key passed in
+   *
+   * @param pubKey WolfSSLCurve25519 holding the public key to use with this private key.
+   *
+   * @returns The 32 byte shared secret as a data Buffer.
+   *
+   * @throws {Error} If either curve25519 key is not allocated.
+   *
+   * @throws {Error} If wc_curve25519_shared_secret fails.
+   */
+  shared_secret( pubKey )
+  {
+    if ( this.curve25519 == null || pubKey.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    let secret = Buffer.alloc( CURVE25519_KEY_SIZE )
+
+    let ret = wolfcrypt.wc_curve25519_shared_secret( this.curve25519, pubKey.curve25519, secret, secret.length )
+
+    if ( ret != CURVE25519_KEY_SIZE )
+    {
+      throw `Failed to wc_curve25519_shared_secret ${ ret }`
+    }
+
+    return secret
+  }
+
+  /**
+   * Computes the X25519 shared secret of this key and the key passed in on the thread pool
+   *
+   * @param pubKey WolfSSLCurve25519 holding the public key to use with this private key.
+   *
+   * @returns A promise that resolves with the shared secret as a data Buffer.
+   *
+   * @throws {Error} If either curve25519 key is not allocated.
+   */
+  shared_secret_async( pubKey )
+  {
+    if ( this.curve25519 == null || pubKey.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    this.pending++
+    pubKey.pending++
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_curve25519_shared_secret_async( this.curve25519, pubKey.curve25519, ( err, ret, secret ) => {
+        this.pending--
+        pubKey.pending--
+
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( ret <= 0 )
+        {
+          return rej( `Failed to wc_curve25519_shared_secret ${ ret }` )
+        }
+
+        res( secret )
+      } )
+    } )
+  }
+
+  /**
+   * Computes the X25519 shared secrets of this key with many public keys in
+   * one call, reusing the private key for all of them
+   *
+   * @param pubKeys Array of WolfSSLCurve25519 keys or 32 byte little endian public key Buffers.
+   *
+   * @returns Array with the 32 byte shared secret of each public key, null where it failed.
+   *
+   * @throws {Error} If the curve25519 key is not allocated.
+   *
+   * @throws {Error} If wc_curve25519_shared_secret_many fails.
+   */
+  shared_secret_many( pubKeys )
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    const secrets = wolfcrypt.wc_curve25519_shared_secret_many( this.curve25519, packPublics( pubKeys ) )
+
+    if ( typeof secrets == 'number' )
+    {
+      throw `Failed to wc_curve25519_shared_secret_many ${ secrets }`
+    }
+
+    return splitSecrets( secrets )
+  }
+
+  /**
+   * Computes the shared secrets like shared_secret_many with the public keys
+   * split across the thread pool
+   *
+   * @param pubKeys Array of WolfSSLCurve25519 keys or 32 byte little endian public key Buffers.
+   *
+   * @returns A promise that resolves with the array of shared secrets, null where it failed.
+   *
+   * @throws {Error} If the curve25519 key is not allocated.
+   */
+  shared_secret_many_async( pubKeys )
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    const packed = packPublics( pubKeys )
+
+    this.pending++
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_curve25519_shared_secret_many_async( this.curve25519, packed, ( err, ret, secrets ) => {
+        this.pending--
+
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( secrets == null )
+        {
+          return rej( `Failed to wc_curve25519_shared_secret_many ${ ret }` )
+        }
+
+        res( splitSecrets( secrets ) )
+      } )
+    } )
+  }
+
+  /**
+   * Makes a new key like make_key, or like make_key_promise once the watchdog
+   * has seen wc_curve25519_make_key block the event loop and rerouting is on
+   *
+   * @returns A promise that resolves when the key is finished.
+   */
+  make_key_auto()
+  {
+    return runAuto( 'wc_curve25519_make_key', () => this.make_key(), () => this.make_key_promise() )
+  }
+
+  /**
+   * Computes the shared secret, sync or async as picked by the watchdog
+   *
+   * @param pubKey The WolfSSLCurve25519 holding the other public key.
+   *
+   * @returns A promise that resolves with the secret.
+   */
+  shared_secret_auto( pubKey )
+  {
+    return runAuto( 'wc_curve25519_shared_secret', () => this.shared_secret( pubKey ), () => this.shared_secret_async( pubKey ) )
+  }
+
+  /**
+   * Frees the data allocated by the curve25519 key
+   *
+   * @throws {Error} If curve25519 key is not allocated.
+   */
+  free()
+  {
+    if ( this.curve25519 == null )
+    {
+      throw 'Curve25519 not allocated'
+    }
+
+    if ( this.pending > 0 )
+    {
+      throw 'Curve25519 key has pending operations'
+    }
+
+    wolfcrypt.wc_curve25519_free( this.curve25519 )
+    wolfcrypt.nodejsHandleRelease( this.curve25519 )
+    this.curve25519 = null
+  }
+}
+
+exports.WolfSSLCurve25519 = WolfSSLCurve25519
@@ -19,17 +19,81 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { packBatch } = require( './util/batch' )
+const { runAuto } = require( './util/auto' )
+
+function verifyBatch( keys, sigs, hashes, run )
+{
+  if ( !Array.isArray( sigs ) || !Array.isArray( hashes ) || sigs.length != hashes.length )
+  {
+    throw 'sigs and hashes must be arrays of the same length'
+  }
+
+  const packedSigs = packBatch( sigs, 'sigs' )
+  const packedHashes = packBatch( hashes, 'hashes' )
+
+  keys.forEach( ( key ) => key.pending++ )
+
+  return new Promise( ( res, rej ) => {
+    run( packedSigs.data, packedSigs.offsets, packedHashes.data, packedHashes.offsets, ( err, ret, results ) => {
+      keys.forEach( ( key ) => key.pending-- )
+
+      if ( err )
+      {
+        return rej( err )
+      }
+
+      if ( ret < 0 )
+      {
+        return rej( `Failed to wc_ecc_verify_hash_batch ${ ret }` )
+      }
+
+      res( results )
+    } )
+  } )
+}
+
+function cachedKey( derBuf, isPrivate )
+{
+  if ( !Buffer.isBuffer( derBuf ) )
+  {
+    throw `${ isPrivate ? 'Private' : 'Public' } key der must be a Buffer`
+  }
+
+  let handle = wolfcrypt.nodejsEccKeyCached( derBuf, derBuf.length, isPrivate )
+
+  if ( typeof handle == 'number' )
+  {
+    throw `Failed to ${ isPrivate ? 'wc_EccPrivateKeyDecode' : 'wc_EccPublicKeyDecode' } ${ handle }`
+  }
+
+  let ecc = Object.create( WolfSSLEcc.prototype )
+  ecc.ecc = handle
+  ecc.pending = 0
+  ecc.cached = true
+
+  return ecc
+}
 
 class WolfSSLEcc
 {
   /**
-   * Creates a new ecc_key structure by calling sizeof_ecc_key and wc_ecc_init
+   * Creates a new ecc_key structure in native memory and calls wc_ecc_init
    *
-   * @remarks free must be called to free the ecc key data
+   * @remarks free should be called to free the ecc key data, a key that is
+   * collected without it is freed by its finalizer
    */
   constructor()
   {
-    this.ecc = Buffer.alloc( wolfcrypt.sizeof_ecc_key() )
+    this.ecc = wolfcrypt.nodejsEccKeyNew()
+
+    if ( typeof this.ecc == 'number' )
+    {
+      throw `Failed to nodejsEccKeyNew ${ this.ecc }`
+    }
+
+    this.pending = 0
+    this.cached = false
 
     let ret = wolfcrypt.wc_ecc_init( this.ecc )
 
@@ -39,6 +103,68 @@ class WolfSSLEcc
     }
   }
 
+  /**
+   * Returns the private key of a Der Buffer from the native key cache, the
+   * Der is only decoded the first time it is seen
+   *
+   * @param derBuf A data Buffer containing the Der private key.
+   *
+   * @returns A WolfSSLEcc sharing the cached key, it can't be changed and free only drops this handle.
+   *
+   * @throws {Error} If derBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_EccPrivateKeyDecode fails.
+   */
+  static PrivateKeyDecodeCached( derBuf )
+  {
+    return cachedKey( derBuf, true )
+  }
+
+  /**
+   * Returns the public key of a Der Buffer from the native key cache, the Der
+   * is only decoded the first time it is seen
+   *
+   * @param derBuf A data Buffer containing the Der public key.
+   *
+   * @returns A WolfSSLEcc sharing the cached key, it can't be changed and free only drops this handle.
+   *
+   * @throws {Error} If derBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_EccPublicKeyDecode fails.
+   */
+  static PublicKeyDecodeCached( derBuf )
+  {
+    return cachedKey( derBuf, false )
+  }
+
+  /**
+   * Returns a new key from the native key pool configured with
+   * WolfSSL_KeyPoolConfigure, or makes one on the thread pool when the pool
+   * is empty or there is none for this size
+   *
+   * @param size The size of the ecc key.
+   *
+   * @returns A promise that resolves with a WolfSSLEcc owning the new key.
+   */
+  static make_key_pooled( size )
+  {
+    let handle = wolfcrypt.nodejsEccKeyPooled( size )
+
+    if ( handle == null )
+    {
+      let ecc = new WolfSSLEcc()
+
+      return ecc.make_key_promise( size ).then( () => ecc )
+    }
+
+    let ecc = Object.create( WolfSSLEcc.prototype )
+    ecc.ecc = handle
+    ecc.pending = 0
+    ecc.cached = false
+
+    return Promise.resolve( ecc )
+  }
+
   /**
    * Makes a new ecc key and fills the ecc struct with the key data
    *
@@ -55,6 +181,11 @@ class WolfSSLEcc
       throw 'Ecc not allocated'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     let ret = wolfcrypt.wc_ecc_make_key( size, this.ecc )
 
     if ( ret != 0 )
@@ -79,6 +210,11 @@ class WolfSSLEcc
       throw 'Ecc not allocated'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     wolfcrypt.wc_ecc_make_key_async( size, this.ecc, cb )
   }
 
@@ -98,6 +234,11 @@ class WolfSSLEcc
       throw 'Ecc not allocated'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     return new Promise( ( res, rej ) => {
       wolfcrypt.wc_ecc_make_key_async( size, this.ecc, ( err, ret ) => {
         if ( err )
@@ -223,6 +364,11 @@ class WolfSSLEcc
       throw 'Ecc not allocated'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     if ( !Buffer.isBuffer( derBuf ) )
     {
       throw 'Public key der must be a Buffer'
@@ -282,6 +428,11 @@ class WolfSSLEcc
       throw 'Ecc not allocated'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     if ( !Buffer.isBuffer( derBuf ) )
     {
       throw 'Private key der must be a Buffer'
@@ -313,6 +464,11 @@ class WolfSSLEcc
       throw 'Ecc not allocated'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     let ret = wolfcrypt.wc_ecc_set_curve( this.ecc, keySize, curveId )
 
     if ( ret != 0 )
@@ -451,6 +607,255 @@ class WolfSSLEcc
     return false
   }
 
+  /**
+   * Computes the signature of the data passed in using this private key on the thread pool
+   *
+   * @param data The data to be signed, as string or Buffer.
+   *
+   * @returns A promise that resolves with the signature for this data.
+   *
+   * @throws {Error} If ecc key is not allocated.
+   *
+   * @throws {Error} If data is not a string or Buffer.
+   */
+  sign_hash_async( data )
+  {
+    if ( this.ecc == null )
+    {
+      throw 'Ecc not allocated'
+    }
+
+    if ( typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
+
+    if ( !Buffer.isBuffer( data ) )
+    {
+      throw 'Data must be string or Buffer'
+    }
+
+    this.pending++
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_ecc_sign_hash_async( data, data.length, this.ecc, ( err, ret, sig ) => {
+        this.pending--
+
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( ret <= 0 )
+        {
+          return rej( `Failed to wc_ecc_sign_hash ${ ret }` )
+        }
+
+        res( sig )
+      } )
+    } )
+  }
+
+  /**
+   * Verifies the signature of the data passed in using this public key on the thread pool
+   *
+   * @param sig The signature to verify.
+   *
+   * @param hash The original data that the signature was generated from, as a string or Buffer.
+   *
+   * @returns A promise that resolves with true if the signature matches, false otherwise.
+   *
+   * @throws {Error} If ecc key is not allocated.
+   *
+   * @throws {Error} If sig or hash is not a string or Buffer.
+   */
+  verify_hash_async( sig, hash )
+  {
+    if ( this.ecc == null )
+    {
+      throw 'Ecc not allocated'
+    }
+
+    if ( typeof sig == 'string' )
+    {
+      sig = Buffer.from( sig )
+    }
+
+    if ( typeof hash == 'string' )
+    {
+      hash = Buffer.from( hash )
+    }
+
+    if ( !Buffer.isBuffer( sig ) || !Buffer.isBuffer( hash ) )
+    {
+      throw 'sig and hash must be strings or Buffers'
+    }
+
+    this.pending++
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_ecc_verify_hash_async( sig, sig.length, hash, hash.length, this.ecc, ( err, ret ) => {
+        this.pending--
+
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( ret < 0 )
+        {
+          return rej( `Failed to wc_ecc_verify_hash ${ ret }` )
+        }
+
+        res( ret == 1 )
+      } )
+    } )
+  }
+
+  /**
+   * Verifies a batch of signatures using this public key on the thread pool,
+   * large batches are split across several workers
+   *
+   * @param sigs Array of signatures to verify.
+   *
+   * @param hashes Array of the data each signature was generated from, as strings or Buffers.
+   *
+   * @returns A promise that resolves with a Uint8Array holding 1 for each valid signature and 0 otherwise.
+   *
+   * @throws {Error} If ecc key is not allocated.
+   *
+   * @throws {Error} If sigs and hashes are not arrays of the same length.
+   */
+  verify_hash_batch( sigs, hashes )
+  {
+    if ( this.ecc == null )
+    {
+      throw 'Ecc not allocated'
+    }
+
+    return verifyBatch( [ this ], sigs, hashes, ( ...args ) => wolfcrypt.wc_ecc_verify_hash_batch( this.ecc, ...args ) )
+  }
+
+  /**
+   * Verifies a batch of signatures each with its own public key on the thread pool
+   *
+   * @param keys Array of WolfSSLEcc public keys, one per signature.
+   *
+   * @param sigs Array of signatures to verify.
+   *
+   * @param hashes Array of the data each signature was generated from, as strings or Buffers.
+   *
+   * @returns A promise that resolves with a Uint8Array holding 1 for each valid signature and 0 otherwise.
+   *
+   * @throws {Error} If any ecc key is not allocated.
+   *
+   * @throws {Error} If keys, sigs and hashes are not arrays of the same length.
+   */
+  static verify_hash_batch_multi( keys, sigs, hashes )
+  {
+    if ( !Array.isArray( keys ) || keys.length != sigs.length )
+    {
+      throw 'keys must be an array with one key per signature'
+    }
+
+    if ( keys.some( ( key ) => key.ecc == null ) )
+    {
+      throw 'Ecc not allocated'
+    }
+
+    return verifyBatch( keys, sigs, hashes, ( ...args ) => wolfcrypt.wc_ecc_verify_hash_batch_multi( keys.map( ( key ) => key.ecc ), ...args ) )
+  }
+
+  /**
+   * Computes the shared secret of this key and the key passed in on the thread pool
+   *
+   * @param pubEcc Public key to use with this private key.
+   *
+   * @returns A promise that resolves with the shared secret as a data Buffer.
+   *
+   * @throws {Error} If either ecc key is not allocated.
+   */
+  shared_secret_async( pubEcc )
+  {
+    if ( this.ecc == null || pubEcc.ecc == null )
+    {
+      throw 'Ecc not allocated'
+    }
+
+    this.pending++
+    pubEcc.pending++
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_ecc_shared_secret_async( this.ecc, pubEcc.ecc, ( err, ret, secret ) => {
+        this.pending--
+        pubEcc.pending--
+
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( ret <= 0 )
+        {
+          return rej( `Failed to wc_ecc_shared_secret ${ ret }` )
+        }
+
+        res( secret )
+      } )
+    } )
+  }
+
+  /**
+   * Makes a new key like make_key, or like make_key_promise once the watchdog
+   * has seen wc_ecc_make_key block the event loop and rerouting is on
+   *
+   * @param size The size of the key in bytes.
+   *
+   * @returns A promise that resolves when the key is finished.
+   */
+  make_key_auto( size )
+  {
+    return runAuto( 'wc_ecc_make_key', () => this.make_key( size ), () => this.make_key_promise( size ) )
+  }
+
+  /**
+   * Signs data, sync or async as picked by the watchdog
+   *
+   * @param data The data to be signed, as string or Buffer.
+   *
+   * @returns A promise that resolves with the signature.
+   */
+  sign_hash_auto( data )
+  {
+    return runAuto( 'wc_ecc_sign_hash', () => this.sign_hash( data ), () => this.sign_hash_async( data ) )
+  }
+
+  /**
+   * Verifies a signature, sync or async as picked by the watchdog
+   *
+   * @param sig The signature to verify.
+   *
+   * @param hash The data that was signed, as string or Buffer.
+   *
+   * @returns A promise that resolves with true if the signature is valid.
+   */
+  verify_hash_auto( sig, hash )
+  {
+    return runAuto( 'wc_ecc_verify_hash', () => this.verify_hash( sig, hash ), () => this.verify_hash_async( sig, hash ) )
+  }
+
+  /**
+   * Computes the shared secret, sync or async as picked by the watchdog
+   *
+   * @param pubEcc The WolfSSLEcc holding the other public key.
+   *
+   * @returns A promise that resolves with the secret.
+   */
+  shared_secret_auto( pubEcc )
+  {
+    return runAuto( 'wc_ecc_shared_secret', () => this.shared_secret( pubEcc ), () => this.shared_secret_async( pubEcc ) )
+  }
+
   /**
    * Frees the data allocated by the ecc key
    *
@@ -465,7 +870,21 @@ class WolfSSLEcc
       throw 'Ecc not allocated'
     }
 
+    if ( this.pending > 0 )
+    {
+      throw 'Ecc key has pending operations'
+    }
+
+    // the cache and other handles still use the key
+    if ( this.cached )
+    {
+      this.ecc = null
+
+      return
+    }
+
     let ret = wolfcrypt.wc_ecc_free( this.ecc )
+    wolfcrypt.nodejsHandleRelease( this.ecc )
     this.ecc = null
 
     if ( ret != 0 )
@@ -0,0 +1,160 @@
+/* ecc_fp.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+
+function warmKeys( keys, keySizes )
+{
+  if ( !Array.isArray( keys ) || !Array.isArray( keySizes ) )
+  {
+    throw 'keys and keySizes must be arrays'
+  }
+
+  return keys.map( ( key ) => {
+    if ( key.ecc == null )
+    {
+      throw 'Ecc not allocated'
+    }
+
+    return key.ecc
+  } )
+}
+
+/**
+ * Builds the FP_ECC fixed point tables for public keys and curve generators
+ * on every libuv pool thread, so async verifications against them take the
+ * precomputed path whichever thread they run on. The main thread is left
+ * alone, WolfSSL_EccFpWarmSync warms it for the sync calls.
+ *
+ * @param keys An array of WolfSSLEcc holding the public keys to warm.
+ * @param keySizes An array of curve key sizes in bytes, such as 32 for
+ * P-256, whose generators to warm, signing and key generation use these.
+ *
+ * @returns A Promise resolving with WolfSSL_EccFpStats() once every thread
+ * is warm, it rejects if another job held a pool thread so long that it was
+ * never reached.
+ *
+ * @throws {Error} If a key is not allocated or can't be exported.
+ */
+const WolfSSL_EccFpWarm = function( keys, keySizes = [] )
+{
+  const handles = warmKeys( keys, keySizes )
+
+  return new Promise( ( res, rej ) => {
+    let ret = wolfcrypt.nodejsEccFpWarm( handles, keySizes, ( err, ret, done, threads ) => {
+      if ( err )
+      {
+        return rej( err )
+      }
+
+      if ( ret < 0 )
+      {
+        return rej( `Failed to nodejsEccFpWarm ${ ret }` )
+      }
+
+      if ( done < threads )
+      {
+        return rej( `nodejsEccFpWarm only reached ${ done } of ${ threads } pool threads` )
+      }
+
+      res( WolfSSL_EccFpStats() )
+    } )
+
+    if ( typeof ret == 'number' )
+    {
+      rej( `Failed to wc_ecc_export_x963 ${ ret }` )
+    }
+  } )
+}
+
+/**
+ * Builds the same tables as WolfSSL_EccFpWarm on the calling thread, which
+ * blocks it while they are built
+ *
+ * @param keys An array of WolfSSLEcc holding the public keys to warm.
+ * @param keySizes An array of curve key sizes in bytes whose generators to warm.
+ *
+ * @returns WolfSSL_EccFpStats().
+ *
+ * @throws {Error} If a key is not allocated or warming fails.
+ */
+const WolfSSL_EccFpWarmSync = function( keys, keySizes = [] )
+{
+  const ret = wolfcrypt.nodejsEccFpWarmSync( warmKeys( keys, keySizes ), keySizes )
+
+  if ( ret < 0 )
+  {
+    throw `Failed to nodejsEccFpWarmSync ${ ret }`
+  }
+
+  return WolfSSL_EccFpStats()
+}
+
+/**
+ * Reports the fixed point tables warmed by WolfSSL_EccFpWarm. wolfSSL
+ * doesn't expose its cache, so other operations using up entries aren't
+ * counted, and the least recently warmed bases are assumed gone once a
+ * thread has warmed more than capacity of them.
+ *
+ * @returns An object { enabled, shared, capacity, threads }, shared is true
+ * when wolfSSL is built without HAVE_THREAD_LS and all threads use one cache,
+ * threads holds { main, entries, curves, keys } for each warmed thread with
+ * the key sizes of the warm generators in curves and the x963 of the warm
+ * public keys in keys.
+ */
+const WolfSSL_EccFpStats = function()
+{
+  return wolfcrypt.nodejsEccFpStats()
+}
+
+/**
+ * Frees the fixed point tables on the main thread and every libuv pool thread
+ *
+ * @returns A Promise resolving once every thread's tables are freed, it
+ * rejects like WolfSSL_EccFpWarm when a pool thread was never reached.
+ */
+const WolfSSL_EccFpFree = function()
+{
+  return new Promise( ( res, rej ) => {
+    wolfcrypt.nodejsEccFpFree( ( err, ret, done, threads ) => {
+      if ( err )
+      {
+        return rej( err )
+      }
+
+      if ( ret < 0 )
+      {
+        return rej( `Failed to wc_ecc_fp_free ${ ret }` )
+      }
+
+      if ( done < threads )
+      {
+        return rej( `nodejsEccFpFree only reached ${ done } of ${ threads } pool threads` )
+      }
+
+      res()
+    } )
+  } )
+}
+
+exports.WolfSSL_EccFpWarm = WolfSSL_EccFpWarm
+exports.WolfSSL_EccFpWarmSync = WolfSSL_EccFpWarmSync
+exports.WolfSSL_EccFpStats = WolfSSL_EccFpStats
+exports.WolfSSL_EccFpFree = WolfSSL_EccFpFree
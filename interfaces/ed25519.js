@@ -0,0 +1,704 @@
+/* ed25519.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { packBatch } = require( './util/batch' )
+const { runAuto } = require( './util/auto' )
+
+const ED25519_KEY_SIZE = 32
+const ED25519_SIG_SIZE = 64
+// large enough for a private key Der holding the public key as well
+const ED25519_DER_SIZE = 128
+
+function verifyBatch( keys, sigs, msgs, run )
+{
+  if ( !Array.isArray( sigs ) || !Array.isArray( msgs ) || sigs.length != msgs.length )
+  {
+    throw 'sigs and msgs must be arrays of the same length'
+  }
+
+  const packedSigs = packBatch( sigs, 'sigs' )
+  const packedMsgs = packBatch( msgs, 'msgs' )
+
+  keys.forEach( ( key ) => key.pending++ )
+
+  return new Promise( ( res, rej ) => {
+    run( packedSigs.data, packedSigs.offsets, packedMsgs.data, packedMsgs.offsets, ( err, ret, results ) => {
+      keys.forEach( ( key ) => key.pending-- )
+
+      if ( err )
+      {
+        return rej( err )
+      }
+
+      if ( ret < 0 )
+      {
+        return rej( `Failed to wc_ed25519_verify_msg_batch ${ ret }` )
+      }
+
+      res( results )
+    } )
+  } )
+}
+
+class WolfSSLEd25519
+{
+  /**
+   * Creates a new ed25519_key structure in native memory and calls
+   * wc_ed25519_init
+   *
+   * @remarks free should be called to free the ed25519 key data, a key that
+   * is collected without it is freed by its finalizer
+   *
+   * @throws {Error} If wolfcrypt is built without HAVE_ED25519.
+   */
+  constructor()
+  {
+    if ( wolfcrypt.nodejsEd25519KeyNew == null )
+    {
+      throw 'Ed25519 not compiled in'
+    }
+
+    this.ed25519 = wolfcrypt.nodejsEd25519KeyNew()
+
+    if ( typeof this.ed25519 == 'number' )
+    {
+      throw `Failed to nodejsEd25519KeyNew ${ this.ed25519 }`
+    }
+
+    this.pending = 0
+
+    let ret = wolfcrypt.wc_ed25519_init( this.ed25519 )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_ed25519_init ${ ret }`
+    }
+  }
+
+  /**
+   * Makes a new ed25519 key and fills the key struct with the key data
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   *
+   * @throws {Error} If wc_ed25519_make_key fails.
+   */
+  make_key()
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    let ret = wolfcrypt.wc_ed25519_make_key( this.ed25519 )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_ed25519_make_key ${ ret }`
+    }
+  }
+
+  /**
+   * Makes a new ed25519 key and fills the key struct with the key data, callback
+   *
+   * @param cb The callback function to call when the key has been completed.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   */
+  make_key_cb( cb )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    wolfcrypt.wc_ed25519_make_key_async( this.ed25519, cb )
+  }
+
+  /**
+   * Makes a new ed25519 key and fills the key struct with the key data, promise
+   *
+   * @returns A promise that will resolve when the key is ready and reject if the key fails.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   */
+  make_key_promise()
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    this.pending++
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_ed25519_make_key_async( this.ed25519, ( err, ret ) => {
+        this.pending--
+
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( ret != 0 )
+        {
+          return rej( ret )
+        }
+
+        res()
+      } )
+    } );
+  }
+
+  /**
+   * Exports the raw 32 byte public key
+   *
+   * @returns The public key as a data Buffer.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   *
+   * @throws {Error} If wc_ed25519_export_public fails.
+   */
+  export_public()
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    let pubBuf = Buffer.alloc( ED25519_KEY_SIZE )
+
+    let ret = wolfcrypt.wc_ed25519_export_public( this.ed25519, pubBuf, pubBuf.length )
+
+    if ( ret <= 0 )
+    {
+      throw `Failed to wc_ed25519_export_public ${ ret }`
+    }
+
+    return pubBuf
+  }
+
+  /**
+   * Imports a raw 32 byte public key
+   *
+   * @param pubBuf A data Buffer containing the public key.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   *
+   * @throws {Error} If pubBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_ed25519_import_public fails.
+   */
+  import_public( pubBuf )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    if ( !Buffer.isBuffer( pubBuf ) )
+    {
+      throw 'Public key must be a Buffer'
+    }
+
+    let ret = wolfcrypt.wc_ed25519_import_public( pubBuf, pubBuf.length, this.ed25519 )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_ed25519_import_public ${ ret }`
+    }
+  }
+
+  /**
+   * Exports the raw 32 byte private key, the seed the key pair is made from
+   *
+   * @returns The private key as a data Buffer.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   *
+   * @throws {Error} If wc_ed25519_export_private_only fails.
+   */
+  export_private()
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    let privBuf = Buffer.alloc( ED25519_KEY_SIZE )
+
+    let ret = wolfcrypt.wc_ed25519_export_private_only( this.ed25519, privBuf, privBuf.length )
+
+    if ( ret <= 0 )
+    {
+      throw `Failed to wc_ed25519_export_private_only ${ ret }`
+    }
+
+    return privBuf
+  }
+
+  /**
+   * Imports a raw 32 byte private key
+   *
+   * @param privBuf A data Buffer containing the private key.
+   *
+   * @param pubBuf Optional data Buffer with the matching public key, it is
+   * derived from the private key when left out.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   *
+   * @throws {Error} If privBuf or pubBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_ed25519_import_private_key fails.
+   */
+  import_private( privBuf, pubBuf )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    if ( !Buffer.isBuffer( privBuf ) || ( pubBuf != null && !Buffer.isBuffer( pubBuf ) ) )
+    {
+      throw 'Private and public keys must be Buffers'
+    }
+
+    let ret = wolfcrypt.wc_ed25519_import_private_key( privBuf, privBuf.length, pubBuf, pubBuf == null ? 0 : pubBuf.length, this.ed25519 )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_ed25519_import_private_key ${ ret }`
+    }
+  }
+
+  /**
+   * Exports the ed25519 public key to Der format
+   *
+   * @returns The Der public key as a data Buffer.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   *
+   * @throws {Error} If wc_Ed25519PublicKeyToDer fails.
+   */
+  PublicKeyToDer()
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    let derBuf = Buffer.alloc( ED25519_DER_SIZE )
+
+    let ret = wolfcrypt.wc_Ed25519PublicKeyToDer( this.ed25519, derBuf, derBuf.length )
+
+    if ( ret <= 0 )
+    {
+      throw `Failed to wc_Ed25519PublicKeyToDer ${ ret }`
+    }
+
+    return derBuf.subarray( 0, ret )
+  }
+
+  /**
+   * Imports the ed25519 public key from Der format
+   *
+   * @param derBuf A data Buffer containing the Der public key.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   *
+   * @throws {Error} If derBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_Ed25519PublicKeyDecode fails.
+   */
+  PublicKeyDecode( derBuf )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    if ( !Buffer.isBuffer( derBuf ) )
+    {
+      throw 'Public key der must be a Buffer'
+    }
+
+    let ret = wolfcrypt.wc_Ed25519PublicKeyDecode( derBuf, this.ed25519, derBuf.length )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_Ed25519PublicKeyDecode ${ ret }`
+    }
+  }
+
+  /**
+   * Exports the ed25519 private key to Der format
+   *
+   * @returns The Der private key as a data Buffer.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   *
+   * @throws {Error} If wc_Ed25519KeyToDer fails.
+   */
+  PrivateKeyToDer()
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    let derBuf = Buffer.alloc( ED25519_DER_SIZE )
+
+    let ret = wolfcrypt.wc_Ed25519KeyToDer( this.ed25519, derBuf, derBuf.length )
+
+    if ( ret <= 0 )
+    {
+      throw `Failed to wc_Ed25519KeyToDer ${ ret }`
+    }
+
+    return derBuf.subarray( 0, ret )
+  }
+
+  /**
+   * Imports the ed25519 private key from Der format
+   *
+   * @param derBuf A data Buffer containing the Der private key.
+   *
+   * @throws {Error} If the ed25519 key is not allocated.
+   *
+   * @throws {Error} If derBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_Ed25519PrivateKeyDecode fails.
+   */
+  PrivateKeyDecode( derBuf )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    if ( !Buffer.isBuffer( derBuf ) )
+    {
+      throw 'Private key der must be a Buffer'
+    }
+
+    let ret = wolfcrypt.wc_Ed25519PrivateKeyDecode( derBuf, this.ed25519, derBuf.length )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_Ed25519PrivateKeyDecode ${ ret }`
+    }
+  }
+
+  /**
+   * Signs the message passed in using this private key, ed25519 hashes the
+   * message itself so it is passed whole
+   *
+   * @param msg The message to be signed, as string or Buffer.
+   *
+   * @returns The 64 byte signature for this message.
+   *
+   * @throws {Error} If ed25519 key is not allocated.
+   *
+   * @throws {Error} If wc_ed25519_sign_msg fails.
+   */
+  sign_msg( msg )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    if ( typeof msg == 'string' )
+    {
+      msg = Buffer.from( msg )
+    }
+
+    let sig = Buffer.alloc( ED25519_SIG_SIZE )
+
+    let ret = wolfcrypt.wc_ed25519_sign_msg( msg, msg.length, sig, sig.length, this.ed25519 )
+
+    if ( ret <= 0 )
+    {
+      throw `Failed to wc_ed25519_sign_msg ${ ret }`
+    }
+
+    return sig
+  }
+
+  /**
+   * Verifies the signature of the message passed in using this public key
+   *
+   * @param sig The signature to verify.
+   *
+   * @param msg The message that was signed, as a string or Buffer.
+   *
+   * @returns true if the signature matches, false otherwise.
+   *
+   * @throws {Error} If ed25519 key is not allocated.
+   *
+   * @throws {Error} If wc_ed25519_verify_msg fails.
+   */
+  verify_msg( sig, msg )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    if ( typeof sig == 'string' )
+    {
+      sig = Buffer.from( sig )
+    }
+
+    if ( typeof msg == 'string' )
+    {
+      msg = Buffer.from( msg )
+    }
+
+    let ret = wolfcrypt.wc_ed25519_verify_msg( sig, sig.length, msg, msg.length, this.ed25519 )
+
+    if ( ret < 0 )
+    {
+      throw `Failed to wc_ed25519_verify_msg ${ ret }`
+    }
+
+    return ret == 1
+  }
+
+  /**
+   * Signs the message passed in using this private key on the thread pool
+   *
+   * @param msg The message to be signed, as string or Buffer.
+   *
+   * @returns A promise that resolves with the signature for this message.
+   *
+   * @throws {Error} If ed25519 key is not allocated.
+   *
+   * @throws {Error} If msg is not a string or Buffer.
+   */
+  sign_msg_async( msg )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    if ( typeof msg == 'string' )
+    {
+      msg = Buffer.from( msg )
+    }
+
+    if ( !Buffer.isBuffer( msg ) )
+    {
+      throw 'Msg must be string or Buffer'
+    }
+
+    this.pending++
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_ed25519_sign_msg_async( msg, msg.length, this.ed25519, ( err, ret, sig ) => {
+        this.pending--
+
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( ret <= 0 )
+        {
+          return rej( `Failed to wc_ed25519_sign_msg ${ ret }` )
+        }
+
+        res( sig )
+      } )
+    } )
+  }
+
+  /**
+   * Verifies the signature of the message passed in using this public key on the thread pool
+   *
+   * @param sig The signature to verify.
+   *
+   * @param msg The message that was signed, as a string or Buffer.
+   *
+   * @returns A promise that resolves with true if the signature matches, false otherwise.
+   *
+   * @throws {Error} If ed25519 key is not allocated.
+   *
+   * @throws {Error} If sig or msg is not a string or Buffer.
+   */
+  verify_msg_async( sig, msg )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    if ( typeof sig == 'string' )
+    {
+      sig = Buffer.from( sig )
+    }
+
+    if ( typeof msg == 'string' )
+    {
+      msg = Buffer.from( msg )
+    }
+
+    if ( !Buffer.isBuffer( sig ) || !Buffer.isBuffer( msg ) )
+    {
+      throw 'sig and msg must be strings or Buffers'
+    }
+
+    this.pending++
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_ed25519_verify_msg_async( sig, sig.length, msg, msg.length, this.ed25519, ( err, ret ) => {
+        this.pending--
+
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( ret < 0 )
+        {
+          return rej( `Failed to wc_ed25519_verify_msg ${ ret }` )
+        }
+
+        res( ret == 1 )
+      } )
+    } )
+  }
+
+  /**
+   * Verifies a batch of signatures using this public key on the thread pool,
+   * large batches are split across several workers
+   *
+   * @param sigs Array of signatures to verify.
+   *
+   * @param msgs Array of the messages each signature was made over, as strings or Buffers.
+   *
+   * @returns A promise that resolves with a Uint8Array holding 1 for each valid signature and 0 otherwise.
+   *
+   * @throws {Error} If ed25519 key is not allocated.
+   *
+   * @throws {Error} If sigs and msgs are not arrays of the same length.
+   */
+  verify_msg_batch( sigs, msgs )
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    return verifyBatch( [ this ], sigs, msgs, ( ...args ) => wolfcrypt.wc_ed25519_verify_msg_batch( this.ed25519, ...args ) )
+  }
+
+  /**
+   * Verifies a batch of signatures each with its own public key on the thread pool
+   *
+   * @param keys Array of WolfSSLEd25519 public keys, one per signature.
+   *
+   * @param sigs Array of signatures to verify.
+   *
+   * @param msgs Array of the messages each signature was made over, as strings or Buffers.
+   *
+   * @returns A promise that resolves with a Uint8Array holding 1 for each valid signature and 0 otherwise.
+   *
+   * @throws {Error} If any ed25519 key is not allocated.
+   *
+   * @throws {Error} If keys, sigs and msgs are not arrays of the same length.
+   */
+  static verify_msg_batch_multi( keys, sigs, msgs )
+  {
+    if ( !Array.isArray( keys ) || keys.length != sigs.length )
+    {
+      throw 'keys must be an array with one key per signature'
+    }
+
+    if ( keys.some( ( key ) => key.ed25519 == null ) )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    return verifyBatch( keys, sigs, msgs, ( ...args ) => wolfcrypt.wc_ed25519_verify_msg_batch_multi( keys.map( ( key ) => key.ed25519 ), ...args ) )
+  }
+
+  /**
+   * Makes a new key like make_key, or like make_key_promise once the watchdog
+   * has seen wc_ed25519_make_key block the event loop and rerouting is on
+   *
+   * @returns A promise that resolves when the key is finished.
+   */
+  make_key_auto()
+  {
+    return runAuto( 'wc_ed25519_make_key', () => this.make_key(), () => this.make_key_promise() )
+  }
+
+  /**
+   * Signs a message, sync or async as picked by the watchdog
+   *
+   * @param msg The message to be signed, as string or Buffer.
+   *
+   * @returns A promise that resolves with the signature.
+   */
+  sign_msg_auto( msg )
+  {
+    return runAuto( 'wc_ed25519_sign_msg', () => this.sign_msg( msg ), () => this.sign_msg_async( msg ) )
+  }
+
+  /**
+   * Verifies a signature, sync or async as picked by the watchdog
+   *
+   * @param sig The signature to verify.
+   *
+   * @param msg The message that was signed, as string or Buffer.
+   *
+   * @returns A promise that resolves with true if the signature is valid.
+   */
+  verify_msg_auto( sig, msg )
+  {
+    return runAuto( 'wc_ed25519_verify_msg', () => this.verify_msg( sig, msg ), () => this.verify_msg_async( sig, msg ) )
+  }
+
+  /**
+   * Frees the data allocated by the ed25519 key
+   *
+   * @throws {Error} If ed25519 key is not allocated.
+   */
+  free()
+  {
+    if ( this.ed25519 == null )
+    {
+      throw 'Ed25519 not allocated'
+    }
+
+    if ( this.pending > 0 )
+    {
+      throw 'Ed25519 key has pending operations'
+    }
+
+    wolfcrypt.wc_ed25519_free( this.ed25519 )
+    wolfcrypt.nodejsHandleRelease( this.ed25519 )
+    this.ed25519 = null
+  }
+}
+
+exports.WolfSSLEd25519 = WolfSSLEd25519
@@ -30,10 +30,204 @@ class WolfSSLEVP
    */
   constructor()
   {
-    this.totalInputLength = 0
+    this.blockSize = 1
+    // input the cipher holds on to, AEAD ciphers may return all of it at final
+    this.buffered = 0
+    this.pending = 0
+    this.aead = false
+    this.authTag = null
+    // async updates run one after another so output stays in input order
+    this.queue = Promise.resolve()
+    // set once an async update fails, later queued updates fail with it
+    this.failed = null
     this.evp = wolfcrypt.EVP_CIPHER_CTX_new()
   }
 
+  /**
+   * Returns the largest number of bytes update can write for an input of the given length.
+   *
+   * @param length The length of the input.
+   *
+   * @returns The output size needed by updateInto.
+   */
+  updateSize( length )
+  {
+    return this.blockSize > 1 ? length + this.blockSize : length
+  }
+
+  /**
+   * Returns the largest number of bytes finalize can write.
+   *
+   * @returns The output size needed by finalizeInto.
+   */
+  finalSize()
+  {
+    return this.buffered + this.blockSize
+  }
+
+  /**
+   * Initializes the cipher by calling EVP_CipherInit, AEAD ciphers ( GCM, CCM
+   * and ChaCha20-Poly1305 ) with an iv that isn't 12 bytes have the iv length
+   * set before the key and iv are loaded
+   *
+   * @param cipher the cipher to be used
+   * @param key the key
+   * @param iv the initialization vector or nonce
+   * @param enc 1 to encrypt, 0 to decrypt
+   * @param options optional aad, authTag ( decryption ) and authTagLength
+   *
+   * @throws {Error} If EVP_CipherInit fails.
+   */
+  init( cipher, key, iv, enc, options = {} )
+  {
+    let ret
+
+    this.aead = /GCM|CCM|POLY1305/i.test( cipher )
+    this.encrypting = enc == 1
+    this.authTagLength = options.authTagLength > 0 ? options.authTagLength : 16
+
+    if ( this.aead && iv.length != 12 )
+    {
+      ret = wolfcrypt.EVP_CipherInit( this.evp, cipher, null, null, enc )
+
+      if ( ret == 1 )
+      {
+        ret = wolfcrypt.EVP_CIPHER_CTX_set_iv_length( this.evp, iv.length )
+      }
+
+      if ( ret == 1 )
+      {
+        ret = wolfcrypt.EVP_CipherInit( this.evp, null, key, iv, enc )
+      }
+    }
+    else
+    {
+      ret = wolfcrypt.EVP_CipherInit( this.evp, cipher, key, iv, enc )
+    }
+
+    if ( ret != 1 )
+    {
+      throw `Failed to EVP_CipherInit ${ ret }`
+    }
+
+    this.blockSize = wolfcrypt.EVP_CIPHER_CTX_block_size( this.evp )
+
+    if ( options.aad != null )
+    {
+      this.setAAD( options.aad )
+    }
+
+    if ( options.authTag != null )
+    {
+      this.setAuthTag( options.authTag )
+    }
+  }
+
+  /**
+   * Adds additional authenticated data to an AEAD cipher.
+   *
+   * @param aad The aad as a string or Buffer.
+   *
+   * @throws {Error} If the cipher is not an AEAD cipher or EVP_CipherUpdateAAD fails.
+   *
+   * @remarks This function can be called multiple times but only before the first update.
+   */
+  setAAD( aad )
+  {
+    if ( this.evp == null )
+    {
+      throw 'Cipher is not allocated'
+    }
+
+    if ( !this.aead )
+    {
+      throw 'Cipher is not an AEAD cipher'
+    }
+
+    if ( typeof aad == 'string' )
+    {
+      aad = Buffer.from( aad )
+    }
+
+    let ret = wolfcrypt.EVP_CipherUpdateAAD( this.evp, aad, aad.length )
+
+    if ( ret != 1 )
+    {
+      throw `Failed to EVP_CipherUpdateAAD ${ ret }`
+    }
+  }
+
+  /**
+   * Sets the tag a decryption is checked against when it is finalized.
+   *
+   * @param tag The expected tag as a Buffer.
+   *
+   * @throws {Error} If the cipher is not an AEAD decryptor or setting the tag fails.
+   */
+  setAuthTag( tag )
+  {
+    if ( this.evp == null )
+    {
+      throw 'Cipher is not allocated'
+    }
+
+    if ( !this.aead || this.encrypting )
+    {
+      throw 'Cipher is not an AEAD decryptor'
+    }
+
+    if ( !Buffer.isBuffer( tag ) )
+    {
+      throw 'tag must be a Buffer'
+    }
+
+    let ret = wolfcrypt.EVP_CIPHER_CTX_set_tag( this.evp, tag )
+
+    if ( ret != 1 )
+    {
+      throw `Failed to EVP_CIPHER_CTX_set_tag ${ ret }`
+    }
+  }
+
+  /**
+   * Returns the tag of a finalized AEAD encryption.
+   *
+   * @returns The tag as a Buffer.
+   *
+   * @throws {Error} If the encryption has not been finalized.
+   */
+  getAuthTag()
+  {
+    if ( this.authTag == null )
+    {
+      throw 'Auth tag is only available after an AEAD encryption is finalized'
+    }
+
+    return this.authTag
+  }
+
+  // the tag has to be read before the ctx is freed by finalize
+  readAuthTag()
+  {
+    if ( !this.aead || !this.encrypting )
+    {
+      return
+    }
+
+    let tag = Buffer.alloc( this.authTagLength )
+
+    let ret = wolfcrypt.EVP_CIPHER_CTX_get_tag( this.evp, tag )
+
+    if ( ret != 1 )
+    {
+      this.free()
+
+      throw `Failed to EVP_CIPHER_CTX_get_tag ${ ret }`
+    }
+
+    this.authTag = tag
+  }
+
   /**
    * Updates the internal state with data for cipher.
    *
@@ -57,9 +251,8 @@ class WolfSSLEVP
       data = Buffer.from( data )
     }
 
-    this.totalInputLength += data.length
-
-    let outBuffer = Buffer.alloc( this.totalInputLength )
+    // the cipher overwrites what it returns, no need to zero the buffer
+    let outBuffer = Buffer.allocUnsafe( this.updateSize( data.length ) )
 
     let ret = wolfcrypt.EVP_CipherUpdate( this.evp, outBuffer, data, data.length )
 
@@ -68,16 +261,165 @@ class WolfSSLEVP
       throw 'Failed to update cipher'
     }
 
+    this.buffered += data.length - ret
+
     if ( ret > 0 )
     {
-      this.totalInputLength -= ret;
-
       return outBuffer.subarray( 0, ret )
     }
 
     return Buffer.alloc( 0 )
   }
 
+  /**
+   * Updates the internal state with data for cipher, writing the result into
+   * a caller supplied buffer instead of allocating one.
+   *
+   * @param data The data that will be added to the cipher.
+   *
+   * @param output The Buffer to write the result to.
+   *
+   * @param offset Where in output to start writing, defaults to 0.
+   *
+   * @returns The number of bytes written to output.
+   *
+   * @throws {Error} If output has less than updateSize( data.length ) bytes after offset.
+   *
+   * @throws {Error} If the cipher update fails.
+   */
+  updateInto( data, output, offset = 0 )
+  {
+    if ( this.evp == null )
+    {
+      throw 'Cipher is not allocated'
+    }
+
+    if ( typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
+
+    if ( !Buffer.isBuffer( output ) )
+    {
+      throw 'output must be a Buffer'
+    }
+
+    if ( offset < 0 || output.length - offset < this.updateSize( data.length ) )
+    {
+      throw 'output is too small'
+    }
+
+    let ret = wolfcrypt.EVP_CipherUpdate( this.evp, output, data, data.length, offset )
+
+    if ( ret < 0 )
+    {
+      throw 'Failed to update cipher'
+    }
+
+    this.buffered += data.length - ret
+
+    return ret
+  }
+
+  /**
+   * Updates the internal state with data for cipher on the thread pool, uses callback.
+   *
+   * @param data The data that will be added to the cipher.
+   *
+   * @param cb The callback function that will be called with an error or the result data.
+   *
+   * @throws {Error} If the cipher is not allocated.
+   *
+   * @remarks Calls are queued and run in order, finalize and free must not be
+   * called until every callback has run. After a failed update the remaining
+   * queued updates fail with the same error and the cipher is freed.
+   */
+  update_cb( data, cb )
+  {
+    if ( this.evp == null )
+    {
+      throw 'Cipher is not allocated'
+    }
+
+    if ( typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
+
+    let outBuffer = Buffer.allocUnsafe( this.updateSize( data.length ) )
+
+    this.pending++
+
+    this.queue = this.queue.then( () => new Promise( ( res ) => {
+      // the cipher is freed once the last queued update after a failure has
+      // run, so a failed stream does not keep the ctx alive
+      const done = ( err, out ) => {
+        this.pending--
+        res()
+
+        if ( err && this.failed == null )
+        {
+          this.failed = err
+        }
+
+        if ( this.failed != null && this.pending == 0 && this.evp != null )
+        {
+          this.free()
+        }
+
+        err ? cb( err ) : cb( null, out )
+      }
+
+      if ( this.failed != null )
+      {
+        return done( this.failed )
+      }
+
+      let queued = false
+
+      wolfcrypt.EVP_CipherUpdate_async( this.evp, outBuffer, data, data.length, 0, ( err, ret ) => {
+        // bad arguments are reported before the call returns, defer them so
+        // cb never runs synchronously
+        if ( !queued )
+        {
+          return process.nextTick( () => done( err || 'Failed to update cipher' ) )
+        }
+
+        if ( err )
+        {
+          return done( err )
+        }
+
+        if ( ret < 0 )
+        {
+          return done( 'Failed to update cipher' )
+        }
+
+        this.buffered += data.length - ret
+
+        done( null, outBuffer.subarray( 0, ret ) )
+      } )
+
+      queued = true
+    } ) )
+  }
+
+  /**
+   * Updates the internal state with data for cipher on the thread pool, uses promise.
+   *
+   * @param data The data that will be added to the cipher.
+   *
+   * @returns A promise that resolves with the result data.
+   *
+   * @throws {Error} If the cipher is not allocated.
+   */
+  update_promise( data )
+  {
+    return new Promise( ( res, rej ) => {
+      this.update_cb( data, ( err, out ) => err ? rej( err ) : res( out ) )
+    } )
+  }
+
   /**
    * Finalize the encryption/decryption process.
    *
@@ -95,16 +437,20 @@ class WolfSSLEVP
       throw 'Cipher is not allocated'
     }
 
-    if ( this.totalInputLength % 16 != 0 )
+    if ( this.pending > 0 )
     {
-      this.totalInputLength += ( 16 - this.totalInputLength % 16 )
+      throw 'Cipher has pending operations'
     }
 
-    let outBuffer = Buffer.alloc( this.totalInputLength )
-    this.totalInputLength = 0;
+    let outBuffer = Buffer.alloc( this.finalSize() )
 
     let ret = wolfcrypt.EVP_CipherFinal( this.evp, outBuffer )
 
+    if ( ret >= 0 )
+    {
+      this.readAuthTag()
+    }
+
     this.free()
 
     if ( ret < 0 )
@@ -120,6 +466,52 @@ class WolfSSLEVP
     return Buffer.alloc( 0 )
   }
 
+  /**
+   * Finalize the encryption/decryption process, writing the last block into
+   * a caller supplied buffer.
+   *
+   * @param output The Buffer to write the result to, needs finalSize() bytes after offset.
+   *
+   * @param offset Where in output to start writing, defaults to 0.
+   *
+   * @returns The number of bytes written to output.
+   *
+   * @throws {Error} If the EVP_CipherFinal fails.
+   */
+  finalizeInto( output, offset = 0 )
+  {
+    if ( this.evp == null )
+    {
+      throw 'Cipher is not allocated'
+    }
+
+    if ( this.pending > 0 )
+    {
+      throw 'Cipher has pending operations'
+    }
+
+    if ( !Buffer.isBuffer( output ) || offset < 0 || output.length - offset < this.finalSize() )
+    {
+      throw 'output is too small'
+    }
+
+    let ret = wolfcrypt.EVP_CipherFinal( this.evp, output, offset )
+
+    if ( ret >= 0 )
+    {
+      this.readAuthTag()
+    }
+
+    this.free()
+
+    if ( ret < 0 )
+    {
+      throw 'Failed to finalize cipher'
+    }
+
+    return ret
+  }
+
   /**
    * Frees the evp ctx
    *
@@ -138,6 +530,11 @@ class WolfSSLEVP
       throw 'Cipher is not allocated'
     }
 
+    if ( this.pending > 0 )
+    {
+      throw 'Cipher has pending operations'
+    }
+
     wolfcrypt.EVP_CIPHER_CTX_free( this.evp )
     this.evp = null
   }
@@ -151,11 +548,22 @@ class WolfSSLEncryptor extends WolfSSLEVP
    * @param cipher the cipher to be used
    * @param key aes key
    * @param iv aes initialization vector
+   * @param options optional aad and authTagLength for AEAD ciphers
    */
-  constructor( cipher, key, iv )
+  constructor( cipher, key, iv, options )
   {
     super()
-    wolfcrypt.EVP_CipherInit( this.evp, cipher, key, iv, 1 )
+
+    // the ctx is already allocated, don't leak it when the cipher is rejected
+    try
+    {
+      this.init( cipher, key, iv, 1, options )
+    }
+    catch ( err )
+    {
+      this.free()
+      throw err
+    }
   }
 }
 
@@ -169,11 +577,22 @@ class WolfSSLDecryptor extends WolfSSLEVP
    * @param cipher the cipher to be used
    * @param key aes key
    * @param iv aes initialization vector
+   * @param options optional aad, authTag ( decryption ) and authTagLength for AEAD ciphers
    */
-  constructor( cipher, key, iv )
+  constructor( cipher, key, iv, options )
   {
     super()
-    wolfcrypt.EVP_CipherInit( this.evp, cipher, key, iv, 0 )
+
+    // the ctx is already allocated, don't leak it when the cipher is rejected
+    try
+    {
+      this.init( cipher, key, iv, 0, options )
+    }
+    catch ( err )
+    {
+      this.free()
+      throw err
+    }
   }
 }
 
@@ -181,9 +600,98 @@ exports.WolfSSLDecryptor = WolfSSLDecryptor
 
 class WolfSSLEVPStream extends stream.Transform
 {
-  constructor()
+  /**
+   * @param options Transform options, with async set the cipher runs on the
+   * thread pool and maxInFlight ( default 4 ) bounds how many chunks may be
+   * queued before the stream applies backpressure
+   */
+  constructor( options = {} )
   {
-    super()
+    super( options )
+    this.async = options.async == true
+    this.maxInFlight = options.maxInFlight > 0 ? options.maxInFlight : 4
+    this.inFlight = 0
+    this.waiting = null
+    this.failed = false
+  }
+
+  /**
+   * Hands the chunk to the cipher on the thread pool, the stream keeps
+   * accepting chunks until maxInFlight are queued, results are pushed in order
+   *
+   * @param buffer the data to be encrypted
+   * @param cb the callback function that handles
+   * the next task of the stream
+   */
+  _transformAsync( buffer, cb )
+  {
+    this.inFlight++
+
+    this.cipher.update_cb( buffer, ( err, ret_buffer ) => {
+      this.inFlight--
+
+      if ( err )
+      {
+        if ( !this.failed )
+        {
+          this.failed = true
+          this.destroy( new Error( err ) )
+        }
+
+        return
+      }
+
+      if ( ret_buffer.length > 0 )
+      {
+        this.push( ret_buffer )
+      }
+
+      if ( this.waiting != null )
+      {
+        const waiting = this.waiting
+        this.waiting = null
+        waiting()
+      }
+    } )
+
+    if ( this.inFlight < this.maxInFlight )
+    {
+      cb()
+    }
+    else
+    {
+      this.waiting = cb
+    }
+  }
+
+  /**
+   * Adds additional authenticated data, see WolfSSLEVP.setAAD
+   *
+   * @param aad The aad as a string or Buffer.
+   */
+  setAAD( aad )
+  {
+    this.cipher.setAAD( aad )
+  }
+
+  /**
+   * Sets the expected tag of a decryption stream, see WolfSSLEVP.setAuthTag
+   *
+   * @param tag The expected tag as a Buffer.
+   */
+  setAuthTag( tag )
+  {
+    this.cipher.setAuthTag( tag )
+  }
+
+  /**
+   * Returns the tag of an encryption stream once it has ended
+   *
+   * @returns The tag as a Buffer.
+   */
+  getAuthTag()
+  {
+    return this.cipher.getAuthTag()
   }
 
   /**
@@ -198,6 +706,11 @@ class WolfSSLEVPStream extends stream.Transform
   {
     let buffer = Buffer.isBuffer( chunk ) ? chunk: new Buffer( chunk, enc )
 
+    if ( this.async )
+    {
+      return this._transformAsync( buffer, cb )
+    }
+
     let ret_buffer = this.cipher.update( chunk )
 
     if ( ret_buffer.length > 0 )
@@ -217,7 +730,28 @@ class WolfSSLEVPStream extends stream.Transform
    */
   _flush( cb )
   {
-    let ret_buffer = this.cipher.finalize()
+    if ( this.async && this.cipher.pending > 0 )
+    {
+      this.cipher.queue.then( () => this._flush( cb ) )
+
+      return
+    }
+
+    if ( this.failed )
+    {
+      return cb( new Error( 'Cipher failed before the stream ended' ) )
+    }
+
+    let ret_buffer
+
+    try
+    {
+      ret_buffer = this.cipher.finalize()
+    }
+    catch ( err )
+    {
+      return cb( new Error( err ) )
+    }
 
     if ( ret_buffer.length > 0 )
     {
@@ -237,11 +771,12 @@ class WolfSSLEncryptionStream extends WolfSSLEVPStream
    * @param cipher the cipher to be used
    * @param key aes key
    * @param iv aes initialization vector
+   * @param options stream options, see WolfSSLEVPStream, and the AEAD options of the cipher
    */
-  constructor( cipher, key, iv )
+  constructor( cipher, key, iv, options )
   {
-    super()
-    this.cipher = new WolfSSLEncryptor( cipher, key, iv )
+    super( options )
+    this.cipher = new WolfSSLEncryptor( cipher, key, iv, options )
   }
 }
 
@@ -256,11 +791,12 @@ class WolfSSLDecryptionStream extends WolfSSLEVPStream
    * @param cipher the cipher to be used
    * @param key aes key
    * @param iv aes initialization vector
+   * @param options stream options, see WolfSSLEVPStream, and the AEAD options of the cipher
    */
-  constructor( cipher, key, iv )
+  constructor( cipher, key, iv, options )
   {
-    super()
-    this.cipher = new WolfSSLDecryptor( cipher, key, iv )
+    super( options )
+    this.cipher = new WolfSSLDecryptor( cipher, key, iv, options )
   }
 }
 
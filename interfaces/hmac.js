@@ -29,12 +29,11 @@ class WolfSSLHmac
    * @param type the hashing algorithm to use
    * @param key hmac key
    *
-   * @remarks finalize or free must be called to free the cipher
+   * @remarks finalize or free should be called to free the hmac, an hmac
+   * that is collected without it is freed by its finalizer
    */
   constructor( type, key )
   {
-    this.hmac = Buffer.alloc( wolfcrypt.sizeof_Hmac() )
-
     this.hashType = wolfcrypt.typeof_Hmac( type )
 
     if ( this.hashType == -1 )
@@ -42,6 +41,13 @@ class WolfSSLHmac
       throw `Hashing algorithm ${ type } not recognized`
     }
 
+    this.hmac = wolfcrypt.nodejsHmacNew()
+
+    if ( typeof this.hmac == 'number' )
+    {
+      throw `Failed to nodejsHmacNew ${ this.hmac }`
+    }
+
     this.digestLength = wolfcrypt.Hmac_digest_length( this.hashType )
 
     wolfcrypt.wc_HmacSetKey( this.hmac, this.hashType, key, key.length )
@@ -104,6 +110,53 @@ class WolfSSLHmac
     return outBuffer
   }
 
+  /**
+   * Creates an independent copy of this hmac, including the data added so far
+   *
+   * @returns A new WolfSSLHmac with the same state.
+   *
+   * @throws {Error} If the hmac is not allocated or wc_HmacCopy fails.
+   *
+   * @remarks The copy has to be finalized or freed on its own.
+   */
+  copy()
+  {
+    if ( this.hmac == null )
+    {
+      throw 'Hmac is not allocated'
+    }
+
+    let copy = Object.create( WolfSSLHmac.prototype )
+
+    Object.assign( copy, this )
+    copy.hmac = wolfcrypt.nodejsHmacNew()
+
+    if ( typeof copy.hmac == 'number' )
+    {
+      throw `Failed to nodejsHmacNew ${ copy.hmac }`
+    }
+
+    let ret = wolfcrypt.wc_HmacCopy( this.hmac, copy.hmac )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_HmacCopy ${ ret }`
+    }
+
+    return copy
+  }
+
+  /**
+   * Computes the digest of the data added so far without ending the hmac,
+   * update can still be called afterwards
+   *
+   * @returns The digest as a Buffer.
+   */
+  digest()
+  {
+    return this.copy().finalize()
+  }
+
   /**
    * Frees the hmac by calling wc_HmacFree
    *
@@ -123,6 +176,7 @@ class WolfSSLHmac
     }
 
     wolfcrypt.wc_HmacFree( this.hmac );
+    wolfcrypt.nodejsHandleRelease( this.hmac )
 
     this.hmac = null
   }
@@ -130,6 +184,169 @@ class WolfSSLHmac
 
 exports.WolfSSLHmac = WolfSSLHmac
 
+class WolfSSLHmacKey
+{
+  /**
+   * Creates a reusable hmac key, the inner and outer hash states after the
+   * ipad and opad blocks are computed once here instead of for every message
+   *
+   * @param type the hashing algorithm to use
+   * @param key hmac key
+   *
+   * @remarks free should be called to free the key, a key that is collected
+   * without it is freed by its finalizer
+   */
+  constructor( type, key )
+  {
+    this.hmacKey = wolfcrypt.nodejsHmacKeyNew()
+
+    if ( typeof this.hmacKey == 'number' )
+    {
+      throw `Failed to nodejsHmacKeyNew ${ this.hmacKey }`
+    }
+
+    this.hashType = wolfcrypt.typeof_Hmac( type )
+
+    if ( this.hashType == -1 )
+    {
+      throw `Hashing algorithm ${ type } not recognized`
+    }
+
+    this.digestLength = wolfcrypt.Hmac_digest_length( this.hashType )
+
+    if ( typeof key == 'string' )
+    {
+      key = Buffer.from( key )
+    }
+
+    let ret = wolfcrypt.nodejsHmacKeyInit( this.hmacKey, this.hashType, key, key.length )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to nodejsHmacKeyInit ${ ret }`
+    }
+  }
+
+  /**
+   * Computes the hmac of data in one call, the message being built with
+   * update is not affected
+   *
+   * @param data The data to authenticate.
+   *
+   * @returns The hmac as a Buffer.
+   */
+  mac( data )
+  {
+    if ( this.hmacKey == null )
+    {
+      throw 'Hmac key is not allocated'
+    }
+
+    if ( typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
+
+    let outBuffer = Buffer.alloc( this.digestLength )
+
+    let ret = wolfcrypt.nodejsHmacKeyMac( this.hmacKey, data, data.length, outBuffer )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to nodejsHmacKeyMac ${ ret }`
+    }
+
+    return outBuffer
+  }
+
+  /**
+   * Adds data to the message in progress
+   *
+   * @param data The data that will be added to the hmac.
+   */
+  update( data )
+  {
+    if ( this.hmacKey == null )
+    {
+      throw 'Hmac key is not allocated'
+    }
+
+    if ( typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
+
+    let ret = wolfcrypt.nodejsHmacKeyUpdate( this.hmacKey, data, data.length )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to nodejsHmacKeyUpdate ${ ret }`
+    }
+  }
+
+  /**
+   * Computes the hmac of the message in progress and starts a new one
+   *
+   * @returns The hmac as a Buffer.
+   *
+   * @remarks Unlike WolfSSLHmac the key stays usable after finalize.
+   */
+  finalize()
+  {
+    if ( this.hmacKey == null )
+    {
+      throw 'Hmac key is not allocated'
+    }
+
+    let outBuffer = Buffer.alloc( this.digestLength )
+
+    let ret = wolfcrypt.nodejsHmacKeyFinal( this.hmacKey, outBuffer )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to nodejsHmacKeyFinal ${ ret }`
+    }
+
+    return outBuffer
+  }
+
+  /**
+   * Drops the message in progress without touching the key schedule
+   */
+  reset()
+  {
+    if ( this.hmacKey == null )
+    {
+      throw 'Hmac key is not allocated'
+    }
+
+    let ret = wolfcrypt.nodejsHmacKeyReset( this.hmacKey )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to nodejsHmacKeyReset ${ ret }`
+    }
+  }
+
+  /**
+   * Frees the key and zeroes the precomputed states
+   */
+  free()
+  {
+    if ( this.hmacKey == null )
+    {
+      throw 'Hmac key is not allocated'
+    }
+
+    wolfcrypt.nodejsHmacKeyFree( this.hmacKey )
+    wolfcrypt.nodejsHandleRelease( this.hmacKey )
+
+    this.hmacKey = null
+  }
+}
+
+exports.WolfSSLHmacKey = WolfSSLHmacKey
+
 class WolfSSLHmacStream extends stream.Transform
 {
   /**
@@ -0,0 +1,444 @@
+/* kdf.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { packBatch } = require( './util/batch' )
+
+function kdfBuffer( data, name )
+{
+  if ( data == null )
+  {
+    return Buffer.alloc( 0 )
+  }
+
+  if ( typeof data == 'string' )
+  {
+    return Buffer.from( data )
+  }
+
+  if ( !Buffer.isBuffer( data ) )
+  {
+    throw `${ name } must be a string or Buffer`
+  }
+
+  return data
+}
+
+function kdfHashType( hash_type )
+{
+  let type = wolfcrypt.typeof_Hmac( hash_type )
+
+  if ( type < 0 )
+  {
+    throw 'Invalid hash_type'
+  }
+
+  return type
+}
+
+// turns the ( err, ret, out ) of the native async and batch calls into ( err, out )
+function kdfCallback( name, cb )
+{
+  return ( err, ret, out ) => {
+    if ( err )
+    {
+      return cb( err )
+    }
+
+    if ( ret != 0 )
+    {
+      return cb( `Failed to ${ name } ${ ret }` )
+    }
+
+    cb( null, out )
+  }
+}
+
+/**
+ * Derives a key with HKDF, extract and expand in one call
+ *
+ * @param hash_type The hashing algorithm to use.
+ *
+ * @param key The input keying material, such as an ECDH shared secret.
+ *
+ * @param salt Optional salt, null for none.
+ *
+ * @param info Optional context and application specific information.
+ *
+ * @param length The length of the key to derive.
+ *
+ * @returns The derived key as a Buffer.
+ *
+ * @throws {Error} If hash_type is not a known hashing algorithm.
+ *
+ * @throws {Error} If wc_HKDF fails.
+ */
+const WolfSSL_HKDF = function( hash_type, key, salt, info, length )
+{
+  let type = kdfHashType( hash_type )
+  key = kdfBuffer( key, 'key' )
+  salt = kdfBuffer( salt, 'salt' )
+  info = kdfBuffer( info, 'info' )
+
+  let out = Buffer.alloc( length )
+
+  let ret = wolfcrypt.wc_HKDF( type, key, key.length, salt, salt.length, info, info.length, out, out.length )
+
+  if ( ret != 0 )
+  {
+    throw `Failed to wc_HKDF ${ ret }`
+  }
+
+  return out
+}
+
+/**
+ * Runs the extract step of HKDF
+ *
+ * @param hash_type The hashing algorithm to use.
+ *
+ * @param salt Optional salt, null for none.
+ *
+ * @param key The input keying material.
+ *
+ * @returns The pseudorandom key, as long as a digest of hash_type.
+ *
+ * @throws {Error} If wc_HKDF_Extract fails.
+ */
+const WolfSSL_HKDF_Extract = function( hash_type, salt, key )
+{
+  let type = kdfHashType( hash_type )
+  salt = kdfBuffer( salt, 'salt' )
+  key = kdfBuffer( key, 'key' )
+
+  let out = Buffer.alloc( wolfcrypt.Hmac_digest_length( type ) )
+
+  let ret = wolfcrypt.wc_HKDF_Extract( type, salt, salt.length, key, key.length, out )
+
+  if ( ret != 0 )
+  {
+    throw `Failed to wc_HKDF_Extract ${ ret }`
+  }
+
+  return out
+}
+
+/**
+ * Runs the expand step of HKDF
+ *
+ * @param hash_type The hashing algorithm to use.
+ *
+ * @param prk The pseudorandom key from WolfSSL_HKDF_Extract.
+ *
+ * @param info Optional context and application specific information.
+ *
+ * @param length The length of the key to derive.
+ *
+ * @returns The derived key as a Buffer.
+ *
+ * @throws {Error} If wc_HKDF_Expand fails.
+ */
+const WolfSSL_HKDF_Expand = function( hash_type, prk, info, length )
+{
+  let type = kdfHashType( hash_type )
+  prk = kdfBuffer( prk, 'prk' )
+  info = kdfBuffer( info, 'info' )
+
+  let out = Buffer.alloc( length )
+
+  let ret = wolfcrypt.wc_HKDF_Expand( type, prk, prk.length, info, info.length, out, out.length )
+
+  if ( ret != 0 )
+  {
+    throw `Failed to wc_HKDF_Expand ${ ret }`
+  }
+
+  return out
+}
+
+/**
+ * Derives a key with the ANSI X9.63 KDF
+ *
+ * @param hash_type The hashing algorithm to use.
+ *
+ * @param secret The shared secret.
+ *
+ * @param info Optional shared info, null for none.
+ *
+ * @param length The length of the key to derive.
+ *
+ * @returns The derived key as a Buffer.
+ *
+ * @throws {Error} If wc_X963_KDF fails.
+ */
+const WolfSSL_X963_KDF = function( hash_type, secret, info, length )
+{
+  let type = kdfHashType( hash_type )
+  secret = kdfBuffer( secret, 'secret' )
+  info = kdfBuffer( info, 'info' )
+
+  let out = Buffer.alloc( length )
+
+  let ret = wolfcrypt.wc_X963_KDF( type, secret, secret.length, info, info.length, out, out.length )
+
+  if ( ret != 0 )
+  {
+    throw `Failed to wc_X963_KDF ${ ret }`
+  }
+
+  return out
+}
+
+/**
+ * WolfSSL_HKDF on the wolfcrypt thread pool, uses callback
+ *
+ * @param cb The callback function that will be called with an error or the key.
+ */
+const WolfSSL_HKDF_cb = function( hash_type, key, salt, info, length, cb )
+{
+  let type = kdfHashType( hash_type )
+  key = kdfBuffer( key, 'key' )
+  salt = kdfBuffer( salt, 'salt' )
+  info = kdfBuffer( info, 'info' )
+
+  wolfcrypt.wc_HKDF_async( type, key, key.length, salt, salt.length, info, info.length, length, kdfCallback( 'wc_HKDF', cb ) )
+}
+
+/**
+ * WolfSSL_HKDF_Extract on the wolfcrypt thread pool, uses callback
+ *
+ * @param cb The callback function that will be called with an error or the pseudorandom key.
+ */
+const WolfSSL_HKDF_Extract_cb = function( hash_type, salt, key, cb )
+{
+  let type = kdfHashType( hash_type )
+  salt = kdfBuffer( salt, 'salt' )
+  key = kdfBuffer( key, 'key' )
+
+  wolfcrypt.wc_HKDF_Extract_async( type, salt, salt.length, key, key.length, kdfCallback( 'wc_HKDF_Extract', cb ) )
+}
+
+/**
+ * WolfSSL_HKDF_Expand on the wolfcrypt thread pool, uses callback
+ *
+ * @param cb The callback function that will be called with an error or the key.
+ */
+const WolfSSL_HKDF_Expand_cb = function( hash_type, prk, info, length, cb )
+{
+  let type = kdfHashType( hash_type )
+  prk = kdfBuffer( prk, 'prk' )
+  info = kdfBuffer( info, 'info' )
+
+  wolfcrypt.wc_HKDF_Expand_async( type, prk, prk.length, info, info.length, length, kdfCallback( 'wc_HKDF_Expand', cb ) )
+}
+
+/**
+ * WolfSSL_X963_KDF on the wolfcrypt thread pool, uses callback
+ *
+ * @param cb The callback function that will be called with an error or the key.
+ */
+const WolfSSL_X963_KDF_cb = function( hash_type, secret, info, length, cb )
+{
+  let type = kdfHashType( hash_type )
+  secret = kdfBuffer( secret, 'secret' )
+  info = kdfBuffer( info, 'info' )
+
+  wolfcrypt.wc_X963_KDF_async( type, secret, secret.length, info, info.length, length, kdfCallback( 'wc_X963_KDF', cb ) )
+}
+
+/**
+ * WolfSSL_HKDF on the wolfcrypt thread pool, uses promise
+ *
+ * @returns A promise that resolves with the key as a Buffer.
+ */
+const WolfSSL_HKDF_promise = function( hash_type, key, salt, info, length )
+{
+  return new Promise( ( res, rej ) => {
+    WolfSSL_HKDF_cb( hash_type, key, salt, info, length, ( err, out ) => err ? rej( err ) : res( out ) )
+  } )
+}
+
+/**
+ * WolfSSL_HKDF_Extract on the wolfcrypt thread pool, uses promise
+ *
+ * @returns A promise that resolves with the pseudorandom key as a Buffer.
+ */
+const WolfSSL_HKDF_Extract_promise = function( hash_type, salt, key )
+{
+  return new Promise( ( res, rej ) => {
+    WolfSSL_HKDF_Extract_cb( hash_type, salt, key, ( err, out ) => err ? rej( err ) : res( out ) )
+  } )
+}
+
+/**
+ * WolfSSL_HKDF_Expand on the wolfcrypt thread pool, uses promise
+ *
+ * @returns A promise that resolves with the key as a Buffer.
+ */
+const WolfSSL_HKDF_Expand_promise = function( hash_type, prk, info, length )
+{
+  return new Promise( ( res, rej ) => {
+    WolfSSL_HKDF_Expand_cb( hash_type, prk, info, length, ( err, out ) => err ? rej( err ) : res( out ) )
+  } )
+}
+
+/**
+ * WolfSSL_X963_KDF on the wolfcrypt thread pool, uses promise
+ *
+ * @returns A promise that resolves with the key as a Buffer.
+ */
+const WolfSSL_X963_KDF_promise = function( hash_type, secret, info, length )
+{
+  return new Promise( ( res, rej ) => {
+    WolfSSL_X963_KDF_cb( hash_type, secret, info, length, ( err, out ) => err ? rej( err ) : res( out ) )
+  } )
+}
+
+// packs an optional batch input, a single value or null is used for every item
+function kdfPackBatch( items, count, name )
+{
+  if ( items == null )
+  {
+    return { data: null, offsets: null }
+  }
+
+  if ( !Array.isArray( items ) )
+  {
+    items = new Array( count ).fill( items )
+  }
+
+  if ( items.length != count )
+  {
+    throw `${ name } must have one entry per key`
+  }
+
+  return packBatch( items, name )
+}
+
+/**
+ * Derives many HKDF keys in one call on the wolfcrypt thread pool, uses callback
+ *
+ * @param hash_type The hashing algorithm to use.
+ *
+ * @param keys An array of input keying materials.
+ *
+ * @param salts An array with one salt per key, a single salt for all of them, or null.
+ *
+ * @param infos An array with one info per key, a single info for all of them, or null.
+ *
+ * @param length The length of each derived key.
+ *
+ * @param onProgress Optional function called with ( done, count ) about every percent.
+ *
+ * @param cb The callback function that will be called with an error or the keys.
+ *
+ * @remarks The keys are packed into one Buffer, key i is at i * length.
+ */
+const WolfSSL_HKDF_batch_cb = function( hash_type, keys, salts, infos, length, onProgress, cb )
+{
+  let type = kdfHashType( hash_type )
+
+  if ( !Array.isArray( keys ) )
+  {
+    throw 'keys must be an array'
+  }
+
+  let packedKeys = packBatch( keys, 'keys' )
+  let packedSalts = kdfPackBatch( salts, keys.length, 'salts' )
+  let packedInfos = kdfPackBatch( infos, keys.length, 'infos' )
+
+  wolfcrypt.wc_HKDF_batch( type, packedKeys.data, packedKeys.offsets, packedSalts.data, packedSalts.offsets,
+    packedInfos.data, packedInfos.offsets, length, onProgress || null, kdfCallback( 'wc_HKDF', cb ) )
+}
+
+/**
+ * Derives many X9.63 keys in one call on the wolfcrypt thread pool, uses callback
+ *
+ * @param hash_type The hashing algorithm to use.
+ *
+ * @param secrets An array of shared secrets.
+ *
+ * @param infos An array with one shared info per secret, a single info for all of them, or null.
+ *
+ * @param length The length of each derived key.
+ *
+ * @param onProgress Optional function called with ( done, count ) about every percent.
+ *
+ * @param cb The callback function that will be called with an error or the keys.
+ *
+ * @remarks The keys are packed into one Buffer, key i is at i * length.
+ */
+const WolfSSL_X963_KDF_batch_cb = function( hash_type, secrets, infos, length, onProgress, cb )
+{
+  let type = kdfHashType( hash_type )
+
+  if ( !Array.isArray( secrets ) )
+  {
+    throw 'secrets must be an array'
+  }
+
+  let packedSecrets = packBatch( secrets, 'secrets' )
+  let packedInfos = kdfPackBatch( infos, secrets.length, 'infos' )
+
+  wolfcrypt.wc_X963_KDF_batch( type, packedSecrets.data, packedSecrets.offsets, packedInfos.data, packedInfos.offsets,
+    length, onProgress || null, kdfCallback( 'wc_X963_KDF', cb ) )
+}
+
+/**
+ * Derives many HKDF keys in one call on the wolfcrypt thread pool, uses promise
+ *
+ * @returns A promise that resolves with the keys packed into one Buffer.
+ */
+const WolfSSL_HKDF_batch_promise = function( hash_type, keys, salts, infos, length, onProgress )
+{
+  return new Promise( ( res, rej ) => {
+    WolfSSL_HKDF_batch_cb( hash_type, keys, salts, infos, length, onProgress, ( err, out ) => err ? rej( err ) : res( out ) )
+  } )
+}
+
+/**
+ * Derives many X9.63 keys in one call on the wolfcrypt thread pool, uses promise
+ *
+ * @returns A promise that resolves with the keys packed into one Buffer.
+ */
+const WolfSSL_X963_KDF_batch_promise = function( hash_type, secrets, infos, length, onProgress )
+{
+  return new Promise( ( res, rej ) => {
+    WolfSSL_X963_KDF_batch_cb( hash_type, secrets, infos, length, onProgress, ( err, out ) => err ? rej( err ) : res( out ) )
+  } )
+}
+
+exports.WolfSSL_HKDF = WolfSSL_HKDF
+exports.WolfSSL_HKDF_Extract = WolfSSL_HKDF_Extract
+exports.WolfSSL_HKDF_Expand = WolfSSL_HKDF_Expand
+exports.WolfSSL_X963_KDF = WolfSSL_X963_KDF
+exports.WolfSSL_HKDF_cb = WolfSSL_HKDF_cb
+exports.WolfSSL_HKDF_Extract_cb = WolfSSL_HKDF_Extract_cb
+exports.WolfSSL_HKDF_Expand_cb = WolfSSL_HKDF_Expand_cb
+exports.WolfSSL_X963_KDF_cb = WolfSSL_X963_KDF_cb
+exports.WolfSSL_HKDF_promise = WolfSSL_HKDF_promise
+exports.WolfSSL_HKDF_Extract_promise = WolfSSL_HKDF_Extract_promise
+exports.WolfSSL_HKDF_Expand_promise = WolfSSL_HKDF_Expand_promise
+exports.WolfSSL_X963_KDF_promise = WolfSSL_X963_KDF_promise
+exports.WolfSSL_HKDF_batch_cb = WolfSSL_HKDF_batch_cb
+exports.WolfSSL_X963_KDF_batch_cb = WolfSSL_X963_KDF_batch_cb
+exports.WolfSSL_HKDF_batch_promise = WolfSSL_HKDF_batch_promise
+exports.WolfSSL_X963_KDF_batch_promise = WolfSSL_X963_KDF_batch_promise
@@ -0,0 +1,60 @@
+/* key_cache.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+
+/**
+ * Returns the counters of the native key caches used by
+ * WolfSSLRsa.PrivateKeyDecodeCached and the other cached decodes
+ *
+ * @returns An object { rsa, ecc }, each { size, limit, hits, misses, evictions,
+ * copies }, copies counts the extra copies of cached keys decoded for
+ * operations that found every other copy of their key in use.
+ */
+const WolfSSL_KeyCacheStats = function()
+{
+  return wolfcrypt.nodejsKeyCacheStats()
+}
+
+/**
+ * Sets how many keys of each type stay cached, the least recently used ones
+ * are evicted first, 128 by default
+ *
+ * @param limit The number of keys, 0 turns caching off.
+ *
+ * @returns The previous limit.
+ */
+const WolfSSL_KeyCacheLimit = function( limit )
+{
+  return wolfcrypt.nodejsKeyCacheLimit( limit )
+}
+
+/**
+ * Drops every cached key, keys still held by a WolfSSLRsa or WolfSSLEcc stay
+ * valid until those are freed
+ */
+const WolfSSL_KeyCacheClear = function()
+{
+  wolfcrypt.nodejsKeyCacheClear()
+}
+
+exports.WolfSSL_KeyCacheStats = WolfSSL_KeyCacheStats
+exports.WolfSSL_KeyCacheLimit = WolfSSL_KeyCacheLimit
+exports.WolfSSL_KeyCacheClear = WolfSSL_KeyCacheClear
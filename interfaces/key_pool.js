@@ -0,0 +1,77 @@
+/* key_pool.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+
+/**
+ * Keeps keys of one type, size and exponent generated ahead of time for
+ * WolfSSLRsa.MakeRsaKey_pooled and WolfSSLEcc.make_key_pooled, refills run on
+ * the wolfcrypt thread pool in the background
+ *
+ * @param options { type, size, e, depth, rate, threads }, type is 'rsa' or
+ * 'ecc', size is in bits for rsa and in bytes for ecc, e defaults to 65537
+ * and is ignored for ecc, depth is the number of keys to keep ready and 0
+ * removes the pool, rate limits refills per second and defaults to 0 for no
+ * limit, threads is how many refills may run at once and defaults to 1,
+ * all pools together use at most one less thread than WolfSSL_ThreadPoolSize.
+ *
+ * @throws {Error} If nodejsKeyPoolConfigure fails.
+ */
+const WolfSSL_KeyPoolConfigure = function( options )
+{
+  const { type, size, e = 65537, depth, rate = 0, threads = 1 } = options
+
+  if ( type != 'rsa' && type != 'ecc' )
+  {
+    throw `Unknown key pool type ${ type }`
+  }
+
+  let ret = wolfcrypt.nodejsKeyPoolConfigure( type, size, e, depth, rate, threads )
+
+  if ( ret != 0 )
+  {
+    throw `Failed to nodejsKeyPoolConfigure ${ ret }`
+  }
+}
+
+/**
+ * Returns the depth and refill counters of every key pool
+ *
+ * @returns An array of { type, size, e, depth, ready, refilling, rate,
+ * threads, hits, misses, refills, failures, error, refillMs, refillMaxMs },
+ * error is the code of the last failed refill, which stops refills until the
+ * pool is configured again, refillMs is the average time of a refill.
+ */
+const WolfSSL_KeyPoolStats = function()
+{
+  return wolfcrypt.nodejsKeyPoolStats()
+}
+
+/**
+ * Removes every key pool and frees the keys that were not handed out
+ */
+const WolfSSL_KeyPoolClear = function()
+{
+  wolfcrypt.nodejsKeyPoolClear()
+}
+
+exports.WolfSSL_KeyPoolConfigure = WolfSSL_KeyPoolConfigure
+exports.WolfSSL_KeyPoolStats = WolfSSL_KeyPoolStats
+exports.WolfSSL_KeyPoolClear = WolfSSL_KeyPoolClear
@@ -20,6 +20,8 @@
  */
 
 const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { packBatch } = require( './util/batch' )
+const { runAuto } = require( './util/auto' )
 
 /**
  * Generates a new key using the key derivation function
@@ -74,3 +76,192 @@ const WolfSSL_PBKDF2 = function( password, salt, iterations, keyLen, hash_type )
 }
 
 exports.WolfSSL_PBKDF2 = WolfSSL_PBKDF2
+
+/**
+ * Generates a new key using the key derivation function on the wolfcrypt
+ * thread pool, uses callback
+ *
+ * @param password The password to use.
+ *
+ * @param salt The salt to use.
+ *
+ * @param iterations The number of iterations to use for derivation.
+ *
+ * @param keyLen The length of the key to be derived.
+ *
+ * @param hash_type The hashing algorithm to be used for derivation.
+ *
+ * @param cb The callback function that will be called with an error or the key.
+ *
+ * @throws {Error} If password or salt are not buffers.
+ *
+ * @throws {Error} If hash_type is not a known hashing algorithm.
+ *
+ * @remarks The pool is separate from the libuv thread pool so slow
+ * derivations don't hold up file or network requests, its size is set with
+ * WolfSSL_ThreadPoolSize.
+ */
+const WolfSSL_PBKDF2_cb = function( password, salt, iterations, keyLen, hash_type, cb )
+{
+  if ( !Buffer.isBuffer( password ) )
+  {
+    throw 'password must be Buffer'
+  }
+
+  if ( !Buffer.isBuffer( salt ) )
+  {
+    throw 'salt must be Buffer'
+  }
+
+  let type = wolfcrypt.typeof_Hmac( hash_type )
+
+  if ( type < 0 )
+  {
+    throw 'Invalid hash_type'
+  }
+
+  wolfcrypt.wc_PBKDF2_async( password, password.length, salt, salt.length, iterations, keyLen, type, ( err, ret, key ) => {
+    if ( err )
+    {
+      return cb( err )
+    }
+
+    if ( ret != 0 )
+    {
+      return cb( `Failed to wc_PBKDF2 ${ ret }` )
+    }
+
+    cb( null, key )
+  } )
+}
+
+/**
+ * Generates a new key using the key derivation function on the wolfcrypt
+ * thread pool, uses promise
+ *
+ * @returns A promise that resolves with the key as a Buffer.
+ */
+const WolfSSL_PBKDF2_promise = function( password, salt, iterations, keyLen, hash_type )
+{
+  return new Promise( ( res, rej ) => {
+    WolfSSL_PBKDF2_cb( password, salt, iterations, keyLen, hash_type, ( err, key ) => err ? rej( err ) : res( key ) )
+  } )
+}
+
+/**
+ * Derives a key like WolfSSL_PBKDF2, or like WolfSSL_PBKDF2_promise once the
+ * watchdog has seen wc_PBKDF2 block the event loop and rerouting is on
+ *
+ * @returns A promise that resolves with the key as a Buffer.
+ */
+const WolfSSL_PBKDF2_auto = function( password, salt, iterations, keyLen, hash_type )
+{
+  return runAuto( 'wc_PBKDF2', () => WolfSSL_PBKDF2( password, salt, iterations, keyLen, hash_type ),
+    () => WolfSSL_PBKDF2_promise( password, salt, iterations, keyLen, hash_type ) )
+}
+
+/**
+ * Derives many keys at once on the wolfcrypt thread pool, every pool thread
+ * works on the batch so throughput grows with the number of cores, uses callback
+ *
+ * @param passwords An array of strings or Buffers.
+ *
+ * @param salts An array of strings or Buffers, one per password.
+ *
+ * @param iterations The iteration count for every key, or an array with one count per key.
+ *
+ * @param keyLen The length of each derived key.
+ *
+ * @param hash_type The hashing algorithm to be used for derivation.
+ *
+ * @param onProgress Optional function called with ( done, count ) about every percent.
+ *
+ * @param cb The callback function that will be called with an error or the keys.
+ *
+ * @throws {Error} If the arrays don't have the same length.
+ *
+ * @throws {Error} If hash_type is not a known hashing algorithm.
+ *
+ * @remarks The keys are packed into one Buffer, key i is at i * keyLen.
+ */
+const WolfSSL_PBKDF2_batch_cb = function( passwords, salts, iterations, keyLen, hash_type, onProgress, cb )
+{
+  if ( !Array.isArray( passwords ) || !Array.isArray( salts ) || passwords.length != salts.length )
+  {
+    throw 'passwords and salts must be arrays of the same length'
+  }
+
+  if ( !Array.isArray( iterations ) )
+  {
+    iterations = new Array( passwords.length ).fill( iterations )
+  }
+
+  if ( iterations.length != passwords.length )
+  {
+    throw 'iterations must be a number or an array with one count per password'
+  }
+
+  let type = wolfcrypt.typeof_Hmac( hash_type )
+
+  if ( type < 0 )
+  {
+    throw 'Invalid hash_type'
+  }
+
+  let packedPasswords = packBatch( passwords, 'passwords' )
+  let packedSalts = packBatch( salts, 'salts' )
+
+  wolfcrypt.wc_PBKDF2_batch( packedPasswords.data, packedPasswords.offsets, packedSalts.data, packedSalts.offsets,
+    Uint32Array.from( iterations ), keyLen, type, onProgress || null, ( err, ret, keys ) => {
+      // the packed copy of the passwords is not needed anymore
+      packedPasswords.data.fill( 0 )
+
+      if ( err )
+      {
+        return cb( err )
+      }
+
+      if ( ret != 0 )
+      {
+        return cb( `Failed to wc_PBKDF2 ${ ret }` )
+      }
+
+      cb( null, keys )
+    } )
+}
+
+/**
+ * Derives many keys at once on the wolfcrypt thread pool, uses promise
+ *
+ * @returns A promise that resolves with the keys packed into one Buffer.
+ */
+const WolfSSL_PBKDF2_batch_promise = function( passwords, salts, iterations, keyLen, hash_type, onProgress )
+{
+  return new Promise( ( res, rej ) => {
+    WolfSSL_PBKDF2_batch_cb( passwords, salts, iterations, keyLen, hash_type, onProgress, ( err, keys ) => err ? rej( err ) : res( keys ) )
+  } )
+}
+
+/**
+ * Gets or sets the number of threads used for async key derivation
+ *
+ * @param size The new number of threads, defaults to the number of cores.
+ *
+ * @returns The number of threads.
+ */
+const WolfSSL_ThreadPoolSize = function( size )
+{
+  if ( size === undefined )
+  {
+    return wolfcrypt.nodejsThreadPoolSize()
+  }
+
+  return wolfcrypt.nodejsThreadPoolSize( size )
+}
+
+exports.WolfSSL_PBKDF2_cb = WolfSSL_PBKDF2_cb
+exports.WolfSSL_PBKDF2_promise = WolfSSL_PBKDF2_promise
+exports.WolfSSL_PBKDF2_auto = WolfSSL_PBKDF2_auto
+exports.WolfSSL_PBKDF2_batch_cb = WolfSSL_PBKDF2_batch_cb
+exports.WolfSSL_PBKDF2_batch_promise = WolfSSL_PBKDF2_batch_promise
+exports.WolfSSL_ThreadPoolSize = WolfSSL_ThreadPoolSize
@@ -23,13 +23,19 @@ const wolfcrypt = require( '../build/Release/wolfcrypt' )
 class WolfSSL_PKCS7
 {
   /**
-   * Creates a new PKCS7 structure by calling sizeof_PKCS7 and wc_PKCS7_Init
+   * Creates a new PKCS7 structure in native memory and calls wc_PKCS7_Init
    *
-   * @remarks free must be called to free the ecc PKCS7 data
+   * @remarks free should be called to free the PKCS7 data, a structure that
+   * is collected without it is freed by its finalizer
    */
   constructor()
   {
-    this.pkcs7 = Buffer.alloc( wolfcrypt.sizeof_PKCS7() )
+    this.pkcs7 = wolfcrypt.nodejsPKCS7New()
+
+    if ( typeof this.pkcs7 == 'number' )
+    {
+      throw `Failed to nodejsPKCS7New ${ this.pkcs7 }`
+    }
 
     let ret = wolfcrypt.wc_PKCS7_Init( this.pkcs7 )
 
@@ -312,6 +318,7 @@ class WolfSSL_PKCS7
     }
 
     wolfcrypt.wc_PKCS7_Free( this.pkcs7 )
+    wolfcrypt.nodejsHandleRelease( this.pkcs7 )
 
     this.pkcs7 = null
   }
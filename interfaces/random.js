@@ -51,6 +51,17 @@ class WolfSSLRandom
        return block
     }
 
+    /**
+     * Returns how often the per thread DRBGs used by key operations were
+     * seeded and how often an existing one was reused
+     *
+     * @returns An object with created and reused counters.
+     */
+    static Stats()
+    {
+        return wolfcrypt.nodejsRngStats()
+    }
+
     /**
      * Frees the data allocated by the WC_RNG struct
      *
@@ -19,20 +19,169 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 const wolfcrypt = require( '../build/Release/wolfcrypt' );
+const { runAuto } = require( './util/auto' )
+
+function cachedKey( derBuf, isPrivate )
+{
+  if ( !Buffer.isBuffer( derBuf ) )
+  {
+    throw `${ isPrivate ? 'Private' : 'Public' } key der must be Buffer`
+  }
+
+  let handle = wolfcrypt.nodejsRsaKeyCached( derBuf, derBuf.length, isPrivate )
+
+  if ( typeof handle == 'number' )
+  {
+    throw `Failed to ${ isPrivate ? 'wc_RsaPrivateKeyDecode' : 'wc_RsaPublicKeyDecode' } ${ handle }`
+  }
+
+  let rsa = Object.create( WolfSSLRsa.prototype )
+  rsa.rsa = handle
+  rsa.pending = 0
+  rsa.cached = true
+
+  return rsa
+}
+
+// hash and mgf for the PSS and OAEP methods, the mgf uses the same hash
+function paddingHash( hash )
+{
+  hash = hash || 'SHA256'
+
+  const type = wolfcrypt.typeof_Hash( hash )
+  const mgf = wolfcrypt.typeof_RsaMgf( hash )
+
+  if ( type < 0 || mgf < 0 )
+  {
+    throw `Unsupported hash ${ hash }`
+  }
+
+  return { type, mgf }
+}
+
+function oaepLabel( label )
+{
+  if ( label == null )
+  {
+    return null
+  }
+
+  if ( typeof label == 'string' )
+  {
+    label = Buffer.from( label )
+  }
+
+  if ( !Buffer.isBuffer( label ) )
+  {
+    throw 'label must be a string or Buffer'
+  }
+
+  // wolfcrypt treats an empty label like no label
+  return label.length > 0 ? label : null
+}
+
+function requirePss()
+{
+  if ( typeof wolfcrypt.wc_RsaPSS_Sign != 'function' )
+  {
+    throw 'RSA-PSS not compiled in'
+  }
+}
+
+function requireOaep()
+{
+  if ( typeof wolfcrypt.wc_RsaPublicEncrypt_ex != 'function' )
+  {
+    throw 'RSA-OAEP not compiled in'
+  }
+}
 
 class WolfSSLRsa
 {
   /**
-   * Creates a new RsaKey by calling sizeof_RsaKey and wc_InitRsaKey
+   * Creates a new RsaKey in native memory and calls wc_InitRsaKey
    *
-   * @remarks free must be called to free the rsa key data
+   * @remarks free should be called to free the rsa key data, a key that is
+   * collected without it is freed by its finalizer
    */
   constructor()
   {
-    this.rsa = Buffer.alloc( wolfcrypt.sizeof_RsaKey() )
+    this.rsa = wolfcrypt.nodejsRsaKeyNew()
+
+    if ( typeof this.rsa == 'number' )
+    {
+      throw `Failed to nodejsRsaKeyNew ${ this.rsa }`
+    }
+
+    this.pending = 0
+    this.cached = false
     wolfcrypt.wc_InitRsaKey( this.rsa )
   }
 
+  /**
+   * Returns the private key of a Der Buffer from the native key cache, the
+   * Der is only decoded the first time it is seen
+   *
+   * @param derBuf The private key Der.
+   *
+   * @returns A WolfSSLRsa sharing the cached key, it can't be changed and free only drops this handle.
+   *
+   * @throws {Error} If derBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_RsaPrivateKeyDecode fails.
+   */
+  static PrivateKeyDecodeCached( derBuf )
+  {
+    return cachedKey( derBuf, true )
+  }
+
+  /**
+   * Returns the public key of a Der Buffer from the native key cache, the Der
+   * is only decoded the first time it is seen
+   *
+   * @param derBuf The public key Der.
+   *
+   * @returns A WolfSSLRsa sharing the cached key, it can't be changed and free only drops this handle.
+   *
+   * @throws {Error} If derBuf is not a Buffer.
+   *
+   * @throws {Error} If wc_RsaPublicKeyDecode fails.
+   */
+  static PublicKeyDecodeCached( derBuf )
+  {
+    return cachedKey( derBuf, false )
+  }
+
+  /**
+   * Returns a new key from the native key pool configured with
+   * WolfSSL_KeyPoolConfigure, or makes one on the thread pool when the pool
+   * is empty or there is none for this size and exponent
+   *
+   * @param size The size of the rsa key.
+   *
+   * @param e The exponent parameter to use for key generation, 65537 by default.
+   *
+   * @returns A promise that resolves with a WolfSSLRsa owning the new key.
+   */
+  static MakeRsaKey_pooled( size, e = 65537 )
+  {
+    let handle = wolfcrypt.nodejsRsaKeyPooled( size, e )
+
+    if ( handle == null )
+    {
+      let rsa = new WolfSSLRsa()
+
+      return rsa.MakeRsaKey_promise( size, e ).then( () => rsa )
+    }
+
+    let rsa = Object.create( WolfSSLRsa.prototype )
+    rsa.rsa = handle
+    rsa.pending = 0
+    rsa.cached = false
+
+    return Promise.resolve( rsa )
+  }
+
   /**
    * Makes a new rsa key and fills the rsa struct with the key data
    *
@@ -51,6 +200,11 @@ class WolfSSLRsa
       throw 'Invalid rsa key'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     let ret = wolfcrypt.wc_MakeRsaKey( this.rsa, size, e )
 
     if ( ret != 0 )
@@ -77,6 +231,11 @@ class WolfSSLRsa
       throw 'Invalid rsa key'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     wolfcrypt.wc_MakeRsaKey_async( this.rsa, size, e, cb )
   }
 
@@ -98,6 +257,11 @@ class WolfSSLRsa
       throw 'Invalid rsa key'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     return new Promise( ( res, rej ) => {
       wolfcrypt.wc_MakeRsaKey_async( this.rsa, size, e, ( err, ret ) => {
         if ( err )
@@ -189,6 +353,11 @@ class WolfSSLRsa
       throw 'Invalid rsa key'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     if ( !Buffer.isBuffer( derBuf ) )
     {
       throw 'Private key der must be Buffer'
@@ -220,6 +389,11 @@ class WolfSSLRsa
       throw 'Invalid rsa key'
     }
 
+    if ( this.cached )
+    {
+      throw 'Cached keys are read only'
+    }
+
     if ( !Buffer.isBuffer( derBuf ) )
     {
       throw 'Public key der must be Buffer'
@@ -355,7 +529,7 @@ class WolfSSLRsa
       throw `Failed to wc_RsaSSL_Sign ${ ret }`
     }
 
-    return sig
+    return sig.subarray( 0, ret )
   }
 
   /**
@@ -413,27 +587,875 @@ class WolfSSLRsa
   }
 
   /**
-   * Frees the data allocated by the rsa key
+   * Encrypts the provided data using the public key on the thread pool, uses callback
    *
-   * @throws {Error} If rsa key is not allocated.
+   * @param data The data to encrypt.
    *
-   * @throws {Error} If wc_FreeRsaKey fails.
+   * @param cb The callback function that will be called with an error or the encrypted message.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If data is not a string or Buffer.
    */
-  free()
+  PublicEncrypt_cb( data, cb )
   {
     if ( this.rsa == null )
     {
       throw 'Invalid rsa key'
     }
 
-    let ret = wolfcrypt.wc_FreeRsaKey( this.rsa )
+    if ( typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
 
-    if ( ret != 0 )
+    if ( !Buffer.isBuffer( data ) )
     {
-      throw `Failed to wc_FreeRsaKey ${ ret }`
+      throw 'Data must be string or Buffer'
     }
 
-    this.rsa = null
+    let ciphertext = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    this.pending++
+
+    wolfcrypt.wc_RsaPublicEncrypt_async( data, data.length, ciphertext, ciphertext.length, this.rsa, ( err, ret ) => {
+      this.pending--
+
+      if ( err )
+      {
+        return cb( err )
+      }
+
+      if ( ret <= 0 )
+      {
+        return cb( `Failed to wc_RsaPublicEncrypt ${ ret }` )
+      }
+
+      cb( null, ciphertext.subarray( 0, ret ) )
+    } )
+  }
+
+  /**
+   * Encrypts the provided data using the public key on the thread pool, uses promise
+   *
+   * @param data The data to encrypt.
+   *
+   * @returns A promise that resolves with the encrypted message as a data Buffer.
+   */
+  PublicEncrypt_promise( data )
+  {
+    return new Promise( ( res, rej ) => {
+      this.PublicEncrypt_cb( data, ( err, ciphertext ) => err ? rej( err ) : res( ciphertext ) )
+    } )
+  }
+
+  /**
+   * Decrypts the provided ciphertext using the private key on the thread pool, uses callback
+   *
+   * @param ciphertext The ciphertext to decrypt.
+   *
+   * @param cb The callback function that will be called with an error or the plaintext message.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If ciphertext is not a Buffer.
+   */
+  PrivateDecrypt_cb( ciphertext, cb )
+  {
+    if ( this.rsa == null )
+    {
+      throw 'Invalid rsa key'
+    }
+
+    if ( !Buffer.isBuffer( ciphertext ) )
+    {
+      throw `ciphertext must be a Buffer`
+    }
+
+    let data = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    this.pending++
+
+    wolfcrypt.wc_RsaPrivateDecrypt_async( ciphertext, ciphertext.length, data, data.length, this.rsa, ( err, ret ) => {
+      this.pending--
+
+      if ( err )
+      {
+        return cb( err )
+      }
+
+      if ( ret <= 0 )
+      {
+        return cb( `Failed to wc_RsaPrivateDecrypt ${ ret }` )
+      }
+
+      cb( null, data.subarray( 0, ret ) )
+    } )
+  }
+
+  /**
+   * Decrypts the provided ciphertext using the private key on the thread pool, uses promise
+   *
+   * @param ciphertext The ciphertext to decrypt.
+   *
+   * @returns A promise that resolves with the plaintext message as a data Buffer.
+   */
+  PrivateDecrypt_promise( ciphertext )
+  {
+    return new Promise( ( res, rej ) => {
+      this.PrivateDecrypt_cb( ciphertext, ( err, data ) => err ? rej( err ) : res( data ) )
+    } )
+  }
+
+  /**
+   * Generates a signature of the provided data using the private key on the thread pool, uses callback
+   *
+   * @param data The data to sign.
+   *
+   * @param cb The callback function that will be called with an error or the signature.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If data is not a string or Buffer.
+   */
+  SSL_Sign_cb( data, cb )
+  {
+    if ( this.rsa == null )
+    {
+      throw 'Invalid rsa key'
+    }
+
+    if ( typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
+
+    if ( !Buffer.isBuffer( data ) )
+    {
+      throw 'data must be a string or Buffer'
+    }
+
+    let sig = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    this.pending++
+
+    wolfcrypt.wc_RsaSSL_Sign_async( data, data.length, sig, sig.length, this.rsa, ( err, ret ) => {
+      this.pending--
+
+      if ( err )
+      {
+        return cb( err )
+      }
+
+      if ( ret <= 0 )
+      {
+        return cb( `Failed to wc_RsaSSL_Sign ${ ret }` )
+      }
+
+      cb( null, sig.subarray( 0, ret ) )
+    } )
+  }
+
+  /**
+   * Generates a signature of the provided data using the private key on the thread pool, uses promise
+   *
+   * @param data The data to sign.
+   *
+   * @returns A promise that resolves with the signature as a data Buffer.
+   */
+  SSL_Sign_promise( data )
+  {
+    return new Promise( ( res, rej ) => {
+      this.SSL_Sign_cb( data, ( err, sig ) => err ? rej( err ) : res( sig ) )
+    } )
+  }
+
+  /**
+   * Verifies a signature of the provided data using the public key on the thread pool, uses callback
+   *
+   * @param sig The signature to verify.
+   *
+   * @param data The data used to generate the signature.
+   *
+   * @param cb The callback function that will be called with an error or the verification result.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If sig is not a Buffer.
+   *
+   * @throws {Error} If data is not a string or Buffer.
+   */
+  SSL_Verify_cb( sig, data, cb )
+  {
+    if ( this.rsa == null )
+    {
+      throw 'Invalid rsa key'
+    }
+
+    if ( !Buffer.isBuffer( sig ) )
+    {
+      throw `signature must be a Buffer`
+    }
+
+    if ( typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
+
+    if ( !Buffer.isBuffer( data ) )
+    {
+      throw 'data must be a string or Buffer'
+    }
+
+    // the decoded signature is written here, data itself is left untouched
+    let decoded = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    this.pending++
+
+    wolfcrypt.wc_RsaSSL_Verify_async( sig, sig.length, decoded, decoded.length, this.rsa, ( err, validLength ) => {
+      this.pending--
+
+      if ( err )
+      {
+        return cb( err )
+      }
+
+      if ( validLength < 0 )
+      {
+        return cb( `Failed to wc_RsaSSL_Verify ${ validLength }` )
+      }
+
+      cb( null, validLength == data.length && decoded.subarray( 0, validLength ).equals( data ) )
+    } )
+  }
+
+  /**
+   * Verifies a signature of the provided data using the public key on the thread pool, uses promise
+   *
+   * @param sig The signature to verify.
+   *
+   * @param data The data used to generate the signature.
+   *
+   * @returns A promise that resolves with true if the signature is valid, false otherwise.
+   */
+  SSL_Verify_promise( sig, data )
+  {
+    return new Promise( ( res, rej ) => {
+      this.SSL_Verify_cb( sig, data, ( err, valid ) => err ? rej( err ) : res( valid ) )
+    } )
+  }
+
+  /**
+   * Signs the provided data with RSASSA-PSS using the private key, the data
+   * is hashed first and the salt is as long as the digest, as in PS256
+   *
+   * @param data The data to sign.
+   *
+   * @param hash The hash for the digest and MGF1, 'SHA256' by default.
+   *
+   * @returns The signature as a data Buffer.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If data is not a string or Buffer.
+   *
+   * @throws {Error} If wc_RsaPSS_Sign fails.
+   */
+  PSS_Sign( data, hash )
+  {
+    const { digest, type, mgf } = this.pssDigest( data, hash )
+
+    let sig = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    let ret = wolfcrypt.wc_RsaPSS_Sign( digest, digest.length, sig, sig.length, type, mgf, this.rsa )
+
+    if ( ret <= 0 )
+    {
+      throw `Failed to wc_RsaPSS_Sign ${ ret }`
+    }
+
+    return sig.subarray( 0, ret )
+  }
+
+  /**
+   * Verifies an RSASSA-PSS signature of the provided data using the public
+   * key, hashing and checking happen in one native call so the decoded
+   * signature block is never copied out
+   *
+   * @param sig The signature to verify.
+   *
+   * @param data The data used to generate the signature.
+   *
+   * @param hash The hash for the digest and MGF1, 'SHA256' by default.
+   *
+   * @returns true if the signature is valid, false otherwise.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If sig is not a Buffer.
+   *
+   * @throws {Error} If data is not a string or Buffer.
+   *
+   * @throws {Error} If nodejsRsaPSS_VerifyHash fails.
+   */
+  PSS_Verify( sig, data, hash )
+  {
+    const { type, mgf } = this.pssArgs( sig, data, hash )
+    data = typeof data == 'string' ? Buffer.from( data ) : data
+
+    let ret = wolfcrypt.nodejsRsaPSS_VerifyHash( sig, sig.length, data, data.length, type, mgf, this.rsa )
+
+    if ( ret < 0 )
+    {
+      throw `Failed to nodejsRsaPSS_VerifyHash ${ ret }`
+    }
+
+    return ret == 1
+  }
+
+  /**
+   * Signs the provided data with RSASSA-PSS on the thread pool, uses callback
+   *
+   * @param data The data to sign.
+   *
+   * @param hash The hash for the digest and MGF1, 'SHA256' if null.
+   *
+   * @param cb The callback function that will be called with an error or the signature.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If data is not a string or Buffer.
+   */
+  PSS_Sign_cb( data, hash, cb )
+  {
+    const { digest, type, mgf } = this.pssDigest( data, hash )
+
+    let sig = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    this.pending++
+
+    wolfcrypt.wc_RsaPSS_Sign_async( digest, digest.length, sig, sig.length, type, mgf, this.rsa, ( err, ret ) => {
+      this.pending--
+
+      if ( err )
+      {
+        return cb( err )
+      }
+
+      if ( ret <= 0 )
+      {
+        return cb( `Failed to wc_RsaPSS_Sign ${ ret }` )
+      }
+
+      cb( null, sig.subarray( 0, ret ) )
+    } )
+  }
+
+  /**
+   * Signs the provided data with RSASSA-PSS on the thread pool, uses promise
+   *
+   * @param data The data to sign.
+   *
+   * @param hash The hash for the digest and MGF1, 'SHA256' by default.
+   *
+   * @returns A promise that resolves with the signature as a data Buffer.
+   */
+  PSS_Sign_promise( data, hash )
+  {
+    return new Promise( ( res, rej ) => {
+      this.PSS_Sign_cb( data, hash, ( err, sig ) => err ? rej( err ) : res( sig ) )
+    } )
+  }
+
+  /**
+   * Verifies an RSASSA-PSS signature on the thread pool, uses callback
+   *
+   * @param sig The signature to verify.
+   *
+   * @param data The data used to generate the signature.
+   *
+   * @param hash The hash for the digest and MGF1, 'SHA256' if null.
+   *
+   * @param cb The callback function that will be called with an error or the verification result.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If sig is not a Buffer.
+   *
+   * @throws {Error} If data is not a string or Buffer.
+   */
+  PSS_Verify_cb( sig, data, hash, cb )
+  {
+    const { type, mgf } = this.pssArgs( sig, data, hash )
+    data = typeof data == 'string' ? Buffer.from( data ) : data
+
+    this.pending++
+
+    wolfcrypt.nodejsRsaPSS_VerifyHash_async( sig, sig.length, data, data.length, type, mgf, this.rsa, ( err, ret ) => {
+      this.pending--
+
+      if ( err )
+      {
+        return cb( err )
+      }
+
+      if ( ret < 0 )
+      {
+        return cb( `Failed to nodejsRsaPSS_VerifyHash ${ ret }` )
+      }
+
+      cb( null, ret == 1 )
+    } )
+  }
+
+  /**
+   * Verifies an RSASSA-PSS signature on the thread pool, uses promise
+   *
+   * @param sig The signature to verify.
+   *
+   * @param data The data used to generate the signature.
+   *
+   * @param hash The hash for the digest and MGF1, 'SHA256' by default.
+   *
+   * @returns A promise that resolves with true if the signature is valid, false otherwise.
+   */
+  PSS_Verify_promise( sig, data, hash )
+  {
+    return new Promise( ( res, rej ) => {
+      this.PSS_Verify_cb( sig, data, hash, ( err, valid ) => err ? rej( err ) : res( valid ) )
+    } )
+  }
+
+  /**
+   * Encrypts the provided data with RSAES-OAEP using the public key
+   *
+   * @param data The data to encrypt.
+   *
+   * @param hash The hash for OAEP and MGF1, 'SHA256' by default.
+   *
+   * @param label An optional label as a string or Buffer.
+   *
+   * @returns The encrypted message as a data Buffer.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If data is not a string or Buffer.
+   *
+   * @throws {Error} If wc_RsaPublicEncrypt_ex fails.
+   */
+  OAEP_Encrypt( data, hash, label )
+  {
+    const args = this.oaepArgs( data, hash, label, true )
+
+    let ciphertext = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    let ret = wolfcrypt.wc_RsaPublicEncrypt_ex( args.data, args.data.length, ciphertext, ciphertext.length, this.rsa,
+      args.pad, args.type, args.mgf, args.label, args.label ? args.label.length : 0 )
+
+    if ( ret <= 0 )
+    {
+      throw `Failed to wc_RsaPublicEncrypt_ex ${ ret }`
+    }
+
+    return ciphertext.subarray( 0, ret )
+  }
+
+  /**
+   * Decrypts RSAES-OAEP ciphertext using the private key
+   *
+   * @param ciphertext The ciphertext to decrypt.
+   *
+   * @param hash The hash used for encryption, 'SHA256' by default.
+   *
+   * @param label The label used for encryption, if any.
+   *
+   * @returns The plaintext message as a data Buffer.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If ciphertext is not a Buffer.
+   *
+   * @throws {Error} If wc_RsaPrivateDecrypt_ex fails.
+   */
+  OAEP_Decrypt( ciphertext, hash, label )
+  {
+    const args = this.oaepArgs( ciphertext, hash, label, false )
+
+    let data = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    let ret = wolfcrypt.wc_RsaPrivateDecrypt_ex( args.data, args.data.length, data, data.length, this.rsa,
+      args.pad, args.type, args.mgf, args.label, args.label ? args.label.length : 0 )
+
+    if ( ret < 0 )
+    {
+      throw `Failed to wc_RsaPrivateDecrypt_ex ${ ret }`
+    }
+
+    return data.subarray( 0, ret )
+  }
+
+  /**
+   * Encrypts the provided data with RSAES-OAEP on the thread pool, uses callback
+   *
+   * @param data The data to encrypt.
+   *
+   * @param hash The hash for OAEP and MGF1, 'SHA256' if null.
+   *
+   * @param label An optional label as a string or Buffer.
+   *
+   * @param cb The callback function that will be called with an error or the encrypted message.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If data is not a string or Buffer.
+   */
+  OAEP_Encrypt_cb( data, hash, label, cb )
+  {
+    const args = this.oaepArgs( data, hash, label, true )
+
+    let ciphertext = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    this.pending++
+
+    wolfcrypt.wc_RsaPublicEncrypt_ex_async( args.data, args.data.length, ciphertext, ciphertext.length, this.rsa,
+      args.pad, args.type, args.mgf, args.label, args.label ? args.label.length : 0, ( err, ret ) => {
+      this.pending--
+
+      if ( err )
+      {
+        return cb( err )
+      }
+
+      if ( ret <= 0 )
+      {
+        return cb( `Failed to wc_RsaPublicEncrypt_ex ${ ret }` )
+      }
+
+      cb( null, ciphertext.subarray( 0, ret ) )
+    } )
+  }
+
+  /**
+   * Encrypts the provided data with RSAES-OAEP on the thread pool, uses promise
+   *
+   * @param data The data to encrypt.
+   *
+   * @param hash The hash for OAEP and MGF1, 'SHA256' by default.
+   *
+   * @param label An optional label as a string or Buffer.
+   *
+   * @returns A promise that resolves with the encrypted message as a data Buffer.
+   */
+  OAEP_Encrypt_promise( data, hash, label )
+  {
+    return new Promise( ( res, rej ) => {
+      this.OAEP_Encrypt_cb( data, hash, label, ( err, ciphertext ) => err ? rej( err ) : res( ciphertext ) )
+    } )
+  }
+
+  /**
+   * Decrypts RSAES-OAEP ciphertext on the thread pool, uses callback
+   *
+   * @param ciphertext The ciphertext to decrypt.
+   *
+   * @param hash The hash used for encryption, 'SHA256' if null.
+   *
+   * @param label The label used for encryption, if any.
+   *
+   * @param cb The callback function that will be called with an error or the plaintext.
+   *
+   * @throws {Error} If the rsa key is not allocated.
+   *
+   * @throws {Error} If ciphertext is not a Buffer.
+   */
+  OAEP_Decrypt_cb( ciphertext, hash, label, cb )
+  {
+    const args = this.oaepArgs( ciphertext, hash, label, false )
+
+    let data = Buffer.alloc( wolfcrypt.wc_RsaEncryptSize( this.rsa ) )
+
+    this.pending++
+
+    wolfcrypt.wc_RsaPrivateDecrypt_ex_async( args.data, args.data.length, data, data.length, this.rsa,
+      args.pad, args.type, args.mgf, args.label, args.label ? args.label.length : 0, ( err, ret ) => {
+      this.pending--
+
+      if ( err )
+      {
+        return cb( err )
+      }
+
+      if ( ret < 0 )
+      {
+        return cb( `Failed to wc_RsaPrivateDecrypt_ex ${ ret }` )
+      }
+
+      cb( null, data.subarray( 0, ret ) )
+    } )
+  }
+
+  /**
+   * Decrypts RSAES-OAEP ciphertext on the thread pool, uses promise
+   *
+   * @param ciphertext The ciphertext to decrypt.
+   *
+   * @param hash The hash used for encryption, 'SHA256' by default.
+   *
+   * @param label The label used for encryption, if any.
+   *
+   * @returns A promise that resolves with the plaintext message as a data Buffer.
+   */
+  OAEP_Decrypt_promise( ciphertext, hash, label )
+  {
+    return new Promise( ( res, rej ) => {
+      this.OAEP_Decrypt_cb( ciphertext, hash, label, ( err, data ) => err ? rej( err ) : res( data ) )
+    } )
+  }
+
+  // checks the arguments of the PSS sign methods and hashes the data
+  pssDigest( data, hash )
+  {
+    if ( this.rsa == null )
+    {
+      throw 'Invalid rsa key'
+    }
+
+    requirePss()
+
+    if ( typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
+
+    if ( !Buffer.isBuffer( data ) )
+    {
+      throw 'data must be a string or Buffer'
+    }
+
+    const { type, mgf } = paddingHash( hash )
+    const digest = wolfcrypt.wc_Hash( type, data )
+
+    if ( typeof digest == 'number' )
+    {
+      throw `Failed to wc_Hash ${ digest }`
+    }
+
+    return { digest, type, mgf }
+  }
+
+  // checks the arguments of the PSS verify methods
+  pssArgs( sig, data, hash )
+  {
+    if ( this.rsa == null )
+    {
+      throw 'Invalid rsa key'
+    }
+
+    requirePss()
+
+    if ( !Buffer.isBuffer( sig ) )
+    {
+      throw `signature must be a Buffer`
+    }
+
+    if ( typeof data != 'string' && !Buffer.isBuffer( data ) )
+    {
+      throw 'data must be a string or Buffer'
+    }
+
+    return paddingHash( hash )
+  }
+
+  // checks the arguments of the OAEP methods, strings are only accepted as
+  // plaintext
+  oaepArgs( data, hash, label, plaintext )
+  {
+    if ( this.rsa == null )
+    {
+      throw 'Invalid rsa key'
+    }
+
+    requireOaep()
+
+    if ( plaintext && typeof data == 'string' )
+    {
+      data = Buffer.from( data )
+    }
+
+    if ( !Buffer.isBuffer( data ) )
+    {
+      throw plaintext ? 'Data must be string or Buffer' : 'ciphertext must be a Buffer'
+    }
+
+    const { type, mgf } = paddingHash( hash )
+
+    return { data, pad: wolfcrypt.typeof_RsaPad( 'OAEP' ), type, mgf, label: oaepLabel( label ) }
+  }
+
+  /**
+   * Makes a new rsa key like MakeRsaKey, or like MakeRsaKey_promise once the
+   * watchdog has seen wc_MakeRsaKey block the event loop and rerouting is on
+   *
+   * @param size The size of the rsa key.
+   *
+   * @param e The exponent parameter to use for key generation.
+   *
+   * @returns A promise that resolves when the key is finished.
+   */
+  MakeRsaKey_auto( size, e )
+  {
+    return runAuto( 'wc_MakeRsaKey', () => this.MakeRsaKey( size, e ), () => this.MakeRsaKey_promise( size, e ) )
+  }
+
+  /**
+   * Encrypts data with the public key, sync or async as picked by the watchdog
+   *
+   * @param data The data to encrypt.
+   *
+   * @returns A promise that resolves with the encrypted data.
+   */
+  PublicEncrypt_auto( data )
+  {
+    return runAuto( 'wc_RsaPublicEncrypt', () => this.PublicEncrypt( data ), () => this.PublicEncrypt_promise( data ) )
+  }
+
+  /**
+   * Decrypts data with the private key, sync or async as picked by the watchdog
+   *
+   * @param ciphertext The data to decrypt.
+   *
+   * @returns A promise that resolves with the decrypted data.
+   */
+  PrivateDecrypt_auto( ciphertext )
+  {
+    return runAuto( 'wc_RsaPrivateDecrypt', () => this.PrivateDecrypt( ciphertext ), () => this.PrivateDecrypt_promise( ciphertext ) )
+  }
+
+  /**
+   * Signs data with the private key, sync or async as picked by the watchdog
+   *
+   * @param data The data to sign.
+   *
+   * @returns A promise that resolves with the signature.
+   */
+  SSL_Sign_auto( data )
+  {
+    return runAuto( 'wc_RsaSSL_Sign', () => this.SSL_Sign( data ), () => this.SSL_Sign_promise( data ) )
+  }
+
+  /**
+   * Verifies a signature, sync or async as picked by the watchdog
+   *
+   * @param sig The signature to verify.
+   *
+   * @param data The data used to generate the signature.
+   *
+   * @returns A promise that resolves with true if the signature is valid.
+   */
+  SSL_Verify_auto( sig, data )
+  {
+    return runAuto( 'wc_RsaSSL_Verify', () => this.SSL_Verify( sig, data ), () => this.SSL_Verify_promise( sig, data ) )
+  }
+
+  /**
+   * Signs data with RSASSA-PSS, sync or async as picked by the watchdog
+   *
+   * @param data The data to sign.
+   *
+   * @param hash The hash for the digest and MGF1, 'SHA256' by default.
+   *
+   * @returns A promise that resolves with the signature.
+   */
+  PSS_Sign_auto( data, hash )
+  {
+    return runAuto( 'wc_RsaPSS_Sign', () => this.PSS_Sign( data, hash ), () => this.PSS_Sign_promise( data, hash ) )
+  }
+
+  /**
+   * Verifies an RSASSA-PSS signature, sync or async as picked by the watchdog
+   *
+   * @param sig The signature to verify.
+   *
+   * @param data The data used to generate the signature.
+   *
+   * @param hash The hash for the digest and MGF1, 'SHA256' by default.
+   *
+   * @returns A promise that resolves with true if the signature is valid.
+   */
+  PSS_Verify_auto( sig, data, hash )
+  {
+    return runAuto( 'nodejsRsaPSS_VerifyHash', () => this.PSS_Verify( sig, data, hash ), () => this.PSS_Verify_promise( sig, data, hash ) )
+  }
+
+  /**
+   * Encrypts data with RSAES-OAEP, sync or async as picked by the watchdog
+   *
+   * @param data The data to encrypt.
+   *
+   * @param hash The hash for OAEP and MGF1, 'SHA256' by default.
+   *
+   * @param label An optional label as a string or Buffer.
+   *
+   * @returns A promise that resolves with the encrypted data.
+   */
+  OAEP_Encrypt_auto( data, hash, label )
+  {
+    return runAuto( 'wc_RsaPublicEncrypt_ex', () => this.OAEP_Encrypt( data, hash, label ), () => this.OAEP_Encrypt_promise( data, hash, label ) )
+  }
+
+  /**
+   * Decrypts RSAES-OAEP ciphertext, sync or async as picked by the watchdog
+   *
+   * @param ciphertext The data to decrypt.
+   *
+   * @param hash The hash used for encryption, 'SHA256' by default.
+   *
+   * @param label The label used for encryption, if any.
+   *
+   * @returns A promise that resolves with the decrypted data.
+   */
+  OAEP_Decrypt_auto( ciphertext, hash, label )
+  {
+    return runAuto( 'wc_RsaPrivateDecrypt_ex', () => this.OAEP_Decrypt( ciphertext, hash, label ), () => this.OAEP_Decrypt_promise( ciphertext, hash, label ) )
+  }
+
+  /**
+   * Frees the data allocated by the rsa key
+   *
+   * @throws {Error} If rsa key is not allocated.
+   *
+   * @throws {Error} If async operations are still running on the key.
+   *
+   * @throws {Error} If wc_FreeRsaKey fails.
+   */
+  free()
+  {
+    if ( this.rsa == null )
+    {
+      throw 'Invalid rsa key'
+    }
+
+    if ( this.pending > 0 )
+    {
+      throw 'Rsa key has pending operations'
+    }
+
+    // the cache and other handles still use the key
+    if ( this.cached )
+    {
+      this.rsa = null
+
+      return
+    }
+
+    let ret = wolfcrypt.wc_FreeRsaKey( this.rsa )
+    wolfcrypt.nodejsHandleRelease( this.rsa )
+    this.rsa = null
+
+    if ( ret != 0 )
+    {
+      throw `Failed to wc_FreeRsaKey ${ ret }`
+    }
   }
 }
 
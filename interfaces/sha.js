@@ -19,21 +19,169 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { packBatch } = require( './util/batch' )
+
+// accepts either an array of strings or Buffers, or a packed Buffer with a
+// Uint32Array of count + 1 offsets
+function packMessages( messages, offsets )
+{
+  if ( Buffer.isBuffer( messages ) )
+  {
+    if ( !( offsets instanceof Uint32Array ) || offsets.length < 1 || offsets[offsets.length - 1] > messages.length )
+    {
+      throw 'offsets must be a Uint32Array of count + 1 offsets into messages'
+    }
+
+    return { data: messages, offsets: offsets }
+  }
+
+  if ( !Array.isArray( messages ) )
+  {
+    throw 'messages must be an array or a packed Buffer'
+  }
+
+  return packBatch( messages, 'messages' )
+}
+
+// wc_HashType values looked up once per name
+const hashTypes = {}
+
+function hashType( type )
+{
+  if ( hashTypes[type] === undefined )
+  {
+    hashTypes[type] = wolfcrypt.typeof_Hash( type )
+  }
+
+  if ( hashTypes[type] < 0 )
+  {
+    throw 'Invalid Sha type'
+  }
+
+  return hashTypes[type]
+}
 
 class WolfSSLSha
 {
+  /**
+   * Hashes data in a single native call without allocating a context
+   *
+   * @param type The hash to use, SHA, SHA256, SHA3_256, etc.
+   *
+   * @param data The data to hash, as a string or Buffer.
+   *
+   * @param out Optional Buffer to write the digest into.
+   *
+   * @param offset Where in out to write the digest, defaults to 0.
+   *
+   * @returns The digest as a Buffer, or the number of bytes written when out is passed.
+   *
+   * @throws {Error} If the type is invalid or wc_Hash fails.
+   */
+  static hash( type, data, out, offset = 0 )
+  {
+    let ret
+
+    if ( out === undefined )
+    {
+      ret = wolfcrypt.wc_Hash( hashType( type ), data )
+
+      if ( typeof ret == 'number' )
+      {
+        throw `Failed to wc_Hash ${ ret }`
+      }
+
+      return ret
+    }
+
+    ret = wolfcrypt.wc_Hash( hashType( type ), data, out, offset )
+
+    if ( ret < 0 )
+    {
+      throw `Failed to wc_Hash ${ ret }`
+    }
+
+    return ret
+  }
+
+  /**
+   * Hashes many independent messages in a single native call
+   *
+   * @param type The hash to use, SHA, SHA256, SHA3_256, etc.
+   *
+   * @param messages An array of strings or Buffers, or one Buffer with the messages packed back to back.
+   *
+   * @param offsets With a packed Buffer, a Uint32Array of count + 1 offsets marking where each message starts.
+   *
+   * @returns A Buffer with the digests back to back, digest i starts at i * digest length.
+   *
+   * @throws {Error} If the arguments are invalid or wc_HashMany fails.
+   */
+  static hashMany( type, messages, offsets )
+  {
+    const packed = packMessages( messages, offsets )
+
+    let ret = wolfcrypt.wc_HashMany( hashType( type ), packed.data, packed.offsets )
+
+    if ( typeof ret == 'number' )
+    {
+      throw `Failed to wc_HashMany ${ ret }`
+    }
+
+    return ret
+  }
+
+  /**
+   * Hashes many independent messages on the thread pool, large batches are split across several workers
+   *
+   * @param type The hash to use, SHA, SHA256, SHA3_256, etc.
+   *
+   * @param messages An array of strings or Buffers, or one Buffer with the messages packed back to back.
+   *
+   * @param offsets With a packed Buffer, a Uint32Array of count + 1 offsets marking where each message starts.
+   *
+   * @returns A promise that resolves with a Buffer of the digests back to back.
+   *
+   * @throws {Error} If the arguments are invalid.
+   */
+  static hashMany_promise( type, messages, offsets )
+  {
+    const packed = packMessages( messages, offsets )
+
+    return new Promise( ( res, rej ) => {
+      wolfcrypt.wc_HashMany_async( hashType( type ), packed.data, packed.offsets, ( err, ret, digests ) => {
+        if ( err )
+        {
+          return rej( err )
+        }
+
+        if ( ret != 0 )
+        {
+          return rej( `Failed to wc_HashMany ${ ret }` )
+        }
+
+        res( digests )
+      } )
+    } )
+  }
+
   constructor( type )
   {
     let ret;
 
-    this.sha = null
     this.digestLength = -1
 
+    // the finalizer of the native context frees it, there is no free to call
+    this.sha = wolfcrypt.nodejsShaNew( hashType( type ) )
+
+    if ( typeof this.sha == 'number' )
+    {
+      throw `Failed to nodejsShaNew ${ this.sha }`
+    }
+
     switch ( type )
     {
       case 'SHA':
-        this.sha = Buffer.alloc( wolfcrypt.sizeof_WOLFSSL_SHA_CTX() )
-
         ret = wolfcrypt.wolfSSL_SHA_Init( this.sha )
 
         if ( ret != 1 )
@@ -46,8 +194,6 @@ class WolfSSLSha
 
         break;
       case 'SHA224':
-        this.sha = Buffer.alloc( wolfcrypt.sizeof_WOLFSSL_SHA224_CTX() )
-
         ret = wolfcrypt.wolfSSL_SHA224_Init( this.sha )
 
         if ( ret != 1 )
@@ -60,8 +206,6 @@ class WolfSSLSha
 
         break;
       case 'SHA256':
-        this.sha = Buffer.alloc( wolfcrypt.sizeof_WOLFSSL_SHA256_CTX() )
-
         ret = wolfcrypt.wolfSSL_SHA256_Init( this.sha )
 
         if ( ret != 1 )
@@ -74,8 +218,6 @@ class WolfSSLSha
 
         break;
       case 'SHA384':
-        this.sha = Buffer.alloc( wolfcrypt.sizeof_WOLFSSL_SHA384_CTX() )
-
         ret = wolfcrypt.wolfSSL_SHA384_Init( this.sha )
 
         if ( ret != 1 )
@@ -88,8 +230,6 @@ class WolfSSLSha
 
         break;
       case 'SHA512':
-        this.sha = Buffer.alloc( wolfcrypt.sizeof_WOLFSSL_SHA512_CTX() )
-
         ret = wolfcrypt.wolfSSL_SHA512_Init( this.sha )
 
         if ( ret != 1 )
@@ -102,8 +242,6 @@ class WolfSSLSha
 
         break;
       case 'SHA512_224':
-        this.sha = Buffer.alloc( wolfcrypt.sizeof_WOLFSSL_SHA512_224_CTX() )
-
         ret = wolfcrypt.wolfSSL_SHA512_224_Init( this.sha )
 
         if ( ret != 1 )
@@ -116,8 +254,6 @@ class WolfSSLSha
 
         break;
       case 'SHA512_256':
-        this.sha = Buffer.alloc( wolfcrypt.sizeof_WOLFSSL_SHA512_256_CTX() )
-
         ret = wolfcrypt.wolfSSL_SHA512_256_Init( this.sha )
 
         if ( ret != 1 )
@@ -165,6 +301,51 @@ class WolfSSLSha
     }
   }
 
+  /**
+   * Creates an independent copy of this hash, including the data added so far
+   *
+   * @returns A new WolfSSLSha with the same state.
+   *
+   * @throws {Error} If the sha is not allocated or the copy fails.
+   */
+  copy()
+  {
+    if ( this.sha == null )
+    {
+      throw 'Sha is not allocated'
+    }
+
+    let copy = Object.create( WolfSSLSha.prototype )
+
+    Object.assign( copy, this )
+    copy.sha = wolfcrypt.nodejsShaNew( hashType( this.type ) )
+
+    if ( typeof copy.sha == 'number' )
+    {
+      throw `Failed to nodejsShaNew ${ copy.sha }`
+    }
+
+    let ret = wolfcrypt.nodejsShaCopy( hashType( this.type ), this.sha, copy.sha )
+
+    if ( ret != 0 )
+    {
+      throw `Failed to copy Sha ${ ret }`
+    }
+
+    return copy
+  }
+
+  /**
+   * Computes the digest of the data added so far without ending the hash,
+   * update can still be called afterwards
+   *
+   * @returns The digest as a Buffer.
+   */
+  digest()
+  {
+    return this.copy().finalize()
+  }
+
   finalize()
   {
     if ( this.sha == null )
@@ -0,0 +1,70 @@
+/* stats.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+
+/**
+ * Returns a snapshot of the counters kept for every native function called
+ * since the last reset, keyed by the name it is exported under. Histograms
+ * have 32 buckets, bucket i counts the calls that took less than 2^(i + 1)
+ * nanoseconds. Functions that queue work also report how long it waited for
+ * a thread and how long it ran under async.
+ *
+ * @returns An object { enabled, ops: { name: { calls, bytes, ns, histogram,
+ * errors: { code: count }, async: { calls, queueNs, queueMaxNs, executeNs,
+ * histogram } } } }.
+ */
+const getStats = function()
+{
+  return wolfcrypt.nodejsStats()
+}
+
+exports.getStats = getStats
+
+/**
+ * Clears all counters.
+ */
+const resetStats = function()
+{
+  wolfcrypt.nodejsStatsReset()
+}
+
+exports.resetStats = resetStats
+
+/**
+ * Switches the counters on or off, they are off unless the WOLFCRYPT_STATS
+ * environment variable is set when the module loads. While off every call
+ * only pays for checking the switch.
+ *
+ * @param enabled Whether to count calls.
+ *
+ * @returns Whether the counters were on before.
+ */
+const setStatsEnabled = function( enabled )
+{
+  return wolfcrypt.nodejsStatsEnabled( !!enabled )
+}
+
+exports.setStatsEnabled = setStatsEnabled
+
+if ( process.env.WOLFCRYPT_STATS && process.env.WOLFCRYPT_STATS != '0' )
+{
+  setStatsEnabled( true )
+}
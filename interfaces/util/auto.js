@@ -0,0 +1,44 @@
+/* auto.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../../build/Release/wolfcrypt' )
+
+// backs the _auto methods, runs the sync version and returns its result as a
+// promise until the watchdog has seen the native function block the main
+// thread for longer than its threshold, from then on while rerouting is on
+// the async version is used instead
+function runAuto( name, sync, async )
+{
+  try
+  {
+    if ( wolfcrypt.nodejsWatchdogRerouted( name ) )
+    {
+      return async()
+    }
+
+    return Promise.resolve( sync() )
+  }
+  catch ( err )
+  {
+    return Promise.reject( err )
+  }
+}
+
+exports.runAuto = runAuto
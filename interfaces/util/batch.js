@@ -0,0 +1,43 @@
+/* batch.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+// packs a list of strings or Buffers into one Buffer with count + 1 offsets,
+// so a whole batch crosses into native code as two arguments
+function packBatch( items, name )
+{
+  let offsets = new Uint32Array( items.length + 1 )
+  let buffers = new Array( items.length )
+
+  for ( let i = 0; i < items.length; i++ )
+  {
+    buffers[i] = typeof items[i] == 'string' ? Buffer.from( items[i] ) : items[i]
+
+    if ( !Buffer.isBuffer( buffers[i] ) )
+    {
+      throw `${ name } must be an array of strings or Buffers`
+    }
+
+    offsets[i + 1] = offsets[i] + buffers[i].length
+  }
+
+  return { data: Buffer.concat( buffers ), offsets: offsets }
+}
+
+exports.packBatch = packBatch
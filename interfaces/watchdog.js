@@ -0,0 +1,69 @@
+/* watchdog.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+
+/**
+ * Reports sync native calls that block the event loop for longer than
+ * thresholdMs. Every such call is kept as an event with its function name, a
+ * summary of its arguments (numbers, and buffer and string sizes) and its
+ * duration, and the function is marked slow.
+ *
+ * @param thresholdMs The longest a call may take, 0 turns the watchdog off.
+ *
+ * @param options { reroute } sends calls of the _auto methods whose native
+ * function was marked slow to the async version from then on.
+ *
+ * @returns The previous settings as { thresholdMs, reroute }.
+ */
+const setWatchdog = function( thresholdMs, options = {} )
+{
+  const previous = wolfcrypt.nodejsWatchdog( Math.round( thresholdMs * 1e6 ), !!options.reroute )
+
+  return { thresholdMs: previous.thresholdNs / 1e6, reroute: previous.reroute }
+}
+
+exports.setWatchdog = setWatchdog
+
+/**
+ * Returns the last 64 watchdog events, oldest first.
+ *
+ * @param clear Also drop the events and forget which functions were slow.
+ *
+ * @returns An object { total, events: [ { name, args, ms, time } ] } where
+ * total counts every event including the ones no longer kept, and time is
+ * when the call finished in milliseconds since the epoch.
+ */
+const getWatchdogEvents = function( clear = false )
+{
+  const result = wolfcrypt.nodejsWatchdogEvents( !!clear )
+
+  return {
+    total: result.total,
+    events: result.events.map( ( event ) => ( { name: event.name, args: event.args, ms: event.ns / 1e6, time: event.time } ) )
+  }
+}
+
+exports.getWatchdogEvents = getWatchdogEvents
+
+if ( process.env.WOLFCRYPT_WATCHDOG_MS )
+{
+  setWatchdog( parseFloat( process.env.WOLFCRYPT_WATCHDOG_MS ), { reroute: process.env.WOLFCRYPT_WATCHDOG_REROUTE == '1' } )
+}
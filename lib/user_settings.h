@@ -52,7 +52,11 @@
     #define ECC_MIN_KEY_SZ 224
     #define HAVE_ECC_BRAINPOOL
     #define HAVE_CURVE25519
+    #define HAVE_ED25519
     #define FP_ECC
+    /* room for the generators plus a few dozen verification keys, the
+     * tables of an entry are only allocated once a base point uses it */
+    #define FP_ENTRIES 32
     #define HAVE_ECC_ENCRYPT
     #define WOLFCRYPT_HAVE_ECCSI
     #define WOLFSSL_CUSTOM_CURVES
@@ -0,0 +1,151 @@
+/* curve25519.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const { WolfSSLCurve25519 } = require( '../interfaces/curve25519' )
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+
+// RFC 7748 section 6.1
+const alicePrivate = Buffer.from( '77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a', 'hex' )
+const alicePublic = Buffer.from( '8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a', 'hex' )
+const bobPublic = Buffer.from( 'de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f', 'hex' )
+const rfcSecret = Buffer.from( '4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742', 'hex' )
+
+const curve25519_tests =
+{
+  x25519_sharedSecret: async function()
+  {
+    if ( wolfcrypt.nodejsCurve25519KeyNew == null )
+    {
+      console.log( 'SKIP curve25519 sharedSecret, built without HAVE_CURVE25519' )
+      return
+    }
+
+    let alice = new WolfSSLCurve25519()
+    let bob = new WolfSSLCurve25519()
+
+    alice.make_key()
+    await bob.make_key_promise()
+
+    let bobPub = new WolfSSLCurve25519()
+    bobPub.import_public( bob.export_public() )
+
+    const secret = alice.shared_secret( bobPub )
+    const asyncSecret = await bob.shared_secret_async( alice )
+
+    alice.free()
+    bob.free()
+    bobPub.free()
+
+    if ( secret.equals( asyncSecret ) )
+    {
+      console.log( 'PASS curve25519 sharedSecret' )
+    }
+    else
+    {
+      console.log( 'FAIL curve25519 sharedSecret' )
+    }
+  },
+
+  x25519_sharedSecretMany: async function()
+  {
+    if ( wolfcrypt.nodejsCurve25519KeyNew == null )
+    {
+      console.log( 'SKIP curve25519 sharedSecretMany, built without HAVE_CURVE25519' )
+      return
+    }
+
+    let alice = new WolfSSLCurve25519()
+    let peers = []
+
+    alice.make_key()
+
+    for ( let i = 0; i < 5; i++ )
+    {
+      let peer = new WolfSSLCurve25519()
+      peer.make_key()
+      peers.push( peer )
+    }
+
+    const expected = peers.map( ( peer ) => alice.shared_secret( peer ) )
+    const pubBufs = peers.map( ( peer ) => peer.export_public() )
+    // an all zero public key is a low order point, its secret fails
+    pubBufs.push( Buffer.alloc( 32 ) )
+
+    const secrets = alice.shared_secret_many( peers )
+    const asyncSecrets = await alice.shared_secret_many_async( pubBufs )
+
+    let badLength = false
+
+    try
+    {
+      await alice.shared_secret_many_async( [ Buffer.alloc( 31 ) ] )
+    }
+    catch ( e )
+    {
+      badLength = true
+    }
+
+    alice.free()
+    peers.forEach( ( peer ) => peer.free() )
+
+    const matches = ( results ) => expected.every( ( secret, i ) => results[i] != null && secret.equals( results[i] ) )
+
+    if ( secrets.length == 5 && matches( secrets ) && asyncSecrets.length == 6 && matches( asyncSecrets ) && asyncSecrets[5] == null && badLength )
+    {
+      console.log( 'PASS curve25519 sharedSecretMany' )
+    }
+    else
+    {
+      console.log( 'FAIL curve25519 sharedSecretMany' )
+    }
+  },
+
+  x25519_rfcVector: function()
+  {
+    if ( wolfcrypt.nodejsCurve25519KeyNew == null )
+    {
+      console.log( 'SKIP curve25519 rfcVector, built without HAVE_CURVE25519' )
+      return
+    }
+
+    let alice = new WolfSSLCurve25519()
+    let bob = new WolfSSLCurve25519()
+
+    alice.import_private( alicePrivate )
+    bob.import_public( bobPublic )
+
+    const pub = alice.export_public()
+    const secret = alice.shared_secret( bob )
+
+    alice.free()
+    bob.free()
+
+    if ( pub.equals( alicePublic ) && secret.equals( rfcSecret ) )
+    {
+      console.log( 'PASS curve25519 rfcVector' )
+    }
+    else
+    {
+      console.log( 'FAIL curve25519 rfcVector' )
+    }
+  }
+}
+
+module.exports = curve25519_tests
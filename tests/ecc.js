@@ -19,6 +19,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 const { WolfSSLEcc } = require( '../interfaces/ecc' )
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { WolfSSL_KeyCacheStats, WolfSSL_KeyCacheLimit, WolfSSL_KeyCacheClear } = require( '../interfaces/key_cache' )
+const { WolfSSL_EccFpWarm, WolfSSL_EccFpWarmSync, WolfSSL_EccFpStats, WolfSSL_EccFpFree } = require( '../interfaces/ecc_fp' )
+const { WolfSSL_KeyPoolConfigure, WolfSSL_KeyPoolStats, WolfSSL_KeyPoolClear } = require( '../interfaces/key_pool' )
 
 const message = 'Hello WolfSSL!'
 const message16 = '1234567890123456'
@@ -131,6 +135,111 @@ const ecc_tests =
     ecc0.free()
   },
 
+  ecc_signVerifyAsync: async function()
+  {
+    let ecc0 = new WolfSSLEcc()
+
+    await ecc0.make_key_promise( 32 )
+
+    // several signatures in flight on the same key
+    const sigs = await Promise.all([ ecc0.sign_hash_async( message ), ecc0.sign_hash_async( message ), ecc0.sign_hash_async( message16 ) ])
+
+    const results = await Promise.all([ ecc0.verify_hash_async( sigs[0], message ), ecc0.verify_hash_async( sigs[1], message ),
+      ecc0.verify_hash_async( sigs[2], message16 ), ecc0.verify_hash_async( sigs[2], message ) ])
+
+    if ( results[0] && results[1] && results[2] && !results[3] && ecc0.verify_hash( sigs[0], message ) == true )
+    {
+      console.log( 'PASS ecc signVerifyAsync' )
+    }
+    else
+    {
+      console.log( 'FAIL ecc signVerifyAsync', results )
+    }
+
+    ecc0.free()
+  },
+
+  ecc_sharedSecretAsync: async function()
+  {
+    let ecc0 = new WolfSSLEcc()
+    let ecc1 = new WolfSSLEcc()
+
+    await Promise.all([ ecc0.make_key_promise( 32 ), ecc1.make_key_promise( 32 ) ])
+
+    // both directions at once so the pair lock is exercised
+    const secrets = await Promise.all([ ecc0.shared_secret_async( ecc1 ), ecc1.shared_secret_async( ecc0 ) ])
+
+    const secret_0 = secrets[0].toString( 'hex' )
+    const secret_1 = secrets[1].toString( 'hex' )
+
+    if ( secret_0 == secret_1 && secret_0 == ecc0.shared_secret( ecc1 ).toString( 'hex' ) )
+    {
+      console.log( 'PASS ecc sharedSecretAsync' )
+    }
+    else
+    {
+      console.log( 'FAIL ecc sharedSecretAsync', secret_0, secret_1 )
+    }
+
+    ecc0.free()
+    ecc1.free()
+  },
+
+  ecc_verifyBatch: async function()
+  {
+    let ecc0 = new WolfSSLEcc()
+    let ecc1 = new WolfSSLEcc()
+
+    await Promise.all([ ecc0.make_key_promise( 32 ), ecc1.make_key_promise( 32 ) ])
+
+    let sigs = []
+    let hashes = []
+    let keys = []
+
+    // enough signatures to be split across several workers
+    for ( let i = 0; i < 100; i++ )
+    {
+      const key = i % 2 ? ecc1 : ecc0
+
+      hashes.push( `${ message } ${ i }` )
+      sigs.push( key.sign_hash( hashes[i] ) )
+      keys.push( key )
+    }
+
+    // break one signature for each form, the single key batch gets a
+    // signature forged with the other key and the multi key batch a signature
+    // checked against the wrong hash
+    let singleSigs = sigs.filter( ( s, i ) => i % 2 == 0 )
+    let singleHashes = hashes.filter( ( h, i ) => i % 2 == 0 )
+
+    singleSigs[3] = ecc1.sign_hash( singleHashes[3] )
+    hashes[7] = message
+
+    const single = await ecc0.verify_hash_batch( singleSigs, singleHashes )
+    const multi = await WolfSSLEcc.verify_hash_batch_multi( keys, sigs, hashes )
+
+    // offsets running past the packed data are rejected before anything is queued
+    const badOffsets = await new Promise( ( res ) => {
+      wolfcrypt.wc_ecc_verify_hash_batch( ecc0.ecc, Buffer.alloc( 8 ), new Uint32Array( [ 0, 64 ] ),
+        Buffer.alloc( 8 ), new Uint32Array( [ 0, 8 ] ), ( err, ret ) => res( ret ) )
+    } )
+
+    const singleOk = single.length == 50 && single.every( ( r, i ) => r == ( i == 3 ? 0 : 1 ) )
+    const multiOk = multi.length == 100 && multi.every( ( r, i ) => r == ( i == 7 ? 0 : 1 ) )
+
+    if ( singleOk && multiOk && badOffsets < 0 )
+    {
+      console.log( 'PASS ecc verifyBatch' )
+    }
+    else
+    {
+      console.log( 'FAIL ecc verifyBatch', single, multi, badOffsets )
+    }
+
+    ecc0.free()
+    ecc1.free()
+  },
+
   ecc_importExportx963: function()
   {
     let ecc0 = new WolfSSLEcc()
@@ -188,6 +297,159 @@ const ecc_tests =
 
     ecc1.free()
     ecc2.free()
+  },
+
+  eccNativeHandle: async function()
+  {
+    if ( typeof global.gc != 'function' )
+    {
+      console.log( 'SKIP ecc eccNativeHandle, run node with --expose-gc' )
+      return
+    }
+
+    const before = wolfcrypt.nodejsHandleStats()
+
+    let ecc = new WolfSSLEcc()
+    // never freed, its finalizer has to clean up
+    let leaked = new WolfSSLEcc()
+
+    ecc.make_key( 32 )
+    leaked.make_key( 32 )
+
+    const during = wolfcrypt.nodejsHandleStats()
+    const sig = ecc.sign_hash( message )
+    const verified = ecc.verify_hash( sig, message )
+
+    ecc.free()
+    leaked = null
+
+    const dropped = wolfcrypt.nodejsHandleStats()
+
+    // finalizers may be deferred until after the collection returns
+    global.gc()
+    await new Promise( ( res ) => setImmediate( res ) )
+
+    const collected = wolfcrypt.nodejsHandleStats()
+
+    if ( verified == true && during.live >= before.live + 2 && during.bytes > before.bytes && collected.live < dropped.live )
+    {
+      console.log( 'PASS ecc eccNativeHandle' )
+    }
+    else
+    {
+      console.log( 'FAIL ecc eccNativeHandle', before, during, dropped, collected, verified )
+    }
+  },
+
+  eccKeyCache: async function()
+  {
+    let ecc = new WolfSSLEcc()
+    ecc.make_key( 32 )
+
+    const privKeyDer = ecc.PrivateKeyToDer()
+    const pubKeyDer = ecc.PublicKeyToDer()
+    ecc.free()
+
+    WolfSSL_KeyCacheClear()
+    const limit = WolfSSL_KeyCacheLimit( 1 )
+    const before = WolfSSL_KeyCacheStats().ecc
+
+    let signer = WolfSSLEcc.PrivateKeyDecodeCached( privKeyDer )
+    // evicts the private key, which the signer keeps using
+    let verifier = WolfSSLEcc.PublicKeyDecodeCached( pubKeyDer )
+
+    const after = WolfSSL_KeyCacheStats().ecc
+    WolfSSL_KeyCacheLimit( limit )
+
+    const sig = await signer.sign_hash_async( message )
+    const verified = await verifier.verify_hash_async( sig, message )
+
+    signer.free()
+    verifier.free()
+
+    if ( verified == true && after.size == 1 && after.misses == before.misses + 2 && after.evictions == before.evictions + 1 )
+    {
+      console.log( 'PASS ecc eccKeyCache' )
+    }
+    else
+    {
+      console.log( 'FAIL ecc eccKeyCache', before, after, verified )
+    }
+  },
+
+  eccFpCache: async function()
+  {
+    let ecc = new WolfSSLEcc()
+    ecc.make_key( 32 )
+
+    const x963 = ecc.export_x963()
+    const sig = ecc.sign_hash( message )
+
+    if ( !WolfSSL_EccFpStats().enabled )
+    {
+      ecc.free()
+      console.log( 'SKIP ecc eccFpCache, built without FP_ECC' )
+      return
+    }
+
+    // the async warm leaves the main thread to the sync one
+    const pool = await WolfSSL_EccFpWarm( [ ecc ], [ 32 ] )
+    const poolOnly = pool.shared || pool.threads.every( ( thread ) => !thread.main )
+    const warm = WolfSSL_EccFpWarmSync( [ ecc ], [ 32 ] )
+
+    // the tables only speed verification up, results must not change
+    const verified = ecc.verify_hash( sig, message ) && await ecc.verify_hash_async( sig, message )
+    // with a shared cache the one entry is warmed from a pool thread
+    const main = warm.threads.find( ( thread ) => thread.main || warm.shared )
+    const keyWarm = main != null && main.keys.some( ( key ) => key.equals( x963 ) ) && main.curves.includes( 32 )
+
+    await WolfSSL_EccFpFree()
+    const freed = WolfSSL_EccFpStats()
+
+    ecc.free()
+
+    if ( verified == true && poolOnly && keyWarm && warm.threads.every( ( thread ) => thread.entries <= warm.capacity ) && freed.threads.length == 0 )
+    {
+      console.log( 'PASS ecc eccFpCache' )
+    }
+    else
+    {
+      console.log( 'FAIL ecc eccFpCache', pool, warm, freed, verified )
+    }
+  },
+
+  eccKeyPool: async function()
+  {
+    WolfSSL_KeyPoolConfigure( { type: 'ecc', size: 32, depth: 4, threads: 2 } )
+
+    // wait for the background refills
+    for ( let i = 0; i < 500 && WolfSSL_KeyPoolStats()[ 0 ].ready < 4; i++ )
+    {
+      await new Promise( ( res ) => setTimeout( res, 10 ) )
+    }
+
+    const filled = WolfSSL_KeyPoolStats()[ 0 ]
+    // the fifth key misses and is made on demand, unless a background refill
+    // already landed between the takes
+    const keys = await Promise.all( [ 0, 1, 2, 3, 4 ].map( () => WolfSSLEcc.make_key_pooled( 32 ) ) )
+    const taken = WolfSSL_KeyPoolStats()[ 0 ]
+
+    const sig = await keys[ 0 ].sign_hash_async( message )
+    const verified = keys[ 0 ].verify_hash( sig, message )
+    const distinct = new Set( keys.map( ( key ) => key.export_x963().toString( 'hex' ) ) ).size == 5
+
+    keys.forEach( ( key ) => key.free() )
+    WolfSSL_KeyPoolClear()
+
+    if ( verified == true && distinct && filled.ready == 4 && filled.refills == 4 && taken.hits >= 4 &&
+      taken.hits + taken.misses == 5 && taken.misses <= 1 && WolfSSL_KeyPoolStats().length == 0 )
+    {
+      console.log( 'PASS ecc eccKeyPool' )
+    }
+    else
+    {
+      console.log( 'FAIL ecc eccKeyPool', filled, taken, verified, distinct )
+    }
   }
 }
 
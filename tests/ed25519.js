@@ -0,0 +1,151 @@
+/* ed25519.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const { WolfSSLEd25519 } = require( '../interfaces/ed25519' )
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+
+const message = 'Hello WolfSSL!'
+
+// RFC 8032 test 1, the empty message
+const rfcPrivate = Buffer.from( '9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60', 'hex' )
+const rfcPublic = Buffer.from( 'd75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a', 'hex' )
+const rfcSig = Buffer.from( 'e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b', 'hex' )
+
+const ed25519_tests =
+{
+  ed25519_signVerify: async function()
+  {
+    if ( wolfcrypt.nodejsEd25519KeyNew == null )
+    {
+      console.log( 'SKIP ed25519 signVerify, built without HAVE_ED25519' )
+      return
+    }
+
+    let key = new WolfSSLEd25519()
+    await key.make_key_promise()
+
+    const sig = key.sign_msg( message )
+    const asyncSig = await key.sign_msg_async( message )
+
+    // ed25519 signatures are deterministic
+    const ok = sig.equals( asyncSig ) && key.verify_msg( sig, message ) &&
+      await key.verify_msg_async( sig, message ) && !key.verify_msg( sig, message + '!' )
+
+    key.free()
+
+    if ( ok )
+    {
+      console.log( 'PASS ed25519 signVerify' )
+    }
+    else
+    {
+      console.log( 'FAIL ed25519 signVerify' )
+    }
+  },
+
+  ed25519_importExport: function()
+  {
+    if ( wolfcrypt.nodejsEd25519KeyNew == null )
+    {
+      console.log( 'SKIP ed25519 importExport, built without HAVE_ED25519' )
+      return
+    }
+
+    let signer = new WolfSSLEd25519()
+    signer.import_private( rfcPrivate )
+
+    const sig = signer.sign_msg( Buffer.alloc( 0 ) )
+    const privDer = signer.PrivateKeyToDer()
+    const pubDer = signer.PublicKeyToDer()
+    const pub = signer.export_public()
+    signer.free()
+
+    let decoded = new WolfSSLEd25519()
+    decoded.PrivateKeyDecode( privDer )
+    const priv = decoded.export_private()
+    decoded.free()
+
+    let verifier = new WolfSSLEd25519()
+    verifier.PublicKeyDecode( pubDer )
+    const verified = verifier.verify_msg( rfcSig, Buffer.alloc( 0 ) )
+    verifier.free()
+
+    if ( sig.equals( rfcSig ) && pub.equals( rfcPublic ) && priv.equals( rfcPrivate ) && verified )
+    {
+      console.log( 'PASS ed25519 importExport' )
+    }
+    else
+    {
+      console.log( 'FAIL ed25519 importExport' )
+    }
+  },
+
+  ed25519_verifyBatch: async function()
+  {
+    if ( wolfcrypt.nodejsEd25519KeyNew == null )
+    {
+      console.log( 'SKIP ed25519 verifyBatch, built without HAVE_ED25519' )
+      return
+    }
+
+    let keys = [ new WolfSSLEd25519(), new WolfSSLEd25519() ]
+    keys.forEach( ( key ) => key.make_key() )
+
+    let msgs = []
+    let sigs = []
+    let multiKeys = []
+
+    for ( let i = 0; i < 200; i++ )
+    {
+      msgs.push( `${ message } ${ i }` )
+      sigs.push( keys[0].sign_msg( msgs[i] ) )
+      multiKeys.push( keys[i % 2] )
+    }
+
+    // one forged signature in each batch
+    sigs[7] = Buffer.from( sigs[7] )
+    sigs[7][0] ^= 1
+
+    const single = await keys[0].verify_msg_batch( sigs, msgs )
+    const multi = await WolfSSLEd25519.verify_msg_batch_multi( multiKeys, sigs, msgs )
+
+    // an empty offsets array is rejected before anything is queued
+    const badOffsets = await new Promise( ( res ) => {
+      wolfcrypt.wc_ed25519_verify_msg_batch( keys[0].ed25519, Buffer.alloc( 64 ), new Uint32Array( 0 ),
+        Buffer.alloc( 8 ), new Uint32Array( 0 ), ( err, ret ) => res( ret ) )
+    } )
+
+    keys.forEach( ( key ) => key.free() )
+
+    const singleOk = single.every( ( res, i ) => res == ( i == 7 ? 0 : 1 ) )
+    const multiOk = multi.every( ( res, i ) => res == ( i == 7 || i % 2 == 1 ? 0 : 1 ) )
+
+    if ( single.length == 200 && singleOk && multiOk && badOffsets < 0 )
+    {
+      console.log( 'PASS ed25519 verifyBatch' )
+    }
+    else
+    {
+      console.log( 'FAIL ed25519 verifyBatch', badOffsets )
+    }
+  }
+}
+
+module.exports = ed25519_tests
@@ -28,10 +28,37 @@ const expected = 'test'
 const expectedCiphertext = '24d31b1e41fc8c40e521531d67c72c20'
 // 17 bytes to test padding
 const expectedLonger = '12345678901234567'
+const expectedLongerCiphertext = '7b94679e5264bf84069c68643307ef80e48ca7e126faa63edb74d06d1f326703'
 const expectedMessage = 'Hello WolfSSL!\n'
 
 const evp_tests =
 {
+  evpContextPool: function()
+  {
+    const before = wolfcrypt.nodejsPoolStats().types.evp
+    let ciphertexts = []
+
+    // every finalize hands its context back, so after the first one the
+    // contexts come from the free list
+    for ( let i = 0; i < 4; i++ )
+    {
+      let encrypt = new WolfSSLEncryptor( 'AES-256-CBC', key, iv )
+
+      ciphertexts.push( Buffer.concat( [ encrypt.update( expected ), encrypt.finalize() ] ).toString( 'hex' ) )
+    }
+
+    const after = wolfcrypt.nodejsPoolStats().types.evp
+
+    if ( ciphertexts.every( ( ciphertext ) => ciphertext == expectedCiphertext ) && after.hits >= before.hits + 3 && wolfcrypt.nodejsPoolLimit() > 0 )
+    {
+      console.log( 'PASS evp evpContextPool' )
+    }
+    else
+    {
+      console.log( 'FAIL evp evpContextPool', ciphertexts, before, after )
+    }
+  },
+
   evp_encrypt: function()
   {
     let encrypt = new WolfSSLEncryptor( 'AES-256-CBC', key, iv )
@@ -106,6 +133,240 @@ const evp_tests =
     }
   },
 
+  evp_updateInto: function()
+  {
+    let encrypt = new WolfSSLEncryptor( 'AES-256-CBC', key, iv )
+    let reference = new WolfSSLEncryptor( 'AES-256-CBC', key, iv )
+    let output = Buffer.alloc( 64 )
+    let written = 0
+
+    // feed uneven chunks into one preallocated buffer
+    written += encrypt.updateInto( expectedLonger.substring( 0, 5 ), output, written )
+    written += encrypt.updateInto( expectedLonger.substring( 5 ), output, written )
+    written += encrypt.finalizeInto( output, written )
+
+    const actual = output.subarray( 0, written ).toString( 'hex' )
+    const expectedHex = Buffer.concat([ reference.update( expectedLonger ), reference.finalize() ]).toString( 'hex' )
+
+    let tooSmall = false
+    let small = new WolfSSLEncryptor( 'AES-256-CBC', key, iv )
+
+    try
+    {
+      small.updateInto( expectedLonger, Buffer.alloc( expectedLonger.length ) )
+    }
+    catch ( e )
+    {
+      tooSmall = true
+    }
+
+    small.free()
+
+    if ( actual == expectedLongerCiphertext && actual == expectedHex && written == 32 && tooSmall )
+    {
+      console.log( 'PASS evp updateInto' )
+    }
+    else
+    {
+      console.log( 'FAIL evp updateInto', actual, expectedLongerCiphertext, expectedHex )
+    }
+  },
+
+  evp_encryptDecryptAsyncStream: async function()
+  {
+    await new Promise( (res, rej) => {
+      let parts = []
+      let readStream = fs.createReadStream( 'message.txt', { highWaterMark: 4 } )
+      let encryptStream = new WolfSSLEncryptionStream( 'AES-256-CBC', key, iv, { async: true, maxInFlight: 2 } )
+      let decryptStream = new WolfSSLDecryptionStream( 'AES-256-CBC', key, iv, { async: true } )
+
+      decryptStream.on( 'data', function( chunk ) {
+        parts.push( chunk )
+      } )
+
+      decryptStream.on( 'end', function() {
+        const actual = Buffer.concat( parts ).toString()
+
+        if ( actual == expectedMessage )
+        {
+          console.log( 'PASS evp encryptDecryptAsyncStream' )
+        }
+        else
+        {
+          console.log( 'FAIL evp encryptDecryptAsyncStream', actual, expectedMessage )
+        }
+
+        res()
+      } )
+
+      readStream.pipe( encryptStream ).pipe( decryptStream )
+    } )
+  },
+
+  evp_asyncStreamError: async function()
+  {
+    let encryptStream = new WolfSSLEncryptionStream( 'AES-256-CBC', key, iv, { async: true } )
+    let cipher = encryptStream.cipher
+    let syncCallback = false
+    let returned = false
+
+    const err = await new Promise( ( res ) => {
+      encryptStream.on( 'error', res )
+      encryptStream.write( expectedLonger )
+
+      // an output buffer with no room makes the next update fail natively
+      cipher.updateSize = () => 0
+      cipher.update_cb( expectedLonger, () => syncCallback = !returned )
+      returned = true
+
+      encryptStream.write( expectedLonger )
+      encryptStream.end()
+    } )
+
+    if ( err != null && !syncCallback && cipher.evp == null )
+    {
+      console.log( 'PASS evp asyncStreamError' )
+    }
+    else
+    {
+      console.log( 'FAIL evp asyncStreamError', err, syncCallback, cipher.evp )
+    }
+  },
+
+  evp_aesGcm: async function()
+  {
+    // test case 2 from the GCM specification
+    const gcmKey = Buffer.alloc( 16 )
+    const gcmIv = Buffer.alloc( 12 )
+    const gcmPlaintext = Buffer.alloc( 16 )
+    const gcmCiphertext = '0388dace60b6a392f328c2b971b2fe78'
+    const gcmTag = 'ab6e47d42cec13bdf53a67b21257bddf'
+
+    let encrypt = new WolfSSLEncryptor( 'AES-128-GCM', gcmKey, gcmIv )
+
+    const ciphertext = Buffer.concat([ encrypt.update( gcmPlaintext ), encrypt.finalize() ])
+    const tag = encrypt.getAuthTag()
+
+    let decrypt = new WolfSSLDecryptor( 'AES-128-GCM', gcmKey, gcmIv, { authTag: tag } )
+    const plaintext = Buffer.concat([ decrypt.update( ciphertext ), decrypt.finalize() ])
+
+    // aad split over two calls, a 16 byte nonce and a tampered tag
+    const longIv = Buffer.from( iv )
+    let aadEncrypt = new WolfSSLEncryptor( 'AES-256-GCM', key, longIv, { aad: 'header' } )
+    aadEncrypt.setAAD( 'more header' )
+    const aadCiphertext = Buffer.concat([ aadEncrypt.update( expectedLonger ), aadEncrypt.finalize() ])
+    const aadTag = aadEncrypt.getAuthTag()
+
+    let aadDecrypt = new WolfSSLDecryptor( 'AES-256-GCM', key, longIv, { aad: 'headermore header', authTag: aadTag } )
+    const aadPlaintext = Buffer.concat([ aadDecrypt.update( aadCiphertext ), aadDecrypt.finalize() ]).toString()
+
+    let badTag = Buffer.from( aadTag )
+    badTag[0] ^= 1
+    let rejected = false
+    let badDecrypt = new WolfSSLDecryptor( 'AES-256-GCM', key, longIv, { aad: 'headermore header', authTag: badTag } )
+
+    try
+    {
+      badDecrypt.update( aadCiphertext )
+      badDecrypt.finalize()
+    }
+    catch ( e )
+    {
+      rejected = true
+    }
+
+    if ( ciphertext.toString( 'hex' ) == gcmCiphertext && tag.toString( 'hex' ) == gcmTag &&
+      plaintext.equals( gcmPlaintext ) && aadPlaintext == expectedLonger && rejected )
+    {
+      console.log( 'PASS evp aesGcm' )
+    }
+    else
+    {
+      console.log( 'FAIL evp aesGcm', ciphertext.toString( 'hex' ), tag.toString( 'hex' ), aadPlaintext, rejected )
+    }
+  },
+
+  evp_chacha20Poly1305: function()
+  {
+    // test vector from RFC 8439 section 2.8.2
+    const chachaKey = Buffer.from( '808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f', 'hex' )
+    const chachaNonce = Buffer.from( '070000004041424344454647', 'hex' )
+    const chachaAad = Buffer.from( '50515253c0c1c2c3c4c5c6c7', 'hex' )
+    const chachaPlaintext = 'Ladies and Gentlemen of the class of \'99: If I could offer you only one tip for the future, sunscreen would be it.'
+    const chachaCiphertext = 'd31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d63dbea45e8ca9671282fafb69da92728b' +
+      '1a71de0a9e060b2905d6a5b67ecd3b3692ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc3ff4def08e4b7a9de576d26586cec64b6116'
+    const chachaTag = '1ae10b594f09e26a7e902ecbd0600691'
+
+    let encrypt = new WolfSSLEncryptor( 'CHACHA20-POLY1305', chachaKey, chachaNonce, { aad: chachaAad } )
+    const ciphertext = Buffer.concat([ encrypt.update( chachaPlaintext ), encrypt.finalize() ])
+    const tag = encrypt.getAuthTag()
+
+    let decrypt = new WolfSSLDecryptor( 'CHACHA20-POLY1305', chachaKey, chachaNonce, { aad: chachaAad, authTag: tag } )
+    const plaintext = Buffer.concat([ decrypt.update( ciphertext ), decrypt.finalize() ]).toString()
+
+    // an unknown cipher throws from the constructor, which frees the ctx
+    let unknownRejected = false
+
+    try
+    {
+      new WolfSSLEncryptor( 'NOT-A-CIPHER', key, iv )
+    }
+    catch ( e )
+    {
+      unknownRejected = true
+    }
+
+    if ( ciphertext.toString( 'hex' ) == chachaCiphertext && tag.toString( 'hex' ) == chachaTag &&
+      plaintext == chachaPlaintext && unknownRejected )
+    {
+      console.log( 'PASS evp chacha20Poly1305' )
+    }
+    else
+    {
+      console.log( 'FAIL evp chacha20Poly1305', ciphertext.toString( 'hex' ), tag.toString( 'hex' ), plaintext, unknownRejected )
+    }
+  },
+
+  evp_aesGcmStream: async function()
+  {
+    const gcmKey = Buffer.from( key )
+    const nonce = Buffer.from( '123456789012' )
+    let tag = null
+
+    const ciphertext = await new Promise( ( res, rej ) => {
+      let parts = []
+      let encryptStream = new WolfSSLEncryptionStream( 'AES-256-GCM', gcmKey, nonce, { aad: 'stream header' } )
+
+      encryptStream.on( 'data', ( chunk ) => parts.push( chunk ) )
+      encryptStream.on( 'end', () => {
+        tag = encryptStream.getAuthTag()
+        res( Buffer.concat( parts ) )
+      } )
+
+      fs.createReadStream( 'message.txt', { highWaterMark: 5 } ).pipe( encryptStream )
+    } )
+
+    const actual = await new Promise( ( res, rej ) => {
+      let parts = []
+      let decryptStream = new WolfSSLDecryptionStream( 'AES-256-GCM', gcmKey, nonce, { aad: 'stream header', authTag: tag, async: true } )
+
+      decryptStream.on( 'data', ( chunk ) => parts.push( chunk ) )
+      decryptStream.on( 'end', () => res( Buffer.concat( parts ).toString() ) )
+      decryptStream.on( 'error', ( err ) => res( err ) )
+
+      decryptStream.end( ciphertext )
+    } )
+
+    if ( actual == expectedMessage && ciphertext.length == expectedMessage.length )
+    {
+      console.log( 'PASS evp aesGcmStream' )
+    }
+    else
+    {
+      console.log( 'FAIL evp aesGcmStream', actual )
+    }
+  },
+
   evp_encryptionStream: async function()
   {
     await new Promise( (res, rej) => {
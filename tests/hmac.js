@@ -19,7 +19,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 const fs = require( 'fs' )
-const { WolfSSLHmac, WolfSSLHmacStream } = require( '../interfaces/hmac' )
+const { WolfSSLHmac, WolfSSLHmacKey, WolfSSLHmacStream } = require( '../interfaces/hmac' )
 const wolfcrypt = require( '../build/Release/wolfcrypt' )
 
 const key = Buffer.from('12345678901234567890123456789012')
@@ -45,6 +45,63 @@ const hmac_tests =
     }
   },
 
+  hmacCopy: function()
+  {
+    let prefix = new WolfSSLHmac( 'SHA3_512', key )
+    prefix.update( expectedLonger.substring( 0, 10 ) )
+
+    let copy = prefix.copy()
+    copy.update( expectedLonger.substring( 10 ) )
+    const copyDigest = copy.finalize().toString( 'hex' )
+
+    // digest must leave the original usable
+    prefix.digest()
+    prefix.update( expectedLonger.substring( 10 ) )
+    const midDigest = prefix.digest().toString( 'hex' )
+    const prefixDigest = prefix.finalize().toString( 'hex' )
+
+    if ( copyDigest == expectedLongerDigest && midDigest == expectedLongerDigest && prefixDigest == expectedLongerDigest )
+    {
+      console.log( 'PASS hmac hmacCopy' )
+    }
+    else
+    {
+      console.log( 'FAIL hmac hmacCopy', copyDigest, midDigest, prefixDigest )
+    }
+  },
+
+  hmacKey: function()
+  {
+    const before = wolfcrypt.nodejsHandleStats()
+    let hmacKey = new WolfSSLHmacKey( 'SHA3_512', key )
+    // the precomputed states live in a native handle, not on the js heap
+    const during = wolfcrypt.nodejsHandleStats()
+
+    const macDigest = hmacKey.mac( expectedLonger ).toString( 'hex' )
+    const macAgain = hmacKey.mac( expectedLonger ).toString( 'hex' )
+
+    hmacKey.update( 'discarded' )
+    hmacKey.reset()
+    hmacKey.update( expectedLonger.substring( 0, 10 ) )
+    hmacKey.update( expectedLonger.substring( 10 ) )
+    const streamDigest = hmacKey.finalize().toString( 'hex' )
+
+    hmacKey.update( expectedLonger )
+    const reusedDigest = hmacKey.finalize().toString( 'hex' )
+
+    hmacKey.free()
+
+    if ( macDigest == expectedLongerDigest && macAgain == expectedLongerDigest && streamDigest == expectedLongerDigest && reusedDigest == expectedLongerDigest &&
+      during.live == before.live + 1 && during.bytes > before.bytes )
+    {
+      console.log( 'PASS hmac hmacKey' )
+    }
+    else
+    {
+      console.log( 'FAIL hmac hmacKey', macDigest, macAgain, streamDigest, reusedDigest, before, during )
+    }
+  },
+
   hmacStream: async function()
   {
     await new Promise( (res, rej) => {
@@ -0,0 +1,144 @@
+/* kdf.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+const crypto = require( 'crypto' )
+const { WolfSSL_HKDF, WolfSSL_HKDF_Extract, WolfSSL_HKDF_Expand, WolfSSL_X963_KDF, WolfSSL_HKDF_promise,
+  WolfSSL_X963_KDF_promise, WolfSSL_HKDF_batch_promise, WolfSSL_X963_KDF_batch_promise } = require( '../interfaces/kdf' )
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+
+// RFC 5869 test case 1
+const ikm = Buffer.alloc( 22, 0x0b )
+const salt = Buffer.from( '000102030405060708090a0b0c', 'hex' )
+const info = Buffer.from( 'f0f1f2f3f4f5f6f7f8f9', 'hex' )
+const expectedPrk = '077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5'
+const expectedOkm = '3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865'
+
+// X9.63 is hash( secret || counter || info ) for counter = 1, 2, ...
+function x963( secret, sharedInfo, length )
+{
+  let parts = []
+
+  for ( let counter = 1; parts.length * 32 < length; counter++ )
+  {
+    let counterBytes = Buffer.alloc( 4 )
+    counterBytes.writeUInt32BE( counter )
+
+    parts.push( crypto.createHash( 'sha256' ).update( secret ).update( counterBytes ).update( sharedInfo ).digest() )
+  }
+
+  return Buffer.concat( parts ).subarray( 0, length )
+}
+
+const kdf_tests =
+{
+  hkdf: function()
+  {
+    const okm = WolfSSL_HKDF( 'SHA256', ikm, salt, info, 42 ).toString( 'hex' )
+    const prk = WolfSSL_HKDF_Extract( 'SHA256', salt, ikm )
+    const expanded = WolfSSL_HKDF_Expand( 'SHA256', prk, info, 42 ).toString( 'hex' )
+
+    if ( okm == expectedOkm && prk.toString( 'hex' ) == expectedPrk && expanded == expectedOkm )
+    {
+      console.log( 'PASS kdf hkdf' )
+    }
+    else
+    {
+      console.log( 'FAIL kdf hkdf', okm, prk.toString( 'hex' ), expanded )
+    }
+  },
+
+  x963Kdf: function()
+  {
+    const secret = Buffer.from( '96c05619d56c328ab95fe84b18264b08725b85e33fd34f08', 'hex' )
+    const sharedInfo = Buffer.from( 'shared info' )
+    const key = WolfSSL_X963_KDF( 'SHA256', secret, sharedInfo, 48 ).toString( 'hex' )
+    const expected = x963( secret, sharedInfo, 48 ).toString( 'hex' )
+
+    if ( key == expected )
+    {
+      console.log( 'PASS kdf x963Kdf' )
+    }
+    else
+    {
+      console.log( 'FAIL kdf x963Kdf', key, expected )
+    }
+  },
+
+  kdfAsync: async function()
+  {
+    const okm = ( await WolfSSL_HKDF_promise( 'SHA256', ikm, salt, info, 42 ) ).toString( 'hex' )
+    const key = await WolfSSL_X963_KDF_promise( 'SHA256', ikm, info, 40 )
+
+    // a length past the end of its buffer, and a salt that is not a buffer,
+    // are rejected before anything is copied
+    const type = wolfcrypt.typeof_Hmac( 'SHA256' )
+    const tooLong = await new Promise( ( res ) => {
+      wolfcrypt.wc_HKDF_async( type, ikm, ikm.length + 64, salt, salt.length, info, info.length, 42, ( err, ret ) => res( ret ) )
+    } )
+    const nullSalt = await new Promise( ( res ) => {
+      wolfcrypt.wc_HKDF_Extract_async( type, null, 16, ikm, ikm.length, ( err, ret ) => res( ret ) )
+    } )
+
+    if ( okm == expectedOkm && key.equals( x963( ikm, info, 40 ) ) && tooLong < 0 && nullSalt < 0 )
+    {
+      console.log( 'PASS kdf kdfAsync' )
+    }
+    else
+    {
+      console.log( 'FAIL kdf kdfAsync', okm, key.toString( 'hex' ), tooLong, nullSalt )
+    }
+  },
+
+  kdfBatch: async function()
+  {
+    let secrets = []
+
+    for ( let i = 0; i < 250; i++ )
+    {
+      secrets.push( crypto.randomBytes( 32 ) )
+    }
+
+    let progress = 0
+    const hkdfKeys = await WolfSSL_HKDF_batch_promise( 'SHA256', [ ikm, ...secrets ], salt, info, 42, ( done ) => {
+      progress = Math.max( progress, done )
+    } )
+    const x963Keys = await WolfSSL_X963_KDF_batch_promise( 'SHA256', secrets, null, 16 )
+
+    let match = hkdfKeys.subarray( 0, 42 ).toString( 'hex' ) == expectedOkm && progress == secrets.length + 1
+
+    for ( let i = 0; i < secrets.length; i++ )
+    {
+      match = match && hkdfKeys.subarray( ( i + 1 ) * 42, ( i + 2 ) * 42 ).equals( WolfSSL_HKDF( 'SHA256', secrets[i], salt, info, 42 ) )
+      match = match && x963Keys.subarray( i * 16, ( i + 1 ) * 16 ).equals( x963( secrets[i], Buffer.alloc( 0 ), 16 ) )
+    }
+
+    if ( match )
+    {
+      console.log( 'PASS kdf kdfBatch' )
+    }
+    else
+    {
+      console.log( 'FAIL kdf kdfBatch', progress )
+    }
+  }
+}
+
+module.exports = kdf_tests
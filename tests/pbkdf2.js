@@ -19,7 +19,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 
-const { WolfSSL_PBKDF2 } = require( '../interfaces/pbkdf2' )
+const { WolfSSL_PBKDF2, WolfSSL_PBKDF2_promise, WolfSSL_PBKDF2_batch_promise, WolfSSL_ThreadPoolSize } = require( '../interfaces/pbkdf2' )
 
 const pbkdf2_tests = 
 {
@@ -39,6 +39,63 @@ const pbkdf2_tests =
     {
       console.log( 'FAIL pbkdf2', key1.toString( 'hex' ), key2.toString( 'hex' ) );
     }
+  },
+
+  pbkdf2Async: async function()
+  {
+    const password = Buffer.from( 'super secret password' )
+    const salt = Buffer.from( 'super secret salt' )
+    const poolSize = WolfSSL_ThreadPoolSize()
+
+    WolfSSL_ThreadPoolSize( 2 )
+
+    const expected = WolfSSL_PBKDF2( password, salt, 2048, 64, 'SHA512' ).toString( 'hex' )
+    const keys = await Promise.all( [ 0, 1, 2, 3 ].map( () => WolfSSL_PBKDF2_promise( password, salt, 2048, 64, 'SHA512' ) ) )
+    const resized = WolfSSL_ThreadPoolSize()
+
+    // a negative key length is rejected before a job is created
+    const rejected = await WolfSSL_PBKDF2_promise( password, salt, 2048, -1, 'SHA512' ).then( () => false, () => true )
+
+    WolfSSL_ThreadPoolSize( poolSize )
+
+    if ( resized == 2 && keys.every( ( key ) => key.toString( 'hex' ) == expected ) && rejected )
+    {
+      console.log( 'PASS pbkdf2 pbkdf2Async' );
+    }
+    else
+    {
+      console.log( 'FAIL pbkdf2 pbkdf2Async', resized, keys.map( ( key ) => key.toString( 'hex' ) ), expected, rejected );
+    }
+  },
+
+  pbkdf2Batch: async function()
+  {
+    const passwords = [ 'password one', 'password two', Buffer.from( 'password three' ) ]
+    const salts = [ 'salt one', 'salt two', 'salt three' ]
+    const iterations = [ 1000, 2048, 1500 ]
+    let lastProgress = 0
+
+    const keys = await WolfSSL_PBKDF2_batch_promise( passwords, salts, iterations, 32, 'SHA256', ( done, count ) => {
+      lastProgress = done == count ? done : lastProgress
+    } )
+
+    let match = keys.length == 32 * passwords.length
+
+    for ( let i = 0; i < passwords.length; i++ )
+    {
+      const expected = WolfSSL_PBKDF2( Buffer.from( passwords[i] ), Buffer.from( salts[i] ), iterations[i], 32, 'SHA256' )
+
+      match = match && keys.subarray( i * 32, ( i + 1 ) * 32 ).equals( expected )
+    }
+
+    if ( match && lastProgress == passwords.length )
+    {
+      console.log( 'PASS pbkdf2 pbkdf2Batch' );
+    }
+    else
+    {
+      console.log( 'FAIL pbkdf2 pbkdf2Batch', keys.toString( 'hex' ), lastProgress );
+    }
   }
 }
 
@@ -19,6 +19,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 const { WolfSSLRandom } = require( '../interfaces/random' )
+const { WolfSSLEcc } = require( '../interfaces/ecc' )
 
 const rng_tests =
 {
@@ -46,6 +47,29 @@ const rng_tests =
                 console.log('PASS RNG generateBlock')
             }
         }
+    },
+
+    threadRngReuse: async function()
+    {
+        let ecc = new WolfSSLEcc()
+        ecc.make_key(32)
+
+        let before = WolfSSLRandom.Stats()
+
+        for (let i = 0; i < 10; i++) {
+            ecc.sign_hash('Hello WolfSSL!')
+        }
+
+        let after = WolfSSLRandom.Stats()
+        ecc.free()
+
+        // the main thread rng already exists, signing must not seed a new one
+        if (after.created == before.created && after.reused >= before.reused + 10) {
+            console.log('PASS RNG threadRngReuse')
+        }
+        else {
+            console.log('FAIL RNG threadRngReuse', before, after)
+        }
     }
 }
 
@@ -166,6 +166,102 @@ const sha_tests =
       console.log( 'FAIL sha sha512_256', digestHex, expectedSha512_256Hex )
     }
   },
+
+  shaHashOneShot: function()
+  {
+    const expected = { SHA: expectedShaHex, SHA224: expectedSha224Hex, SHA256: expectedSha256Hex, SHA384: expectedSha384Hex,
+      SHA512: expectedSha512Hex, SHA512_224: expectedSha512_224Hex, SHA512_256: expectedSha512_256Hex }
+    let failed = []
+
+    for ( const type in expected )
+    {
+      // string input, Buffer input and a caller supplied output with offset
+      let out = Buffer.alloc( 8 + expected[type].length / 2 )
+      const written = WolfSSLSha.hash( type, Buffer.from( message ), out, 8 )
+
+      if ( WolfSSLSha.hash( type, message ).toString( 'hex' ) != expected[type] ||
+        written * 2 != expected[type].length || out.subarray( 8 ).toString( 'hex' ) != expected[type] )
+      {
+        failed.push( type )
+      }
+    }
+
+    if ( failed.length == 0 )
+    {
+      console.log( 'PASS sha hashOneShot' )
+    }
+    else
+    {
+      console.log( 'FAIL sha hashOneShot', failed )
+    }
+  },
+
+  shaHashMany: async function()
+  {
+    let messages = []
+
+    for ( let i = 0; i < 300; i++ )
+    {
+      messages.push( i == 0 ? message : `${ message } ${ i }` )
+    }
+
+    const packed = Buffer.concat( messages.map( ( m ) => Buffer.from( m ) ) )
+    let offsets = new Uint32Array( messages.length + 1 )
+    messages.forEach( ( m, i ) => offsets[i + 1] = offsets[i] + m.length )
+
+    const fromArray = WolfSSLSha.hashMany( 'SHA256', messages )
+    const fromPacked = WolfSSLSha.hashMany( 'SHA256', packed, offsets )
+    const fromPool = await WolfSSLSha.hashMany_promise( 'SHA256', messages )
+
+    const expectedLast = WolfSSLSha.hash( 'SHA256', messages[299] )
+
+    // offsets that go backwards are rejected natively instead of being read
+    let backwardsRejected = false
+
+    try
+    {
+      WolfSSLSha.hashMany( 'SHA256', Buffer.alloc( 16 ), new Uint32Array( [ 0, 10, 5 ] ) )
+    }
+    catch ( e )
+    {
+      backwardsRejected = true
+    }
+
+    if ( fromArray.length == 300 * 32 && fromArray.subarray( 0, 32 ).toString( 'hex' ) == expectedSha256Hex &&
+      fromArray.subarray( 299 * 32 ).equals( expectedLast ) && fromArray.equals( fromPacked ) && fromArray.equals( fromPool ) &&
+      backwardsRejected )
+    {
+      console.log( 'PASS sha hashMany' )
+    }
+    else
+    {
+      console.log( 'FAIL sha hashMany' )
+    }
+  },
+
+  shaCopy: function()
+  {
+    let prefix = new WolfSSLSha( 'SHA256' )
+    prefix.update( message.substring( 0, 6 ) )
+
+    let copy = prefix.copy()
+    copy.update( message.substring( 6 ) )
+
+    const partial = prefix.digest().toString( 'hex' )
+    prefix.update( message.substring( 6 ) )
+
+    const copyHex = copy.finalize().toString( 'hex' )
+    const prefixHex = prefix.finalize().toString( 'hex' )
+
+    if ( copyHex == expectedSha256Hex && prefixHex == expectedSha256Hex && partial == WolfSSLSha.hash( 'SHA256', message.substring( 0, 6 ) ).toString( 'hex' ) )
+    {
+      console.log( 'PASS sha copy' )
+    }
+    else
+    {
+      console.log( 'FAIL sha copy', copyHex, prefixHex, partial )
+    }
+  }
 }
 
 module.exports = sha_tests
@@ -0,0 +1,93 @@
+/* stats.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { getStats, resetStats, setStatsEnabled } = require( '../interfaces/stats' )
+const { WolfSSLSha } = require( '../interfaces/sha' )
+const { WolfSSLRsa } = require( '../interfaces/rsa' )
+
+const stats_tests =
+{
+  statsCounters: async function()
+  {
+    const data = Buffer.alloc( 1000, 0xa5 )
+
+    const wasEnabled = setStatsEnabled( true )
+    resetStats()
+
+    for ( let i = 0; i < 10; i++ )
+    {
+      WolfSSLSha.hash( 'SHA256', data )
+    }
+
+    // an unknown hash type is counted as an error
+    wolfcrypt.wc_Hash( -1, data )
+
+    const hash = getStats().ops.wc_Hash
+
+    setStatsEnabled( false )
+    WolfSSLSha.hash( 'SHA256', data )
+
+    const disabled = getStats().ops.wc_Hash
+
+    setStatsEnabled( wasEnabled )
+
+    if ( hash && hash.calls == 11 && hash.bytes == 11000 && hash.ns > 0 &&
+      hash.histogram.reduce( ( sum, count ) => sum + count, 0 ) == 11 &&
+      Object.values( hash.errors ).reduce( ( sum, count ) => sum + count, 0 ) == 1 && disabled.calls == 11 )
+    {
+      console.log( 'PASS stats counters' )
+    }
+    else
+    {
+      console.log( 'FAIL stats counters', hash, disabled )
+    }
+  },
+
+  statsAsync: async function()
+  {
+    const message = Buffer.from( 'Hello WolfSSL!' )
+    let rsa = new WolfSSLRsa()
+
+    rsa.MakeRsaKey( 2048, 65537 )
+
+    const wasEnabled = setStatsEnabled( true )
+    resetStats()
+
+    await Promise.all( [ rsa.SSL_Sign_promise( message ), rsa.SSL_Sign_promise( message ) ] )
+
+    const sign = getStats().ops.wc_RsaSSL_Sign_async
+
+    setStatsEnabled( wasEnabled )
+    rsa.free()
+
+    if ( sign && sign.calls == 2 && sign.async && sign.async.calls == 2 && sign.async.executeNs > 0 &&
+      sign.async.queueMaxNs <= sign.async.queueNs )
+    {
+      console.log( 'PASS stats async' )
+    }
+    else
+    {
+      console.log( 'FAIL stats async', sign )
+    }
+  }
+}
+
+module.exports = stats_tests
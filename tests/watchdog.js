@@ -0,0 +1,86 @@
+/* watchdog.js
+ *
+ * Copyright (C) 2006-2024 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+const wolfcrypt = require( '../build/Release/wolfcrypt' )
+const { setWatchdog, getWatchdogEvents } = require( '../interfaces/watchdog' )
+const { getStats, resetStats, setStatsEnabled } = require( '../interfaces/stats' )
+const { WolfSSL_PBKDF2, WolfSSL_PBKDF2_auto } = require( '../interfaces/pbkdf2' )
+
+const password = Buffer.from( 'super secret password' )
+const salt = Buffer.from( 'super secret salt' )
+
+const watchdog_tests =
+{
+  watchdogEvents: async function()
+  {
+    getWatchdogEvents( true )
+
+    // anything takes longer than a nanosecond
+    const previous = setWatchdog( 0.000001 )
+    WolfSSL_PBKDF2( password, salt, 1000, 32, 'SHA256' )
+    setWatchdog( previous.thresholdMs, previous )
+
+    const result = getWatchdogEvents( true )
+    const event = result.events.find( ( event ) => event.name == 'wc_PBKDF2' )
+
+    // the key buffer, password and salt only show up as sizes
+    if ( event && event.args == `buffer(32), buffer(21), 21, buffer(17), 17, 1000, 32, ${ wolfcrypt.typeof_Hmac( 'SHA256' ) }` &&
+      event.ms > 0 && result.total >= result.events.length )
+    {
+      console.log( 'PASS watchdog watchdogEvents' )
+    }
+    else
+    {
+      console.log( 'FAIL watchdog watchdogEvents', result )
+    }
+  },
+
+  watchdogReroute: async function()
+  {
+    const expected = WolfSSL_PBKDF2( password, salt, 1000, 32, 'SHA256' )
+
+    getWatchdogEvents( true )
+
+    const wasEnabled = setStatsEnabled( true )
+    resetStats()
+
+    // not slow yet, so the first call runs sync and trips the watchdog
+    const previous = setWatchdog( 0.000001, { reroute: true } )
+    const first = await WolfSSL_PBKDF2_auto( password, salt, 1000, 32, 'SHA256' )
+    const second = await WolfSSL_PBKDF2_auto( password, salt, 1000, 32, 'SHA256' )
+    setWatchdog( previous.thresholdMs, previous )
+    getWatchdogEvents( true )
+
+    const ops = getStats().ops
+    setStatsEnabled( wasEnabled )
+
+    if ( first.equals( expected ) && second.equals( expected ) && ops.wc_PBKDF2.calls == 1 &&
+      ops.wc_PBKDF2_async && ops.wc_PBKDF2_async.calls == 1 )
+    {
+      console.log( 'PASS watchdog watchdogReroute' )
+    }
+    else
+    {
+      console.log( 'FAIL watchdog watchdogReroute', ops.wc_PBKDF2, ops.wc_PBKDF2_async )
+    }
+  }
+}
+
+module.exports = watchdog_tests